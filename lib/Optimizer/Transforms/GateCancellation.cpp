@@ -0,0 +1,366 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "PassDetails.h"
+#include "cudaq/Optimizer/Builder/Factory.h"
+#include "cudaq/Optimizer/Dialect/Quake/QuakeOps.h"
+#include "cudaq/Optimizer/Transforms/Passes.h"
+#include "llvm/ADT/Sequence.h"
+#include "llvm/Support/Debug.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+
+namespace cudaq::opt {
+#define GEN_PASS_DEF_GATECANCELLATION
+#include "cudaq/Optimizer/Transforms/Passes.h.inc"
+} // namespace cudaq::opt
+
+#define DEBUG_TYPE "gate-cancellation"
+
+using namespace mlir;
+
+namespace {
+/// Basis in which a gate acts on one of its qubits. The gate is block diagonal
+/// in the eigenbasis of the corresponding Pauli operator on that qubit. Two
+/// gates commute if they act in the same basis on each qubit they share.
+enum class Basis { None, X, Y, Z };
+
+/// How a gate combines with an earlier gate acting on the same qubits.
+enum class Pairing { None, Cancel, Merge };
+
+/// Whether two quantum references denote the same qubit.
+enum class Alias { Same, Distinct, May };
+
+/// The controls followed by the targets of \p op.
+SmallVector<Value> getQubits(quake::OperatorInterface op) {
+  SmallVector<Value> qubits(op.getControls());
+  qubits.append(op.getTargets().begin(), op.getTargets().end());
+  return qubits;
+}
+
+Basis getBasis(quake::OperatorInterface op, std::size_t pos) {
+  if (pos < op.getControls().size())
+    return Basis::Z;
+  Operation *gate = op.getOperation();
+  if (isa<quake::ZOp, quake::SOp, quake::TOp, quake::RzOp, quake::R1Op>(gate))
+    return Basis::Z;
+  if (isa<quake::XOp, quake::RxOp>(gate))
+    return Basis::X;
+  if (isa<quake::YOp, quake::RyOp>(gate))
+    return Basis::Y;
+  return Basis::None;
+}
+
+/// Do the gates \p a and \p b commute on the qubit they use at positions \p
+/// posA and \p posB respectively?
+bool commuteOn(quake::OperatorInterface a, std::size_t posA,
+               quake::OperatorInterface b, std::size_t posB) {
+  auto basis = getBasis(a, posA);
+  return basis != Basis::None && basis == getBasis(b, posB);
+}
+
+bool isRotation(Operation *op) {
+  return isa<quake::R1Op, quake::RxOp, quake::RyOp, quake::RzOp>(op);
+}
+
+bool isZeroRotation(quake::OperatorInterface op) {
+  if (!isRotation(op))
+    return false;
+  auto angle = cudaq::opt::factory::maybeValueOfFloatConstant(
+      op.getParameters().front());
+  return angle && *angle == 0.0;
+}
+
+bool haveSameNegatedControls(quake::OperatorInterface a,
+                             quake::OperatorInterface b) {
+  auto negA = a.getNegatedControls();
+  auto negB = b.getNegatedControls();
+  for (std::size_t i = 0, end = a.getControls().size(); i < end; ++i)
+    if ((negA && (*negA)[i]) != (negB && (*negB)[i]))
+      return false;
+  return true;
+}
+
+/// How \p op combines with the earlier gate \p prev, assuming they act on the
+/// same qubits in the same order.
+Pairing getPairing(quake::OperatorInterface prev, quake::OperatorInterface op) {
+  if (prev->getName() != op->getName() ||
+      prev.getControls().size() != op.getControls().size() ||
+      prev.getTargets().size() != op.getTargets().size() ||
+      !haveSameNegatedControls(prev, op))
+    return Pairing::None;
+  if (op->hasTrait<cudaq::Hermitian>())
+    return Pairing::Cancel;
+  if (isa<quake::SOp, quake::TOp>(op) && prev.isAdj() != op.isAdj())
+    return Pairing::Cancel;
+  if (isRotation(op) && prev.getParameters().front().getType() ==
+                            op.getParameters().front().getType())
+    return Pairing::Merge;
+  return Pairing::None;
+}
+
+/// The allocation the reference \p v comes from and, when known, its offset in
+/// that allocation.
+std::pair<Value, std::optional<std::size_t>> getOrigin(Value v) {
+  if (auto extract = v.getDefiningOp<quake::ExtractRefOp>()) {
+    if (extract.hasConstantIndex())
+      return {extract.getVeq(), extract.getConstantIndex()};
+    return {extract.getVeq(), std::nullopt};
+  }
+  return {v, std::nullopt};
+}
+
+Alias getAlias(Value a, Value b) {
+  if (a == b)
+    return Alias::Same;
+  auto [baseA, offsetA] = getOrigin(a);
+  auto [baseB, offsetB] = getOrigin(b);
+  if (baseA == baseB) {
+    if (offsetA && offsetB)
+      return *offsetA == *offsetB ? Alias::Same : Alias::Distinct;
+    return Alias::May;
+  }
+  if (baseA.getDefiningOp<quake::AllocaOp>() &&
+      baseB.getDefiningOp<quake::AllocaOp>())
+    return Alias::Distinct;
+  return Alias::May;
+}
+
+bool hasQuantumOperand(Operation *op) {
+  return llvm::any_of(op->getOperandTypes(), quake::isQuantumType);
+}
+
+/// Operations that name qubits without acting on them.
+bool isQubitAddressing(Operation *op) {
+  return isa<quake::AllocaOp, quake::ExtractRefOp, quake::SubVeqOp,
+             quake::ConcatOp, quake::VeqSizeOp, quake::RelaxSizeOp>(op);
+}
+
+class GateCanceller {
+public:
+  GateCanceller(MLIRContext *ctx, unsigned lookBehind)
+      : builder(ctx), lookBehind(lookBehind) {}
+
+  /// Cancel and merge the gates of \p block. Returns true if the block changed.
+  bool simplify(Block &block) {
+    bool changed = false;
+    for (auto &op : llvm::make_early_inc_range(block)) {
+      auto gate = dyn_cast<quake::OperatorInterface>(&op);
+      if (!gate)
+        continue;
+      if (isZeroRotation(gate)) {
+        LLVM_DEBUG(llvm::dbgs() << "erasing identity: " << op << '\n');
+        eraseGate(gate);
+        changed = true;
+        continue;
+      }
+      quake::OperatorInterface partner;
+      if (quake::isAllReferences(&op))
+        partner = findPartnerInMemory(gate);
+      else if (quake::isLinearValueForm(&op))
+        partner = findPartnerOnWires(gate);
+      if (!partner)
+        continue;
+      LLVM_DEBUG(llvm::dbgs() << "combining: " << *partner.getOperation()
+                              << "\n      with: " << op << '\n');
+      changed = true;
+      if (getPairing(partner, gate) == Pairing::Cancel) {
+        eraseGate(partner);
+        eraseGate(gate);
+      } else {
+        mergeRotations(partner, gate);
+      }
+    }
+    return changed;
+  }
+
+private:
+  /// Erase \p op, forwarding its input wires to the users of its output wires.
+  static void eraseGate(quake::OperatorInterface op) {
+    SmallVector<Value> wires;
+    for (auto qubit : getQubits(op))
+      if (isa<quake::WireType>(qubit.getType()))
+        wires.push_back(qubit);
+    op->replaceAllUsesWith(wires);
+    op->erase();
+  }
+
+  /// Add the angle of the rotation \p prev to the rotation \p op and erase \p
+  /// prev. \p op is erased as well if the resulting angle is 0.
+  void mergeRotations(quake::OperatorInterface prev,
+                      quake::OperatorInterface op) {
+    Value prevAngle = prev.getParameters().front();
+    Value angle = op.getParameters().front();
+    // The rotation is kept on `op`, the angle of `prev` is negated if exactly
+    // one of them is an adjoint.
+    const bool sameSign = prev.isAdj() == op.isAdj();
+    auto loc = op->getLoc();
+    builder.setInsertionPoint(op);
+    Value merged;
+    auto prevValue = cudaq::opt::factory::maybeValueOfFloatConstant(prevAngle);
+    auto value = cudaq::opt::factory::maybeValueOfFloatConstant(angle);
+    if (prevValue && value && angle.getType().isF64())
+      merged = cudaq::opt::factory::createF64Constant(
+          loc, builder, sameSign ? *value + *prevValue : *value - *prevValue);
+    else if (sameSign)
+      merged = builder.create<arith::AddFOp>(loc, angle, prevAngle);
+    else
+      merged = builder.create<arith::SubFOp>(loc, angle, prevAngle);
+    op->setOperand(op.getParameters().getBeginOperandIndex(), merged);
+    eraseGate(prev);
+    if (isZeroRotation(op))
+      eraseGate(op);
+  }
+
+  /// Find the gate that \p op cancels or merges with, in reference form. The
+  /// operations preceding \p op in its block are scanned backwards, as long as
+  /// they commute with \p op.
+  quake::OperatorInterface findPartnerInMemory(quake::OperatorInterface op) {
+    auto qubits = getQubits(op);
+    if (!llvm::all_of(qubits, [](Value v) {
+          return isa<quake::RefType>(v.getType());
+        }))
+      return {};
+    unsigned numGates = 0;
+    for (Operation *prev = op->getPrevNode(); prev && numGates < lookBehind;
+         prev = prev->getPrevNode()) {
+      if (isQubitAddressing(prev))
+        continue;
+      auto prevGate = dyn_cast<quake::OperatorInterface>(prev);
+      if (!prevGate) {
+        // Any other operation blocks the qubits it may use.
+        if (prev->getNumRegions() && containsQuantumCode(prev))
+          return {};
+        for (auto operand : prev->getOperands())
+          if (quake::isQuantumType(operand.getType()))
+            for (auto qubit : qubits)
+              if (getAlias(operand, qubit) != Alias::Distinct)
+                return {};
+        continue;
+      }
+      ++numGates;
+      if (!quake::isAllReferences(prev))
+        return {};
+      auto prevQubits = getQubits(prevGate);
+      if (getPairing(prevGate, op) != Pairing::None &&
+          llvm::all_of(llvm::seq<std::size_t>(0, qubits.size()),
+                       [&](std::size_t pos) {
+                         return getAlias(prevQubits[pos], qubits[pos]) ==
+                                Alias::Same;
+                       }))
+        return prevGate;
+      for (std::size_t prevPos = 0; prevPos < prevQubits.size(); ++prevPos)
+        for (std::size_t pos = 0; pos < qubits.size(); ++pos) {
+          auto alias = getAlias(prevQubits[prevPos], qubits[pos]);
+          if (alias == Alias::Distinct)
+            continue;
+          if (alias == Alias::May || !commuteOn(prevGate, prevPos, op, pos))
+            return {};
+        }
+    }
+    return {};
+  }
+
+  /// Find the gate that \p op cancels or merges with, in linear-value form.
+  /// Each input wire of \p op is followed backwards past the gates that
+  /// commute with \p op. The partner is a gate reached on every wire, at the
+  /// same position as \p op uses the wire.
+  quake::OperatorInterface findPartnerOnWires(quake::OperatorInterface op) {
+    auto qubits = getQubits(op);
+    // For each wire of `op`, the gates reached at the same position.
+    SmallVector<SmallVector<Operation *>> reached;
+    for (std::size_t pos = 0; pos < qubits.size(); ++pos) {
+      if (!isa<quake::WireType>(qubits[pos].getType()))
+        continue;
+      auto &candidates = reached.emplace_back();
+      Value wire = qubits[pos];
+      for (unsigned i = 0; i < lookBehind; ++i) {
+        auto prev = wire.getDefiningOp<quake::OperatorInterface>();
+        if (!prev || prev->getBlock() != op->getBlock() ||
+            !quake::isAllValues(prev) || !wire.hasOneUse())
+          break;
+        const std::size_t prevPos = getInputPosition(prev, wire);
+        if (prevPos == pos)
+          candidates.push_back(prev);
+        if (!commuteOn(prev, prevPos, op, pos))
+          break;
+        wire = getQubits(prev)[prevPos];
+      }
+    }
+    if (reached.empty())
+      return {};
+    for (auto *candidate : reached.front()) {
+      if (!llvm::all_of(reached, [&](ArrayRef<Operation *> candidates) {
+            return llvm::is_contained(candidates, candidate);
+          }))
+        continue;
+      auto prev = cast<quake::OperatorInterface>(candidate);
+      if (getPairing(prev, op) == Pairing::None)
+        continue;
+      // Controls that are not wires must be the very same values.
+      auto prevQubits = getQubits(prev);
+      if (llvm::all_of(llvm::seq<std::size_t>(0, qubits.size()),
+                       [&](std::size_t pos) {
+                         return isa<quake::WireType>(qubits[pos].getType()) ||
+                                prevQubits[pos] == qubits[pos];
+                       }))
+        return prev;
+    }
+    return {};
+  }
+
+  /// Position, among the controls and targets of \p op, of the qubit whose
+  /// output wire is \p wire.
+  static std::size_t getInputPosition(quake::OperatorInterface op,
+                                      Value wire) {
+    auto resultNumber = cast<OpResult>(wire).getResultNumber();
+    std::size_t wireNumber = 0;
+    for (auto iter : llvm::enumerate(getQubits(op)))
+      if (isa<quake::WireType>(iter.value().getType()) &&
+          wireNumber++ == resultNumber)
+        return iter.index();
+    llvm_unreachable("output wire without input wire");
+  }
+
+  static bool containsQuantumCode(Operation *op) {
+    return op
+        ->walk([](Operation *nested) {
+          if (isQuakeOperation(nested) || hasQuantumOperand(nested))
+            return WalkResult::interrupt();
+          return WalkResult::advance();
+        })
+        .wasInterrupted();
+  }
+
+  OpBuilder builder;
+  unsigned lookBehind;
+};
+
+/// Peephole optimization of the gates of a function: cancels pairs of inverse
+/// gates and merges rotations, looking through the gates that commute with
+/// them.
+class GateCancellationPass
+    : public cudaq::opt::impl::GateCancellationBase<GateCancellationPass> {
+public:
+  using GateCancellationBase::GateCancellationBase;
+
+  void runOnOperation() override {
+    auto func = getOperation();
+    LLVM_DEBUG(llvm::dbgs() << "Function before gate cancellation:\n"
+                            << func << "\n\n");
+    GateCanceller canceller(&getContext(), lookBehind);
+    // Every change erases at least one gate, so this terminates.
+    bool changed;
+    do {
+      changed = false;
+      func.walk([&](Block *block) { changed |= canceller.simplify(*block); });
+    } while (changed);
+    LLVM_DEBUG(llvm::dbgs() << "Function after gate cancellation:\n"
+                            << func << "\n\n");
+  }
+};
+} // namespace
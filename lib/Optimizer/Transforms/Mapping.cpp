@@ -16,6 +16,8 @@
 #include "llvm/Support/ScopedPrinter.h"
 #include "mlir/Dialect/Func/IR/FuncOps.h"
 #include "mlir/Transforms/TopologicalSortUtils.h"
+#include <numeric>
+#include <random>
 
 #define DEBUG_TYPE "quantum-mapper"
 
@@ -49,6 +51,273 @@ void identityPlacement(Placement &placement) {
     placement.map(Placement::VirtualQ(i), Placement::DeviceQ(i));
 }
 
+void randomPlacement(Placement &placement, std::mt19937 &generator) {
+  SmallVector<unsigned> phys(placement.getNumDeviceQ());
+  std::iota(phys.begin(), phys.end(), 0u);
+  std::shuffle(phys.begin(), phys.end(), generator);
+  for (unsigned i = 0, end = placement.getNumVirtualQ(); i < end; ++i)
+    placement.map(Placement::VirtualQ(i), Placement::DeviceQ(phys[i]));
+}
+
+/// A two-qubit operation on a pair of virtual qubits. These are the only
+/// operations that constrain the placement.
+using Interaction = std::pair<Placement::VirtualQ, Placement::VirtualQ>;
+
+/// Greedily embed the interaction graph of `circuit` into the device coupling
+/// graph. Virtual qubits are placed in order of how strongly they interact with
+/// the already placed ones, each on the free device qubit that minimizes the
+/// weighted distance to its placed partners. Ties are broken in favor of device
+/// qubits with more free neighbours, which leaves room for the partners that
+/// are yet to be placed. When the interaction graph is a subgraph of the
+/// coupling graph (e.g., a chain on a path or grid) this usually finds an
+/// embedding that requires no swaps.
+void interactionGraphPlacement(const Device &device,
+                               ArrayRef<Interaction> circuit,
+                               Placement &placement) {
+  const unsigned numVr = placement.getNumVirtualQ();
+  const unsigned numPhy = placement.getNumDeviceQ();
+
+  SmallVector<DenseMap<unsigned, unsigned>> weights(numVr);
+  SmallVector<unsigned> degree(numVr, 0);
+  for (auto [v0, v1] : circuit) {
+    weights[v0.index][v1.index] += 1;
+    weights[v1.index][v0.index] += 1;
+    degree[v0.index] += 1;
+    degree[v1.index] += 1;
+  }
+
+  SmallVector<Placement::DeviceQ> vrToPhy(numVr);
+  SmallVector<bool> phyUsed(numPhy, false);
+  auto numFreeNeighbours = [&](Placement::DeviceQ phy) {
+    return llvm::count_if(device.getNeighbours(phy),
+                          [&](auto n) { return !phyUsed[n.index]; });
+  };
+
+  while (true) {
+    // Select the unplaced virtual qubit most connected to the placed ones. A
+    // new connected component starts from its highest degree qubit.
+    std::optional<unsigned> nextVr;
+    std::pair<unsigned, unsigned> nextScore{0, 0};
+    for (unsigned v = 0; v < numVr; ++v) {
+      if (vrToPhy[v].isValid() || degree[v] == 0)
+        continue;
+      unsigned placedWeight = 0;
+      for (auto [u, w] : weights[v])
+        if (vrToPhy[u].isValid())
+          placedWeight += w;
+      std::pair<unsigned, unsigned> score{placedWeight, degree[v]};
+      if (!nextVr || score > nextScore) {
+        nextVr = v;
+        nextScore = score;
+      }
+    }
+    if (!nextVr)
+      break;
+
+    // Select the free device qubit closest to the placed partners, or the most
+    // central one if there are none.
+    const bool hasPlacedPartners = nextScore.first > 0;
+    Placement::DeviceQ bestPhy;
+    std::pair<unsigned, int> bestCost;
+    for (unsigned p = 0; p < numPhy; ++p) {
+      if (phyUsed[p])
+        continue;
+      Placement::DeviceQ phy(p);
+      unsigned cost = 0;
+      if (hasPlacedPartners) {
+        for (auto [u, w] : weights[*nextVr])
+          if (vrToPhy[u].isValid())
+            cost += w * device.getDistance(phy, vrToPhy[u]);
+      } else {
+        for (unsigned q = 0; q < numPhy; ++q)
+          cost += device.getDistance(phy, Placement::DeviceQ(q));
+      }
+      std::pair<unsigned, int> candidateCost{
+          cost, -static_cast<int>(numFreeNeighbours(phy))};
+      if (!bestPhy.isValid() || candidateCost < bestCost) {
+        bestPhy = phy;
+        bestCost = candidateCost;
+      }
+    }
+    vrToPhy[*nextVr] = bestPhy;
+    phyUsed[bestPhy.index] = true;
+  }
+
+  // Virtual qubits without interactions take the remaining device qubits.
+  for (unsigned v = 0, p = 0; v < numVr; ++v) {
+    if (vrToPhy[v].isValid())
+      continue;
+    while (phyUsed[p])
+      ++p;
+    vrToPhy[v] = Placement::DeviceQ(p);
+    phyUsed[p] = true;
+  }
+
+  for (auto [v, phy] : llvm::enumerate(vrToPhy))
+    placement.map(Placement::VirtualQ(v), phy);
+}
+
+/// The `RoutingEstimator` runs the same heuristic as the `SabreRouter` below on
+/// an abstract circuit made of two-qubit interactions only, without touching
+/// the IR. It only tracks the placement and counts the swaps, which makes it
+/// cheap enough to compare candidate initial placements and to implement the
+/// bidirectional placement refinement of the SABRE paper: routing the circuit
+/// and then its reverse from the resulting final placement yields an initial
+/// placement that is adapted to the beginning of the circuit.
+class RoutingEstimator {
+public:
+  RoutingEstimator(const Device &device, ArrayRef<Interaction> circuit,
+                   unsigned extendedLayerSize, float extendedLayerWeight,
+                   float decayDelta, unsigned roundsDecayReset)
+      : device(device), circuit(circuit), extendedLayerSize(extendedLayerSize),
+        extendedLayerWeight(extendedLayerWeight), decayDelta(decayDelta),
+        roundsDecayReset(roundsDecayReset) {}
+
+  /// Route the circuit, or its reverse, starting from `placement`. On return,
+  /// `placement` holds the final placement. Returns the number of swaps.
+  unsigned route(Placement &placement, bool reverse = false) const;
+
+private:
+  const Device &device;
+  ArrayRef<Interaction> circuit;
+
+  // Parameters
+  const unsigned extendedLayerSize;
+  const float extendedLayerWeight;
+  const float decayDelta;
+  const unsigned roundsDecayReset;
+};
+
+unsigned RoutingEstimator::route(Placement &placement, bool reverse) const {
+  const std::size_t numGates = circuit.size();
+  auto getGate = [&](std::size_t i) -> const Interaction & {
+    return circuit[reverse ? numGates - 1 - i : i];
+  };
+  auto getDistance = [&](std::size_t i) {
+    auto [v0, v1] = getGate(i);
+    return device.getDistance(placement.getPhy(v0), placement.getPhy(v1));
+  };
+  auto computeLayerCost = [&](ArrayRef<std::size_t> layer) {
+    double cost = 0.0;
+    for (auto i : layer)
+      cost += getDistance(i) - 1;
+    return cost / layer.size();
+  };
+
+  // Each gate depends on the previous gate on each of its qubits.
+  SmallVector<unsigned> numPredecessors(numGates, 0);
+  SmallVector<SmallVector<std::size_t, 2>> successors(numGates);
+  DenseMap<unsigned, std::size_t> lastGate;
+  for (std::size_t i = 0; i < numGates; ++i) {
+    auto [v0, v1] = getGate(i);
+    for (auto vr : {v0, v1}) {
+      auto [entry, created] = lastGate.try_emplace(vr.index, i);
+      if (created)
+        continue;
+      successors[entry->second].push_back(i);
+      numPredecessors[i] += 1;
+      entry->second = i;
+    }
+  }
+
+  SmallVector<std::size_t> frontLayer;
+  for (std::size_t i = 0; i < numGates; ++i)
+    if (numPredecessors[i] == 0)
+      frontLayer.push_back(i);
+
+  SmallVector<bool> mapped(numGates, false);
+  SmallVector<float> phyDecay(device.getNumQubits(), 1.0);
+  std::size_t firstUnmapped = 0;
+  std::size_t numSwapSearches = 0;
+  unsigned numSwaps = 0;
+  unsigned numSwapsWithoutProgress = 0;
+  const unsigned maxSwapsWithoutProgress = 2 * device.getNumQubits();
+  while (!frontLayer.empty()) {
+    bool mappedAtLeastOne = false;
+    SmallVector<std::size_t> newFrontLayer;
+    for (auto i : frontLayer) {
+      if (getDistance(i) > 1) {
+        newFrontLayer.push_back(i);
+        continue;
+      }
+      mappedAtLeastOne = true;
+      mapped[i] = true;
+      for (auto succ : successors[i])
+        if (--numPredecessors[succ] == 0)
+          newFrontLayer.push_back(succ);
+    }
+    frontLayer = std::move(newFrontLayer);
+    if (mappedAtLeastOne) {
+      numSwapsWithoutProgress = 0;
+      continue;
+    }
+
+    // The decay only discourages, but does not prevent, the heuristic from
+    // oscillating. If it fails to make progress, bring the qubits of the first
+    // gate together along a shortest path.
+    if (numSwapsWithoutProgress > maxSwapsWithoutProgress) {
+      auto [v0, v1] = getGate(frontLayer.front());
+      auto path = device.getShortestPath(placement.getPhy(v0),
+                                         placement.getPhy(v1));
+      for (std::size_t i = 0; i + 2 < path.size(); ++i, ++numSwaps)
+        placement.swap(path[i], path[i + 1]);
+      numSwapsWithoutProgress = 0;
+      continue;
+    }
+
+    // The extended layer holds the next two-qubit gates in program order.
+    SmallVector<std::size_t> extendedLayer;
+    while (firstUnmapped < numGates && mapped[firstUnmapped])
+      ++firstUnmapped;
+    for (std::size_t i = firstUnmapped;
+         i < numGates && extendedLayer.size() < extendedLayerSize; ++i)
+      if (!mapped[i] && numPredecessors[i] > 0)
+        extendedLayer.push_back(i);
+
+    llvm::SmallSet<Placement::DeviceQ, 32> involvedPhy;
+    for (auto i : frontLayer) {
+      auto [v0, v1] = getGate(i);
+      involvedPhy.insert(placement.getPhy(v0));
+      involvedPhy.insert(placement.getPhy(v1));
+    }
+
+    std::optional<std::pair<Placement::DeviceQ, Placement::DeviceQ>> bestSwap;
+    double bestCost = 0.0;
+    for (auto phy0 : involvedPhy)
+      for (auto phy1 : device.getNeighbours(phy0)) {
+        placement.swap(phy0, phy1);
+        double swapCost = computeLayerCost(frontLayer);
+        double maxDecay = std::max(phyDecay[phy0.index], phyDecay[phy1.index]);
+        if (!extendedLayer.empty()) {
+          double extendedLayerCost =
+              computeLayerCost(extendedLayer) / extendedLayer.size();
+          swapCost /= frontLayer.size();
+          swapCost += extendedLayerWeight * extendedLayerCost;
+        }
+        placement.swap(phy0, phy1);
+        if (!bestSwap || maxDecay * swapCost < bestCost) {
+          bestSwap = {phy0, phy1};
+          bestCost = maxDecay * swapCost;
+        }
+      }
+
+    auto [phy0, phy1] = *bestSwap;
+    placement.swap(phy0, phy1);
+    numSwaps += 1;
+    numSwapsWithoutProgress += 1;
+
+    // Update decay
+    numSwapSearches++;
+    if ((numSwapSearches % roundsDecayReset) == 0) {
+      std::fill(phyDecay.begin(), phyDecay.end(), 1.0);
+    } else {
+      phyDecay[phy0.index] += decayDelta;
+      phyDecay[phy1.index] += decayDelta;
+    }
+  }
+  return numSwaps;
+}
+
 //===----------------------------------------------------------------------===//
 // Routing
 //===----------------------------------------------------------------------===//
@@ -595,6 +864,68 @@ struct MappingPrep : public cudaq::opt::impl::MappingPrepBase<MappingPrep> {
 struct MappingFunc : public cudaq::opt::impl::MappingFuncBase<MappingFunc> {
   using MappingFuncBase::MappingFuncBase;
 
+  enum PlacementEnum { Unknown, Identity, Subgraph, Sabre };
+  PlacementEnum placementType;
+
+  virtual LogicalResult initialize(MLIRContext *context) override {
+    placementType = llvm::StringSwitch<PlacementEnum>(placement)
+                        .Case("identity", Identity)
+                        .Case("subgraph", Subgraph)
+                        .Case("sabre", Sabre)
+                        .Default(Unknown);
+    if (placementType == Unknown) {
+      llvm::errs() << "Unknown placement option: " << placement << '\n';
+      return failure();
+    }
+    return success();
+  }
+
+  /// Select the initial placement of the virtual qubits. The first trial starts
+  /// from the requested strategy and the remaining ones from random
+  /// placements. With the `sabre` strategy, each trial is refined by routing
+  /// the circuit forward and backward. The trial whose placement needs the
+  /// fewest swaps to route `circuit` is kept.
+  void computeInitialPlacement(const Device &d, ArrayRef<Interaction> circuit,
+                               Placement &initialPlacement) {
+    identityPlacement(initialPlacement);
+    if (circuit.empty() || (placementType == Identity && placementTrials <= 1))
+      return;
+
+    RoutingEstimator estimator(d, circuit, extendedLayerSize,
+                               extendedLayerWeight, decayDelta,
+                               roundsDecayReset);
+    std::mt19937 generator(placementSeed);
+    std::optional<Placement> bestPlacement;
+    unsigned bestNumSwaps = 0;
+    for (unsigned trial = 0, end = std::max(1u, placementTrials.getValue());
+         trial < end; ++trial) {
+      Placement candidate(initialPlacement.getNumVirtualQ(),
+                          initialPlacement.getNumDeviceQ());
+      if (trial > 0)
+        randomPlacement(candidate, generator);
+      else if (placementType == Subgraph)
+        interactionGraphPlacement(d, circuit, candidate);
+      else
+        identityPlacement(candidate);
+
+      if (placementType == Sabre)
+        for (unsigned i = 0; i < placementIterations; ++i) {
+          estimator.route(candidate);
+          estimator.route(candidate, /*reverse=*/true);
+        }
+
+      Placement finalPlacement = candidate;
+      unsigned numSwaps = estimator.route(finalPlacement);
+      LLVM_DEBUG(llvm::dbgs() << "Placement trial " << trial << ": "
+                              << numSwaps << " estimated swaps\n");
+      if (!bestPlacement || numSwaps < bestNumSwaps) {
+        bestPlacement = candidate;
+        bestNumSwaps = numSwaps;
+      }
+    }
+    initialPlacement = *bestPlacement;
+  }
+
   /// Add `op` and all of its users into `opsToMoveToEnd`. `op` may not be
   /// nullptr.
   void addOpAndUsersToList(Operation *op,
@@ -677,6 +1008,7 @@ struct MappingFunc : public cudaq::opt::impl::MappingFuncBase<MappingFunc> {
     SmallVector<quake::ReturnWireOp> returnsToRemove;
     DenseMap<Value, Placement::VirtualQ> wireToVirtualQ;
     SmallVector<std::size_t> userQubitsMeasured;
+    SmallVector<Interaction> interactions;
     DenseMap<std::size_t, Value> finalQubitWire;
     Operation *lastSource = nullptr;
     for (Operation &op : block.getOperations()) {
@@ -733,6 +1065,11 @@ struct MappingFunc : public cudaq::opt::impl::MappingFuncBase<MappingFunc> {
           for (const auto &wire : wireOperands)
             userQubitsMeasured.push_back(wireToVirtualQ[wire].index);
 
+        // Save the two-qubit interactions for the placement
+        if (!op.hasTrait<QuantumMeasure>() && wireOperands.size() == 2)
+          interactions.emplace_back(wireToVirtualQ[wireOperands[0]],
+                                    wireToVirtualQ[wireOperands[1]]);
+
         // Map the result wires to the appropriate virtual qubits.
         for (auto &&[wire, newWire] :
              llvm::zip_equal(wireOperands, quake::getQuantumResults(&op))) {
@@ -812,7 +1149,12 @@ struct MappingFunc : public cudaq::opt::impl::MappingFuncBase<MappingFunc> {
 
     // Place
     Placement placement(sources.size(), d.getNumQubits());
-    identityPlacement(placement);
+    computeInitialPlacement(d, interactions, placement);
+
+    // Borrowed wires denote device qubits, so relabel each source with the
+    // device qubit its virtual qubit is initially placed on.
+    for (auto &&[i, s] : llvm::enumerate(sources))
+      s.setIdentity(placement.getPhy(Placement::VirtualQ(i)).index);
 
     // Route
     SabreRouter router(d, wireToVirtualQ, placement, extendedLayerSize,
@@ -840,8 +1182,9 @@ struct MappingFunc : public cudaq::opt::impl::MappingFuncBase<MappingFunc> {
         s->erase();
       } else {
         // highestMappedQubit = i;
-        builder.create<quake::ReturnWireOp>(phyToWire[i].getLoc(),
-                                            phyToWire[i]);
+        auto phy = s.getIdentity();
+        builder.create<quake::ReturnWireOp>(phyToWire[phy].getLoc(),
+                                            phyToWire[phy]);
       }
     }
 
@@ -915,6 +1258,10 @@ struct MappingPipelineOptions
   DECLARE_SUB_OPTION(MappingFuncOptions, extendedLayerWeight);
   DECLARE_SUB_OPTION(MappingFuncOptions, decayDelta);
   DECLARE_SUB_OPTION(MappingFuncOptions, roundsDecayReset);
+  DECLARE_SUB_OPTION(MappingFuncOptions, placement);
+  DECLARE_SUB_OPTION(MappingFuncOptions, placementTrials);
+  DECLARE_SUB_OPTION(MappingFuncOptions, placementIterations);
+  DECLARE_SUB_OPTION(MappingFuncOptions, placementSeed);
 };
 
 // Helper macro to set MappingFuncOptions field if the corresponding field in
@@ -942,6 +1289,10 @@ void registerMappingPipeline() {
         SET_IF_EXISTS(funcOpts, opt, extendedLayerWeight);
         SET_IF_EXISTS(funcOpts, opt, decayDelta);
         SET_IF_EXISTS(funcOpts, opt, roundsDecayReset);
+        SET_IF_EXISTS(funcOpts, opt, placement);
+        SET_IF_EXISTS(funcOpts, opt, placementTrials);
+        SET_IF_EXISTS(funcOpts, opt, placementIterations);
+        SET_IF_EXISTS(funcOpts, opt, placementSeed);
         pm.addNestedPass<func::FuncOp>(cudaq::opt::createMappingFunc(funcOpts));
       });
 }
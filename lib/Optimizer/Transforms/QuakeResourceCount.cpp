@@ -0,0 +1,337 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "LoopAnalysis.h"
+#include "PassDetails.h"
+#include "cudaq/Optimizer/Builder/Factory.h"
+#include "cudaq/Optimizer/Dialect/CC/CCOps.h"
+#include "cudaq/Optimizer/Dialect/Quake/QuakeOps.h"
+#include "cudaq/Optimizer/Transforms/Passes.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/ToolOutputFile.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+
+namespace cudaq::opt {
+#define GEN_PASS_DEF_QUAKERESOURCECOUNT
+#include "cudaq/Optimizer/Transforms/Passes.h.inc"
+} // namespace cudaq::opt
+
+#define DEBUG_TYPE "quake-resource-count"
+
+using namespace mlir;
+
+namespace {
+/// Operation counts of a region of a kernel.
+struct ResourceCounts {
+  /// Number of applications of each gate, by number of controls.
+  std::map<std::string, std::map<std::size_t, std::uint64_t>> gates;
+  std::uint64_t tCount = 0;
+  std::uint64_t twoQubitGates = 0;
+  std::uint64_t measurements = 0;
+
+  /// Add the counts of \p other, executed \p times times.
+  void add(const ResourceCounts &other, std::uint64_t times) {
+    for (auto &[name, byControls] : other.gates)
+      for (auto [numControls, count] : byControls)
+        gates[name][numControls] += count * times;
+    tCount += other.tCount * times;
+    twoQubitGates += other.twoQubitGates * times;
+    measurements += other.measurements * times;
+  }
+
+  std::uint64_t totalGates() const {
+    std::uint64_t total = 0;
+    for (auto &[name, byControls] : gates)
+      for (auto [numControls, count] : byControls)
+        total += count;
+    return total;
+  }
+};
+
+/// Upper bound of the number of layers of multi-qubit gates of a region. Qubits
+/// are identified by their allocation and their constant index in it. An
+/// operation on a qubit that cannot be identified, or a nested region that is
+/// summarized by its own bound, synchronizes all the qubits.
+class TwoQubitDepth {
+public:
+  using QubitId = std::pair<Operation *, std::int64_t>;
+
+  void apply(ArrayRef<QubitId> qubits) {
+    std::uint64_t layer = floor;
+    for (auto qubit : qubits)
+      layer = std::max(layer, depths.lookup(qubit));
+    ++layer;
+    for (auto qubit : qubits)
+      depths[qubit] = layer;
+    depth = std::max(depth, layer);
+  }
+
+  /// Append \p layers layers that may involve any qubit.
+  void synchronize(std::uint64_t layers) {
+    floor = depth + layers;
+    depth = floor;
+  }
+
+  std::uint64_t get() const { return depth; }
+
+private:
+  DenseMap<QubitId, std::uint64_t> depths;
+  std::uint64_t floor = 0;
+  std::uint64_t depth = 0;
+};
+
+class ResourceCounter {
+public:
+  explicit ResourceCounter(ModuleOp module) : module(module) {}
+
+  /// Count the operations of \p region, executed once, into \p counts.
+  void visitRegion(Region &region, ResourceCounts &counts,
+                   TwoQubitDepth &depth) {
+    // Without knowing which branches are taken, every block is counted once.
+    if (!region.hasOneBlock() && !region.empty())
+      exact = false;
+    for (auto &block : region)
+      for (auto &op : block)
+        visitOp(&op, counts, depth);
+  }
+
+  /// True if the counts are exact, rather than an estimate.
+  bool exact = true;
+
+private:
+  void visitOp(Operation *op, ResourceCounts &counts, TwoQubitDepth &depth) {
+    if (auto gate = dyn_cast<quake::OperatorInterface>(op)) {
+      std::size_t numControls = 0;
+      for (auto control : gate.getControls())
+        numControls += numQubits(control);
+      std::size_t numTargets = 0;
+      for (auto target : gate.getTargets())
+        numTargets += numQubits(target);
+      counts.gates[op->getName().stripDialect().str()][numControls]++;
+      if (isa<quake::TOp>(op) && numControls == 0)
+        counts.tCount++;
+      if (numControls + numTargets >= 2) {
+        counts.twoQubitGates++;
+        SmallVector<Value> operands(gate.getControls());
+        operands.append(gate.getTargets().begin(), gate.getTargets().end());
+        applyToQubits(operands, depth);
+      }
+      return;
+    }
+    if (auto measure = dyn_cast<quake::MeasurementInterface>(op)) {
+      for (auto target : measure.getTargets())
+        counts.measurements += numQubits(target);
+      return;
+    }
+    if (auto loop = dyn_cast<cudaq::cc::LoopOp>(op)) {
+      std::optional<std::size_t> iterations;
+      if (cudaq::opt::isaCountedLoop(loop))
+        if (auto components = cudaq::opt::getLoopComponents(loop))
+          iterations = components->getIterationsConstant();
+      ResourceCounts body;
+      TwoQubitDepth bodyDepth;
+      for (auto &region : loop->getRegions())
+        visitRegion(region, body, bodyDepth);
+      if (!iterations && body.totalGates() + body.measurements > 0) {
+        LLVM_DEBUG(llvm::dbgs() << "loop with unknown trip count: " << loop
+                                << '\n');
+        exact = false;
+      }
+      // The loop body is counted once when its trip count is unknown.
+      const std::uint64_t times = iterations.value_or(1);
+      counts.add(body, times);
+      depth.synchronize(bodyDepth.get() * times);
+      return;
+    }
+    if (auto ifOp = dyn_cast<cudaq::cc::IfOp>(op)) {
+      // Both branches are counted, which bounds the counts of either one.
+      std::uint64_t branchDepth = 0;
+      for (auto &region : ifOp->getRegions()) {
+        ResourceCounts branch;
+        TwoQubitDepth branchQubitDepth;
+        visitRegion(region, branch, branchQubitDepth);
+        if (branch.totalGates() + branch.measurements > 0)
+          exact = false;
+        counts.add(branch, 1);
+        branchDepth = std::max(branchDepth, branchQubitDepth.get());
+      }
+      depth.synchronize(branchDepth);
+      return;
+    }
+    if (isa<quake::ApplyOp, func::CallOp, func::CallIndirectOp,
+            cudaq::cc::CallCallableOp, cudaq::cc::CallIndirectCallableOp>(
+            op)) {
+      // Callees are not followed, the kernel must be inlined first.
+      if (callsQuantumCode(op))
+        exact = false;
+      return;
+    }
+    for (auto &region : op->getRegions())
+      visitRegion(region, counts, depth);
+  }
+
+  /// Number of qubits referenced by the quantum value \p v.
+  std::size_t numQubits(Value v) {
+    if (auto veqTy = dyn_cast<quake::VeqType>(v.getType())) {
+      if (veqTy.hasSpecifiedSize())
+        return veqTy.getSize();
+      exact = false;
+    }
+    return 1;
+  }
+
+  /// Identify the qubit \p v, if it is a constant index into an allocation.
+  static std::optional<TwoQubitDepth::QubitId> getQubitId(Value v) {
+    if (auto alloc = v.getDefiningOp<quake::AllocaOp>())
+      if (isa<quake::RefType>(alloc.getType()))
+        return TwoQubitDepth::QubitId{alloc, 0};
+    if (auto extract = v.getDefiningOp<quake::ExtractRefOp>())
+      if (extract.hasConstantIndex())
+        if (auto alloc = extract.getVeq().getDefiningOp<quake::AllocaOp>())
+          return TwoQubitDepth::QubitId{
+              alloc, static_cast<std::int64_t>(extract.getConstantIndex())};
+    return std::nullopt;
+  }
+
+  static void applyToQubits(ArrayRef<Value> operands, TwoQubitDepth &depth) {
+    SmallVector<TwoQubitDepth::QubitId> qubits;
+    for (auto operand : operands) {
+      auto id = getQubitId(operand);
+      if (!id) {
+        depth.synchronize(1);
+        return;
+      }
+      qubits.push_back(*id);
+    }
+    depth.apply(qubits);
+  }
+
+  bool callsQuantumCode(Operation *op) {
+    SymbolRefAttr callee;
+    if (auto call = dyn_cast<func::CallOp>(op))
+      callee = call.getCalleeAttr();
+    else if (auto apply = dyn_cast<quake::ApplyOp>(op))
+      callee = apply.getCalleeAttr();
+    if (!callee)
+      return true;
+    auto func = module.lookupSymbol<func::FuncOp>(callee);
+    if (!func)
+      return true;
+    if (func.empty())
+      return false;
+    return func
+        .walk([](Operation *op) {
+          if (isa<quake::OperatorInterface, quake::MeasurementInterface>(op))
+            return WalkResult::interrupt();
+          return WalkResult::advance();
+        })
+        .wasInterrupted();
+  }
+
+  ModuleOp module;
+};
+
+/// Statically count the resources used by every kernel of the module, and
+/// report them as JSON. Counted loops multiply the counts of their body by
+/// their trip count, so that loops do not need to be unrolled.
+class QuakeResourceCountPass
+    : public cudaq::opt::impl::QuakeResourceCountBase<QuakeResourceCountPass> {
+public:
+  using QuakeResourceCountBase::QuakeResourceCountBase;
+
+  void runOnOperation() override {
+    auto module = getOperation();
+    std::error_code ec;
+    llvm::ToolOutputFile out(outputFilename, ec, llvm::sys::fs::OF_None);
+    if (ec) {
+      module.emitError("failed to open output file '" + outputFilename + "'");
+      signalPassFailure();
+      return;
+    }
+
+    llvm::json::OStream json(out.os(), /*IndentSize=*/2);
+    json.objectBegin();
+    for (auto func : module.getOps<func::FuncOp>()) {
+      if (func.empty() || !hasQuantumCode(func))
+        continue;
+      ResourceCounter counter(module);
+      ResourceCounts counts;
+      TwoQubitDepth depth;
+      counter.visitRegion(func.getBody(), counts, depth);
+      auto qubits = countQubits(func);
+      if (!qubits)
+        counter.exact = false;
+
+      json.attributeObject(func.getName(), [&] {
+        if (qubits)
+          json.attribute("qubits", static_cast<std::int64_t>(*qubits));
+        else
+          json.attribute("qubits", nullptr);
+        json.attribute("total_gates",
+                       static_cast<std::int64_t>(counts.totalGates()));
+        json.attributeObject("gates", [&] {
+          for (auto &[name, byControls] : counts.gates)
+            json.attributeObject(name, [&] {
+              for (auto [numControls, count] : byControls)
+                json.attribute(std::to_string(numControls),
+                               static_cast<std::int64_t>(count));
+            });
+        });
+        json.attribute("t_count", static_cast<std::int64_t>(counts.tCount));
+        json.attribute("two_qubit_gates",
+                       static_cast<std::int64_t>(counts.twoQubitGates));
+        json.attribute("two_qubit_depth_bound",
+                       static_cast<std::int64_t>(depth.get()));
+        json.attribute("measurements",
+                       static_cast<std::int64_t>(counts.measurements));
+        json.attribute("exact", counter.exact);
+      });
+    }
+    json.objectEnd();
+    out.os() << '\n';
+    out.keep();
+  }
+
+private:
+  static bool hasQuantumCode(func::FuncOp func) {
+    return func
+        .walk([](Operation *op) {
+          if (isa<quake::AllocaOp, quake::OperatorInterface,
+                  quake::MeasurementInterface>(op))
+            return WalkResult::interrupt();
+          return WalkResult::advance();
+        })
+        .wasInterrupted();
+  }
+
+  /// Total size of the qubit allocations of \p func, where allocations in
+  /// loops are counted once. Returns `std::nullopt` if a size is not known.
+  static std::optional<std::uint64_t> countQubits(func::FuncOp func) {
+    std::optional<std::uint64_t> total = 0;
+    func.walk([&](quake::AllocaOp alloc) {
+      if (!total)
+        return;
+      if (isa<quake::RefType>(alloc.getType())) {
+        *total += 1;
+      } else if (auto veqTy = dyn_cast<quake::VeqType>(alloc.getType());
+                 veqTy && veqTy.hasSpecifiedSize()) {
+        *total += veqTy.getSize();
+      } else if (auto size = alloc.getSize()) {
+        if (auto value = cudaq::opt::factory::maybeValueOfIntConstant(size))
+          *total += *value;
+        else
+          total = std::nullopt;
+      } else {
+        total = std::nullopt;
+      }
+    });
+    return total;
+  }
+};
+} // namespace
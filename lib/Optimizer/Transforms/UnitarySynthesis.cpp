@@ -13,13 +13,16 @@
 #include "cudaq/Optimizer/Dialect/CC/CCOps.h"
 #include "cudaq/Optimizer/Dialect/Quake/QuakeOps.h"
 #include "cudaq/Optimizer/Transforms/Passes.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/MathExtras.h"
 #include "mlir/Conversion/LLVMCommon/TypeConverter.h"
 #include "mlir/Dialect/LLVMIR/LLVMDialect.h"
 #include "mlir/Dialect/LLVMIR/LLVMTypes.h"
 #include "mlir/Transforms/DialectConversion.h"
 #include "mlir/Transforms/GreedyPatternRewriteDriver.h"
 #include "mlir/Transforms/Passes.h"
+#include <bit>
 #include <unsupported/Eigen/KroneckerProduct>
 #include <unsupported/Eigen/MatrixFunctions>
 
@@ -351,8 +354,10 @@ struct TwoQubitOpKAK : public Decomposer {
     auto parentModule = customOp->getParentOfType<ModuleOp>();
     Location loc = customOp->getLoc();
     auto targets = customOp.getTargets();
-    auto funcTy =
-        FunctionType::get(parentModule.getContext(), targets.getTypes(), {});
+    /// NOTE: This may be a sub-unitary of a larger custom operation, see
+    /// `MultiQubitOpQSD`.
+    SmallVector<Type> argTypes(2, targets[0].getType());
+    auto funcTy = FunctionType::get(parentModule.getContext(), argTypes, {});
     auto insPt = rewriter.saveInsertionPoint();
     rewriter.setInsertionPointToStart(parentModule.getBody());
     auto func =
@@ -434,10 +439,307 @@ struct TwoQubitOpKAK : public Decomposer {
   }
 };
 
+/// Create the decomposer of a unitary matrix, according to its dimension.
+std::unique_ptr<Decomposer> createDecomposer(const Eigen::MatrixXcd &matrix);
+
+/// Angles of the rotations of a multiplexed (uniformly controlled) rotation
+/// implemented with the Gray code circuit.
+/// Ref: https://arxiv.org/pdf/quant-ph/0407010
+/// `angles[j]` is the rotation angle applied when the select qubits are in the
+/// basis state `j`. The result `alpha` is such that the circuit
+/// R(alpha[0]) CX R(alpha[1]) CX ... R(alpha[N-1]) CX, where the i-th CNOT is
+/// controlled by the select qubit of the bit that differs between the Gray
+/// codes of i and i + 1, implements the multiplexed rotation.
+std::vector<double>
+multiplexedRotationAngles(const std::vector<double> &angles) {
+  const std::size_t size = angles.size();
+  std::vector<double> alpha(size, 0.0);
+  for (std::size_t i = 0; i < size; i++) {
+    const std::size_t gray = i ^ (i >> 1);
+    for (std::size_t j = 0; j < size; j++)
+      alpha[i] += (std::popcount(j & gray) % 2 ? -1.0 : 1.0) * angles[j];
+    alpha[i] /= size;
+  }
+  return alpha;
+}
+
+/// Result of the cosine-sine decomposition of a unitary
+/// U = (L0 ⊕ L1) (C -S; S C) (R0 ⊕ R1), where C and S are diagonal matrices
+/// of the cosines and sines of `thetas`.
+struct CosineSineComponents {
+  Eigen::MatrixXcd l0;
+  Eigen::MatrixXcd l1;
+  Eigen::MatrixXcd r0;
+  Eigen::MatrixXcd r1;
+  std::vector<double> thetas;
+};
+
+/// Cosine-sine decomposition of a 2m x 2m unitary matrix, computed from the
+/// singular value decomposition of its top-left block.
+CosineSineComponents cosineSineDecomposition(const Eigen::MatrixXcd &matrix) {
+  const Eigen::Index half = matrix.rows() / 2;
+  auto u00 = matrix.topLeftCorner(half, half);
+  auto u01 = matrix.topRightCorner(half, half);
+  auto u10 = matrix.bottomLeftCorner(half, half);
+  auto u11 = matrix.bottomRightCorner(half, half);
+  CosineSineComponents result;
+  /// U00 = L0 C R0
+  Eigen::JacobiSVD<Eigen::MatrixXcd> svd(u00, Eigen::ComputeFullU |
+                                                  Eigen::ComputeFullV);
+  result.l0 = svd.matrixU();
+  result.r0 = svd.matrixV().adjoint();
+  Eigen::VectorXd cosines = svd.singularValues().cwiseMin(1.0);
+  /// U10 R0^† = L1 S, whose columns are orthogonal with norms equal to the
+  /// sines. Columns with a vanishing sine are completed into an orthonormal
+  /// basis with a QR decomposition.
+  Eigen::MatrixXcd l1s = u10 * result.r0.adjoint();
+  Eigen::VectorXd sines(half);
+  result.l1 = Eigen::MatrixXcd::Zero(half, half);
+  std::vector<Eigen::Index> degenerate;
+  for (Eigen::Index i = 0; i < half; i++) {
+    sines(i) = l1s.col(i).norm();
+    if (sines(i) > TOL) {
+      result.l1.col(i) = l1s.col(i) / sines(i);
+    } else {
+      sines(i) = 0.0;
+      degenerate.push_back(i);
+    }
+  }
+  if (!degenerate.empty()) {
+    const Eigen::Index rank = half - degenerate.size();
+    Eigen::MatrixXcd complement = Eigen::MatrixXcd::Identity(half, half);
+    if (rank > 0) {
+      Eigen::MatrixXcd columns(half, rank);
+      for (Eigen::Index i = 0, k = 0; i < half; i++)
+        if (sines(i) > 0.0)
+          columns.col(k++) = result.l1.col(i);
+      /// The last columns of Q span the orthogonal complement of the columns
+      /// of L1 that are already known.
+      Eigen::MatrixXcd q = Eigen::HouseholderQR<Eigen::MatrixXcd>(columns)
+                               .householderQ();
+      complement = q.rightCols(half - rank);
+    }
+    for (std::size_t k = 0; k < degenerate.size(); k++)
+      result.l1.col(degenerate[k]) = complement.col(k);
+  }
+  /// R1 = C^-1 L1^† U11 = -S^-1 L0^† U01, each row is taken from the better
+  /// conditioned of the two expressions.
+  Eigen::MatrixXcd fromU11 = result.l1.adjoint() * u11;
+  Eigen::MatrixXcd fromU01 = result.l0.adjoint() * u01;
+  result.r1.resize(half, half);
+  result.thetas.resize(half);
+  for (Eigen::Index i = 0; i < half; i++) {
+    result.thetas[i] = std::atan2(sines(i), cosines(i));
+    if (cosines(i) >= sines(i))
+      result.r1.row(i) = fromU11.row(i) / cosines(i);
+    else
+      result.r1.row(i) = -fromU01.row(i) / sines(i);
+  }
+  return result;
+}
+
+/// Result of the demultiplexing of a block diagonal unitary
+/// U0 ⊕ U1 = (I ⊗ V) (D ⊕ D^†) (I ⊗ W), where D is diagonal. D ⊕ D^† is the
+/// multiplexed Rz rotation of the most significant qubit by `angles`.
+struct DemultiplexComponents {
+  Eigen::MatrixXcd v;
+  Eigen::MatrixXcd w;
+  std::vector<double> angles;
+};
+
+/// Ref: Theorem 12 of https://arxiv.org/pdf/quant-ph/0406176
+DemultiplexComponents demultiplex(const Eigen::MatrixXcd &u0,
+                                  const Eigen::MatrixXcd &u1) {
+  /// U0 U1^† = V D^2 V^†. This product is normal, hence its Schur form is
+  /// diagonal and the Schur vectors are orthonormal even for degenerate
+  /// eigenvalues.
+  Eigen::ComplexSchur<Eigen::MatrixXcd> schur(u0 * u1.adjoint());
+  DemultiplexComponents result;
+  result.v = schur.matrixU();
+  const auto size = u0.rows();
+  Eigen::VectorXcd d(size);
+  result.angles.resize(size);
+  for (Eigen::Index i = 0; i < size; i++) {
+    const double phi = 0.5 * std::arg(schur.matrixT()(i, i));
+    d(i) = std::exp(1i * phi);
+    /// Rz(theta) = diag(exp(-i theta / 2), exp(i theta / 2))
+    result.angles[i] = -2.0 * phi;
+  }
+  /// W = D V^† U1
+  result.w = d.asDiagonal() * result.v.adjoint() * u1;
+  return result;
+}
+
+/// Decomposition of an arbitrary n-qubit unitary, n > 2, with the quantum
+/// Shannon decomposition. The unitary is split with a cosine-sine
+/// decomposition on its most significant qubit, and both block diagonal
+/// factors are demultiplexed, such that
+/// U = (I ⊗ V_l) Rz_l (I ⊗ W_l) Ry (I ⊗ V_r) Rz_r (I ⊗ W_r),
+/// where the Rz and Ry are rotations of the most significant qubit multiplexed
+/// by the other qubits, and V, W are (n-1)-qubit unitaries which are
+/// decomposed recursively, down to `TwoQubitOpKAK`.
+/// Ref: https://arxiv.org/pdf/quant-ph/0406176
+struct MultiQubitOpQSD : public Decomposer {
+  Eigen::MatrixXcd targetMatrix;
+  DemultiplexComponents left;
+  DemultiplexComponents right;
+  std::vector<double> ryAngles;
+
+  void decompose() override {
+    auto cs = cosineSineDecomposition(targetMatrix);
+    left = demultiplex(cs.l0, cs.l1);
+    right = demultiplex(cs.r0, cs.r1);
+    /// (C -S; S C) is the multiplexed Ry(2 theta)
+    ryAngles.clear();
+    for (auto theta : cs.thetas)
+      ryAngles.push_back(2.0 * theta);
+    /// Final check to verify results
+    assert(targetMatrix.isApprox(
+        blockDiagonal(left.v, left.v) * rzMatrix(left.angles) *
+            blockDiagonal(left.w, left.w) * ryMatrix() *
+            blockDiagonal(right.v, right.v) * rzMatrix(right.angles) *
+            blockDiagonal(right.w, right.w),
+        TOL));
+  }
+
+  /// Multiplexed rotation of \p target by \p angles, selected by the state of
+  /// \p selects, with the most significant select qubit first. Rotations by a
+  /// vanishing angle are dropped, and if the rotation does not depend on the
+  /// select qubits, so are the CNOTs.
+  template <typename OP>
+  void emitMultiplexedRotation(Location loc, PatternRewriter &rewriter,
+                               const std::vector<double> &angles, Value target,
+                               ValueRange selects) {
+    auto alpha = multiplexedRotationAngles(angles);
+    bool uniform = std::none_of(alpha.begin() + 1, alpha.end(),
+                                [&](double a) { return isAboveThreshold(a); });
+    FloatType floatTy = rewriter.getF64Type();
+    for (std::size_t i = 0; i < alpha.size(); i++) {
+      if (isAboveThreshold(alpha[i])) {
+        auto angle = cudaq::opt::factory::createFloatConstant(
+            loc, rewriter, alpha[i], floatTy);
+        rewriter.create<OP>(loc, angle, ValueRange{}, target);
+      }
+      if (uniform)
+        break;
+      const std::size_t next = (i + 1) % alpha.size();
+      const auto bit = std::countr_zero((i ^ (i >> 1)) ^ (next ^ (next >> 1)));
+      rewriter.create<quake::XOp>(loc, selects[selects.size() - 1 - bit],
+                                  target);
+    }
+  }
+
+  void emitDecomposedFuncOp(quake::CustomUnitarySymbolOp customOp,
+                            PatternRewriter &rewriter,
+                            std::string funcName) override {
+    /// The (n-1)-qubit unitaries, identities are not applied
+    std::vector<std::pair<const Eigen::MatrixXcd *, std::string>> subUnitaries{
+        {&right.w, "rw"}, {&right.v, "rv"}, {&left.w, "lw"}, {&left.v, "lv"}};
+    for (auto &[matrix, suffix] : subUnitaries)
+      if (!matrix->isIdentity(TOL))
+        createDecomposer(*matrix)->emitDecomposedFuncOp(customOp, rewriter,
+                                                        funcName + suffix);
+    auto parentModule = customOp->getParentOfType<ModuleOp>();
+    Location loc = customOp->getLoc();
+    auto targets = customOp.getTargets();
+    const auto numQubits = std::countr_zero(
+        static_cast<std::size_t>(targetMatrix.rows()));
+    SmallVector<Type> argTypes(numQubits, targets[0].getType());
+    auto funcTy = FunctionType::get(parentModule.getContext(), argTypes, {});
+    auto insPt = rewriter.saveInsertionPoint();
+    rewriter.setInsertionPointToStart(parentModule.getBody());
+    auto func =
+        rewriter.create<func::FuncOp>(parentModule->getLoc(), funcName, funcTy);
+    func.setPrivate();
+    auto *block = func.addEntryBlock();
+    rewriter.setInsertionPointToStart(block);
+    auto arguments = func.getArguments();
+    Value msb = arguments[0];
+    ValueRange rest = arguments.drop_front();
+    auto applySubUnitary = [&](const Eigen::MatrixXcd &matrix,
+                               StringRef suffix) {
+      if (matrix.isIdentity(TOL))
+        return;
+      rewriter.create<quake::ApplyOp>(
+          loc, TypeRange{},
+          SymbolRefAttr::get(rewriter.getContext(), funcName + suffix.str()),
+          false, ValueRange{}, rest);
+    };
+    /// NOTE: Operator notation is right-to-left, whereas circuit notation is
+    /// left-to-right. Hence, operations are applied in reverse order.
+    applySubUnitary(right.w, "rw");
+    emitMultiplexedRotation<quake::RzOp>(loc, rewriter, right.angles, msb,
+                                         rest);
+    applySubUnitary(right.v, "rv");
+    emitMultiplexedRotation<quake::RyOp>(loc, rewriter, ryAngles, msb, rest);
+    applySubUnitary(left.w, "lw");
+    emitMultiplexedRotation<quake::RzOp>(loc, rewriter, left.angles, msb,
+                                         rest);
+    applySubUnitary(left.v, "lv");
+    rewriter.create<func::ReturnOp>(loc);
+    rewriter.restoreInsertionPoint(insPt);
+  }
+
+  MultiQubitOpQSD(const Eigen::MatrixXcd &vec) {
+    targetMatrix = vec;
+    decompose();
+  }
+
+private:
+  static Eigen::MatrixXcd blockDiagonal(const Eigen::MatrixXcd &u0,
+                                        const Eigen::MatrixXcd &u1) {
+    Eigen::MatrixXcd result =
+        Eigen::MatrixXcd::Zero(2 * u0.rows(), 2 * u0.rows());
+    result.topLeftCorner(u0.rows(), u0.rows()) = u0;
+    result.bottomRightCorner(u1.rows(), u1.rows()) = u1;
+    return result;
+  }
+
+  /// Matrix of the multiplexed Rz rotation of the most significant qubit
+  static Eigen::MatrixXcd rzMatrix(const std::vector<double> &angles) {
+    Eigen::VectorXcd d(angles.size());
+    for (std::size_t i = 0; i < angles.size(); i++)
+      d(i) = std::exp(-0.5i * angles[i]);
+    return blockDiagonal(d.asDiagonal(), d.conjugate().asDiagonal());
+  }
+
+  /// Matrix of the multiplexed Ry rotation of the most significant qubit
+  Eigen::MatrixXcd ryMatrix() const {
+    const Eigen::Index half = ryAngles.size();
+    Eigen::VectorXcd c(half);
+    Eigen::VectorXcd s(half);
+    for (Eigen::Index i = 0; i < half; i++) {
+      c(i) = std::cos(0.5 * ryAngles[i]);
+      s(i) = std::sin(0.5 * ryAngles[i]);
+    }
+    Eigen::MatrixXcd result(2 * half, 2 * half);
+    Eigen::MatrixXcd cosines = c.asDiagonal();
+    Eigen::MatrixXcd sines = s.asDiagonal();
+    result << cosines, -sines, sines, cosines;
+    return result;
+  }
+};
+
+std::unique_ptr<Decomposer> createDecomposer(const Eigen::MatrixXcd &matrix) {
+  switch (matrix.rows()) {
+  case 2:
+    return std::make_unique<OneQubitOpZYZ>(matrix);
+  case 4:
+    return std::make_unique<TwoQubitOpKAK>(matrix);
+  default:
+    return std::make_unique<MultiQubitOpQSD>(matrix);
+  }
+}
+
+/// Maps the raw data of a custom operation matrix to the name of the function
+/// holding its decomposition.
+using SynthesisCache = llvm::StringMap<std::string>;
+
 class CustomUnitaryPattern
     : public OpRewritePattern<quake::CustomUnitarySymbolOp> {
 public:
-  using OpRewritePattern::OpRewritePattern;
+  CustomUnitaryPattern(MLIRContext *ctx, SynthesisCache &cache)
+      : OpRewritePattern(ctx), cache(cache) {}
 
   LogicalResult matchAndRewrite(quake::CustomUnitarySymbolOp customOp,
                                 PatternRewriter &rewriter) const override {
@@ -453,27 +755,31 @@ public:
     /// If the replacement function doesn't exist, create it here
     if (!parentModule.lookupSymbol<func::FuncOp>(funcName)) {
       auto matrix = cudaq::opt::factory::readGlobalConstantArray(globalOp);
-      size_t dimension = std::sqrt(matrix.size());
-      auto unitary =
-          Eigen::Map<Eigen::MatrixXcd>(matrix.data(), dimension, dimension);
-      unitary.transposeInPlace();
-      if (!unitary.isUnitary(TOL)) {
-        customOp.emitWarning("The custom operation matrix must be unitary.");
-        return failure();
-      }
-      switch (dimension) {
-      case 2: {
-        auto zyz = OneQubitOpZYZ(unitary);
-        zyz.emitDecomposedFuncOp(customOp, rewriter, funcName);
-      } break;
-      case 4: {
-        auto kak = TwoQubitOpKAK(unitary);
-        kak.emitDecomposedFuncOp(customOp, rewriter, funcName);
-      } break;
-      default:
-        customOp.emitWarning(
-            "Decomposition of only 1 and 2 qubit custom operations supported.");
-        return failure();
+      /// Each invocation of a custom operation may have its own generator, the
+      /// decomposition of a matrix that was already synthesized is reused.
+      std::string key(reinterpret_cast<const char *>(matrix.data()),
+                      matrix.size() * sizeof(matrix[0]));
+      auto iter = cache.find(key);
+      if (iter != cache.end() &&
+          parentModule.lookupSymbol<func::FuncOp>(iter->second)) {
+        funcName = iter->second;
+      } else {
+        size_t dimension = std::sqrt(matrix.size());
+        auto unitary =
+            Eigen::Map<Eigen::MatrixXcd>(matrix.data(), dimension, dimension);
+        unitary.transposeInPlace();
+        if (!unitary.isUnitary(TOL)) {
+          customOp.emitWarning("The custom operation matrix must be unitary.");
+          return failure();
+        }
+        if (dimension < 2 || !llvm::isPowerOf2_64(dimension)) {
+          customOp.emitWarning("The custom operation matrix dimension must be "
+                               "a power of 2.");
+          return failure();
+        }
+        createDecomposer(unitary)->emitDecomposedFuncOp(customOp, rewriter,
+                                                        funcName);
+        cache[key] = funcName;
       }
     }
     rewriter.replaceOpWithNewOp<quake::ApplyOp>(
@@ -482,6 +788,9 @@ public:
         customOp.getControls(), customOp.getTargets());
     return success();
   }
+
+private:
+  SynthesisCache &cache;
 };
 
 class UnitarySynthesisPass
@@ -492,12 +801,13 @@ public:
   void runOnOperation() override {
     auto *ctx = &getContext();
     auto module = getOperation();
+    SynthesisCache cache;
     for (Operation &op : *module.getBody()) {
       auto func = dyn_cast<func::FuncOp>(op);
       if (!func)
         continue;
       RewritePatternSet patterns(ctx);
-      patterns.insert<CustomUnitaryPattern>(ctx);
+      patterns.insert<CustomUnitaryPattern>(ctx, cache);
       LLVM_DEBUG(llvm::dbgs() << "Before unitary synthesis: " << func << '\n');
       if (failed(applyPatternsAndFoldGreedily(func.getOperation(),
                                               std::move(patterns))))
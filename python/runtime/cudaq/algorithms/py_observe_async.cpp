@@ -153,28 +153,17 @@ observe_result pyObservePar(const PyParType &type, py::object &kernel,
     throw std::runtime_error("Cannot use mpi multi-node observe() without "
                              "MPI (did you initialize MPI?).");
 
-  // Necessarily has to be MPI
-  // Get the rank and the number of ranks
-  auto rank = mpi::rank();
-  auto nRanks = mpi::num_ranks();
-
-  // Each rank gets a subset of the spin terms
-  auto spins = spin_operator.distribute_terms(nRanks);
-
-  // Get this rank's set of spins to compute
-  auto localH = spins[rank];
-
-  // Distribute locally, i.e. to the local nodes QPUs
-  auto localRankResult = details::distributeComputations(
-      [&](std::size_t i, const spin_op &op) {
-        return pyObserveAsync(kernel, op, args, i, shots);
+  // Necessarily has to be MPI. Each rank gets a cost-balanced subset of the
+  // spin terms, and distributes them locally, i.e. to the local node's QPUs
+  return details::distributeRankComputations(
+      [&](const spin_op &localH) {
+        return details::distributeComputations(
+            [&](std::size_t i, const spin_op &op) {
+              return pyObserveAsync(kernel, op, args, i, shots);
+            },
+            localH, nQpus);
       },
-      localH, nQpus);
-
-  // combine all the data via an all_reduce
-  auto exp_val = localRankResult.expectation();
-  auto globalExpVal = mpi::all_reduce(exp_val, std::plus<double>());
-  return observe_result(globalExpVal, spin_operator);
+      spin_operator);
 }
 
 void bindObserveAsync(py::module &mod) {
@@ -13,6 +13,22 @@ namespace cudaq {
 
 static constexpr int NUM_JIT_CACHE_ITEMS_TO_RETAIN = 100;
 
+JITEngine::JITEngine(std::unique_ptr<ExecutionEngine> engine)
+    : execEngine(std::move(engine)) {}
+
+JITEngine::JITEngine(std::unique_ptr<llvm::orc::LLJIT> jit,
+                     std::unique_ptr<llvm::ObjectCache> cache)
+    : objectCache(std::move(cache)), llJit(std::move(jit)) {}
+
+llvm::Expected<void *> JITEngine::lookup(llvm::StringRef name) const {
+  if (execEngine)
+    return execEngine->lookup(name);
+  auto expectedAddr = llJit->lookup(name);
+  if (!expectedAddr)
+    return expectedAddr.takeError();
+  return expectedAddr->toPtr<void *>();
+}
+
 JITExecutionCache::~JITExecutionCache() {
   std::scoped_lock<std::mutex> lock(mutex);
   for (auto &[k, v] : cacheMap)
@@ -24,7 +40,7 @@ bool JITExecutionCache::hasJITEngine(std::size_t hashkey) {
   return cacheMap.count(hashkey);
 }
 
-void JITExecutionCache::cache(std::size_t hash, ExecutionEngine *jit) {
+void JITExecutionCache::cache(std::size_t hash, JITEngine *jit) {
   std::scoped_lock<std::mutex> lock(mutex);
 
   lruList.push_back(hash);
@@ -41,7 +57,7 @@ void JITExecutionCache::cache(std::size_t hash, ExecutionEngine *jit) {
 
   cacheMap.insert({hash, {jit, std::prev(lruList.end())}});
 }
-ExecutionEngine *JITExecutionCache::getJITEngine(std::size_t hash) {
+JITEngine *JITExecutionCache::getJITEngine(std::size_t hash) {
   std::scoped_lock<std::mutex> lock(mutex);
   auto &item = cacheMap.at(hash);
 
@@ -7,7 +7,11 @@
  ******************************************************************************/
 #pragma once
 
+#include "llvm/ExecutionEngine/ObjectCache.h"
+#include "llvm/ExecutionEngine/Orc/LLJIT.h"
 #include "mlir/ExecutionEngine/ExecutionEngine.h"
+#include <list>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
 
@@ -15,8 +19,28 @@ using namespace mlir;
 
 namespace cudaq {
 
+/// @brief A JIT compiled kernel module. Modules compiled in-process are owned
+/// by an MLIR ExecutionEngine, while modules backed by the persistent object
+/// cache (see JITObjectCache.h) are owned by an ORC LLJIT instance, since only
+/// the latter accepts precompiled objects and a custom object cache.
+class JITEngine {
+protected:
+  std::unique_ptr<ExecutionEngine> execEngine;
+  // The object cache must outlive the LLJIT compile layer that refers to it.
+  std::unique_ptr<llvm::ObjectCache> objectCache;
+  std::unique_ptr<llvm::orc::LLJIT> llJit;
+
+public:
+  explicit JITEngine(std::unique_ptr<ExecutionEngine> engine);
+  JITEngine(std::unique_ptr<llvm::orc::LLJIT> jit,
+            std::unique_ptr<llvm::ObjectCache> cache = nullptr);
+
+  /// @brief Look up the address of the given (unmangled) symbol.
+  llvm::Expected<void *> lookup(llvm::StringRef name) const;
+};
+
 /// @brief The JITExecutionCache is a utility class for
-/// storing ExecutionEngine pointers keyed on the hash
+/// storing JITEngine pointers keyed on the hash
 /// for the string representation of the original MLIR ModuleOp.
 class JITExecutionCache {
 protected:
@@ -27,7 +51,7 @@ protected:
   // the execution engine and to the LRU iterator that is used to track which
   // engine is the least recently used.
   struct MapItemType {
-    ExecutionEngine *execEngine = nullptr;
+    JITEngine *execEngine = nullptr;
     std::list<std::size_t>::iterator lruListIt;
   };
   std::unordered_map<std::size_t, MapItemType> cacheMap;
@@ -38,8 +62,8 @@ public:
   JITExecutionCache() = default;
   ~JITExecutionCache();
 
-  void cache(std::size_t hash, ExecutionEngine *);
+  void cache(std::size_t hash, JITEngine *);
   bool hasJITEngine(std::size_t hash);
-  ExecutionEngine *getJITEngine(std::size_t hash);
+  JITEngine *getJITEngine(std::size_t hash);
 };
 } // namespace cudaq
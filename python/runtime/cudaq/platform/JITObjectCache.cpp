@@ -0,0 +1,213 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+#include "JITObjectCache.h"
+#include "common/Logger.h"
+#include "common/RuntimeMLIR.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Config/llvm-config.h"
+#include "llvm/ExecutionEngine/Orc/CompileUtils.h"
+#include "llvm/ExecutionEngine/Orc/ExecutionUtils.h"
+#include "llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h"
+#include "llvm/ExecutionEngine/Orc/RTDyldObjectLinkingLayer.h"
+#include "llvm/ExecutionEngine/SectionMemoryManager.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/SHA256.h"
+#include "llvm/TargetParser/Host.h"
+#include "mlir/Target/LLVMIR/Export.h"
+#include <cstdlib>
+
+using namespace mlir;
+
+namespace cudaq {
+
+// Bump this whenever the layout of the cached objects or the JIT pass pipeline
+// changes in a way that is not reflected in the cache key.
+static constexpr const char *JIT_OBJECT_CACHE_VERSION = "1";
+
+void JITObjectCache::notifyObjectCompiled(const llvm::Module *,
+                                          llvm::MemoryBufferRef obj) {
+  // Write to a unique temporary file in the same directory and rename it into
+  // place, which is atomic on POSIX file systems.
+  llvm::SmallString<256> tmpPath;
+  int fd = -1;
+  if (auto ec = llvm::sys::fs::createUniqueFile(objectPath + ".%%%%%%.tmp", fd,
+                                                tmpPath)) {
+    cudaq::info("JIT object cache: failed to create {} ({}).", objectPath,
+                ec.message());
+    return;
+  }
+
+  bool writeFailed = false;
+  {
+    llvm::raw_fd_ostream os(fd, /*shouldClose=*/true);
+    os << obj.getBuffer();
+    os.close();
+    writeFailed = os.has_error();
+    os.clear_error();
+  }
+
+  if (writeFailed || llvm::sys::fs::rename(tmpPath, objectPath)) {
+    cudaq::info("JIT object cache: failed to write {}.", objectPath);
+    llvm::sys::fs::remove(tmpPath);
+    return;
+  }
+  cudaq::info("JIT object cache: stored {}.", objectPath);
+}
+
+std::unique_ptr<llvm::MemoryBuffer>
+JITObjectCache::getObject(const llvm::Module *) {
+  auto buffer = llvm::MemoryBuffer::getFile(objectPath);
+  if (!buffer)
+    return nullptr;
+  return std::move(*buffer);
+}
+
+std::optional<std::string> getJITObjectCacheDir() {
+  const char *dir = std::getenv(JIT_OBJECT_CACHE_DIR_ENV);
+  if (!dir || std::string(dir).empty())
+    return std::nullopt;
+
+  if (auto ec = llvm::sys::fs::create_directories(dir)) {
+    cudaq::info("JIT object cache: cannot use directory {} ({}).", dir,
+                ec.message());
+    return std::nullopt;
+  }
+  return std::string(dir);
+}
+
+std::string getJITObjectCachePath(const std::string &cacheDir,
+                                  ModuleOp module,
+                                  const std::vector<std::string> &extraKeys) {
+  std::string moduleStr;
+  {
+    llvm::raw_string_ostream os(moduleStr);
+    module->print(os, OpPrintingFlags().enableDebugInfo(false));
+  }
+
+  llvm::SHA256 hasher;
+  const auto addKey = [&](llvm::StringRef key) {
+    hasher.update(key);
+    // Separate the keys so that adjacent strings cannot alias each other.
+    hasher.update(llvm::StringRef("\0", 1));
+  };
+  addKey(JIT_OBJECT_CACHE_VERSION);
+  addKey(LLVM_VERSION_STRING);
+  addKey(llvm::sys::getProcessTriple());
+  addKey(llvm::sys::getHostCPUName());
+  // The code generation options of `createLLJIT` and
+  // `disableFastInstructionSelection`.
+  addKey(std::to_string(static_cast<int>(JIT_CODEGEN_OPT_LEVEL)));
+  addKey(JIT_FAST_ISEL_OPTION);
+  for (const auto &key : extraKeys)
+    addKey(key);
+  addKey(moduleStr);
+
+  llvm::SmallString<256> path(cacheDir);
+  const auto digest = llvm::toHex(hasher.final(), /*LowerCase=*/true);
+  llvm::sys::path::append(path, digest + ".o");
+  return std::string(path);
+}
+
+/// Create an LLJIT instance configured like `mlir::ExecutionEngine`
+/// (unoptimized code generation, RTDyld linking, process symbols visible) whose
+/// compiler consults `cache`.
+static std::unique_ptr<llvm::orc::LLJIT>
+createLLJIT(llvm::ObjectCache *cache) {
+  auto jtmb = llvm::orc::JITTargetMachineBuilder::detectHost();
+  if (!jtmb) {
+    cudaq::info("JIT object cache: {}", llvm::toString(jtmb.takeError()));
+    return nullptr;
+  }
+
+  auto objectLinkingLayerCreator = [](llvm::orc::ExecutionSession &session,
+                                      const llvm::Triple &) {
+    return std::make_unique<llvm::orc::RTDyldObjectLinkingLayer>(
+        session,
+        []() { return std::make_unique<llvm::SectionMemoryManager>(); });
+  };
+  auto compileFunctionCreator = [cache](llvm::orc::JITTargetMachineBuilder jtmb)
+      -> llvm::Expected<
+          std::unique_ptr<llvm::orc::IRCompileLayer::IRCompiler>> {
+    jtmb.setCodeGenOptLevel(JIT_CODEGEN_OPT_LEVEL);
+    auto tm = jtmb.createTargetMachine();
+    if (!tm)
+      return tm.takeError();
+    return std::make_unique<llvm::orc::TMOwningSimpleCompiler>(std::move(*tm),
+                                                               cache);
+  };
+
+  auto jit = llvm::orc::LLJITBuilder()
+                 .setJITTargetMachineBuilder(std::move(*jtmb))
+                 .setObjectLinkingLayerCreator(objectLinkingLayerCreator)
+                 .setCompileFunctionCreator(compileFunctionCreator)
+                 .create();
+  if (!jit) {
+    cudaq::info("JIT object cache: {}", llvm::toString(jit.takeError()));
+    return nullptr;
+  }
+
+  // Resolve symbols that are statically linked in the current process.
+  auto generator =
+      llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(
+          (*jit)->getDataLayout().getGlobalPrefix());
+  if (!generator) {
+    cudaq::info("JIT object cache: {}", llvm::toString(generator.takeError()));
+    return nullptr;
+  }
+  (*jit)->getMainJITDylib().addGenerator(std::move(*generator));
+  return std::move(*jit);
+}
+
+std::unique_ptr<JITEngine> loadCachedJITEngine(const std::string &objectPath) {
+  auto buffer = llvm::MemoryBuffer::getFile(objectPath);
+  if (!buffer)
+    return nullptr;
+
+  auto jit = createLLJIT(/*cache=*/nullptr);
+  if (!jit)
+    return nullptr;
+  if (auto err = jit->addObjectFile(std::move(*buffer))) {
+    cudaq::info("JIT object cache: ignoring {} ({}).", objectPath,
+                llvm::toString(std::move(err)));
+    return nullptr;
+  }
+  cudaq::info("JIT object cache: loaded {}.", objectPath);
+  return std::make_unique<JITEngine>(std::move(jit));
+}
+
+std::unique_ptr<JITEngine>
+createCachingJITEngine(ModuleOp module, const std::string &objectPath) {
+  auto objectCache = std::make_unique<JITObjectCache>(objectPath);
+  auto jit = createLLJIT(objectCache.get());
+  if (!jit)
+    return nullptr;
+
+  auto llvmContext = std::make_unique<llvm::LLVMContext>();
+  llvmContext->setOpaquePointers(false);
+  auto llvmModule = translateModuleToLLVMIR(module, *llvmContext);
+  if (!llvmModule) {
+    llvm::errs() << "Failed to emit LLVM IR\n";
+    return nullptr;
+  }
+  ExecutionEngine::setupTargetTriple(llvmModule.get());
+  llvmModule->setDataLayout(jit->getDataLayout());
+
+  // Code generation is deferred until the first symbol lookup, at which point
+  // the whole module is compiled and handed to the object cache.
+  llvm::orc::ThreadSafeModule tsm(std::move(llvmModule),
+                                  std::move(llvmContext));
+  if (auto err = jit->addIRModule(std::move(tsm))) {
+    cudaq::info("JIT object cache: {}", llvm::toString(std::move(err)));
+    return nullptr;
+  }
+  return std::make_unique<JITEngine>(std::move(jit), std::move(objectCache));
+}
+} // namespace cudaq
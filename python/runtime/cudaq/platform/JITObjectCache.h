@@ -0,0 +1,61 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+#pragma once
+
+#include "JITExecutionCache.h"
+#include "mlir/IR/BuiltinOps.h"
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace cudaq {
+
+/// @brief Environment variable that opts into the persistent JIT object cache.
+/// When set, it names the directory in which compiled kernel objects are
+/// stored and reused across processes.
+static constexpr const char *JIT_OBJECT_CACHE_DIR_ENV = "CUDAQ_JIT_CACHE_DIR";
+
+/// @brief An `llvm::ObjectCache` that persists the relocatable object of a
+/// single JIT module at a fixed, content-addressed path on disk. Objects are
+/// written atomically, so concurrent processes sharing the cache directory
+/// never observe a partially written file.
+class JITObjectCache : public llvm::ObjectCache {
+protected:
+  std::string objectPath;
+
+public:
+  explicit JITObjectCache(std::string path) : objectPath(std::move(path)) {}
+
+  void notifyObjectCompiled(const llvm::Module *,
+                            llvm::MemoryBufferRef obj) override;
+  std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module *) override;
+};
+
+/// @brief Return the persistent JIT object cache directory, or `std::nullopt`
+/// if the cache is not enabled. The directory is created if needed.
+std::optional<std::string> getJITObjectCacheDir();
+
+/// @brief Compute the on-disk path of the object for the given module. The key
+/// is a SHA-256 digest of the textual module, the `extraKeys` (kernel name,
+/// target, pass pipeline) and the host/LLVM and code generation
+/// configuration. Unlike `OperationEquivalence::computeHash`, it is stable
+/// across processes.
+std::string getJITObjectCachePath(const std::string &cacheDir,
+                                  mlir::ModuleOp module,
+                                  const std::vector<std::string> &extraKeys);
+
+/// @brief Load a previously cached object into a new JIT engine, skipping
+/// all MLIR passes and LLVM code generation. Returns `nullptr` if no usable
+/// object exists at `objectPath`.
+std::unique_ptr<JITEngine> loadCachedJITEngine(const std::string &objectPath);
+
+/// @brief Compile an LLVM dialect module into a new JIT engine whose code
+/// generator stores the resulting object at `objectPath`.
+std::unique_ptr<JITEngine>
+createCachingJITEngine(mlir::ModuleOp module, const std::string &objectPath);
+} // namespace cudaq
@@ -7,10 +7,12 @@
  ******************************************************************************/
 
 #include "JITExecutionCache.h"
+#include "JITObjectCache.h"
 #include "common/AnalogHamiltonian.h"
 #include "common/ArgumentConversion.h"
 #include "common/ArgumentWrapper.h"
 #include "common/Environment.h"
+#include "common/RuntimeMLIR.h"
 #include "cudaq/Optimizer/Builder/Factory.h"
 #include "cudaq/Optimizer/Builder/Runtime.h"
 #include "cudaq/Optimizer/CAPI/Dialects.h"
@@ -66,7 +68,21 @@ static std::unique_ptr<PyStateVectorStorage> stateStorage =
 static std::unique_ptr<PyStateStorage> cudaqStateStorage =
     std::make_unique<PyStateStorage>();
 
-std::tuple<ExecutionEngine *, void *, std::size_t, std::int32_t>
+/// Add the passes that lower a kernel module to QIR for JIT execution.
+static void addJITPipeline(PassManager &pm,
+                           const std::vector<std::string> &names,
+                           std::size_t startingArgIdx) {
+  pm.addNestedPass<func::FuncOp>(cudaq::opt::createPySynthCallableBlockArgs(
+      SmallVector<StringRef>(names.begin(), names.end())));
+  pm.addPass(cudaq::opt::createGenerateDeviceCodeLoader({.jitTime = true}));
+  pm.addPass(cudaq::opt::createGenerateKernelExecution(
+      {.startingArgIdx = startingArgIdx}));
+  pm.addPass(cudaq::opt::createLambdaLiftingPass());
+  pm.addPass(createSymbolDCEPass());
+  cudaq::opt::addPipelineConvertToQIR(pm);
+}
+
+std::tuple<JITEngine *, void *, std::size_t, std::int32_t>
 jitAndCreateArgs(const std::string &name, MlirModule module,
                  cudaq::OpaqueArguments &runtimeArgs,
                  const std::vector<std::string> &names, Type returnType,
@@ -87,9 +103,32 @@ jitAndCreateArgs(const std::string &name, MlirModule module,
   });
   auto hashKey = static_cast<size_t>(hash);
 
-  ExecutionEngine *jit = nullptr;
+  // The opt-in persistent object cache is keyed on a content hash that is
+  // stable across processes, so that a warm start can skip the passes below as
+  // well as LLVM code generation. The key includes the textual pass pipeline,
+  // with the options of each pass, so that a change to the lowering does not
+  // reuse a stale object.
+  std::optional<std::string> objectCachePath;
+  if (allowCache && !jitCache->hasJITEngine(hashKey))
+    if (auto cacheDir = getJITObjectCacheDir()) {
+      std::vector<std::string> keys{name, cudaq::get_platform().name()};
+      keys.insert(keys.end(), names.begin(), names.end());
+      PassManager pm(mod.getContext());
+      addJITPipeline(pm, names, startingArgIdx);
+      llvm::raw_string_ostream os(keys.emplace_back());
+      pm.printAsTextualPipeline(os);
+      os.flush();
+      objectCachePath = getJITObjectCachePath(*cacheDir, mod, keys);
+    }
+
+  JITEngine *jit = nullptr;
   if (allowCache && jitCache->hasJITEngine(hashKey)) {
     jit = jitCache->getJITEngine(hashKey);
+  } else if (auto cachedJit = objectCachePath
+                                  ? loadCachedJITEngine(*objectCachePath)
+                                  : nullptr) {
+    jit = cachedJit.release();
+    jitCache->cache(hashKey, jit);
   } else {
     ScopedTraceWithContext(cudaq::TIMING_JIT,
                            "jitAndCreateArgs - execute passes", name);
@@ -97,14 +136,7 @@ jitAndCreateArgs(const std::string &name, MlirModule module,
     auto cloned = mod.clone();
     auto context = cloned.getContext();
     PassManager pm(context);
-    pm.addNestedPass<func::FuncOp>(cudaq::opt::createPySynthCallableBlockArgs(
-        SmallVector<StringRef>(names.begin(), names.end())));
-    pm.addPass(cudaq::opt::createGenerateDeviceCodeLoader({.jitTime = true}));
-    pm.addPass(cudaq::opt::createGenerateKernelExecution(
-        {.startingArgIdx = startingArgIdx}));
-    pm.addPass(cudaq::opt::createLambdaLiftingPass());
-    pm.addPass(createSymbolDCEPass());
-    cudaq::opt::addPipelineConvertToQIR(pm);
+    addJITPipeline(pm, names, startingArgIdx);
 
     auto enablePrintMLIREachPass =
         getEnvBool("CUDAQ_MLIR_PRINT_EACH_PASS", false);
@@ -123,21 +155,13 @@ jitAndCreateArgs(const std::string &name, MlirModule module,
           "cudaq::builder failed to JIT compile the Quake representation.");
     timingScope.stop();
 
-    // The "fast" instruction selection compilation algorithm is actually very
-    // slow for large quantum circuits. Disable that here. Revisit this
-    // decision by testing large UCCSD circuits if jitCodeGenOptLevel is changed
-    // in the future. Also note that llvm::TargetMachine::setFastIsel() and
-    // setO0WantsFastISel() do not retain their values in our current version of
-    // LLVM. This use of LLVM command line parameters could be changed if the
-    // LLVM JIT ever supports the TargetMachine options in the future.
-    const char *argv[] = {"", "-fast-isel=0", nullptr};
-    llvm::cl::ParseCommandLineOptions(2, argv);
+    disableFastInstructionSelection();
 
     ExecutionEngineOptions opts;
     opts.enableGDBNotificationListener = false;
     opts.enablePerfNotificationListener = false;
     opts.transformer = [](llvm::Module *m) { return llvm::ErrorSuccess(); };
-    opts.jitCodeGenOptLevel = llvm::CodeGenOpt::None;
+    opts.jitCodeGenOptLevel = cudaq::JIT_CODEGEN_OPT_LEVEL;
     SmallVector<StringRef, 4> sharedLibs;
     opts.llvmModuleBuilder =
         [](Operation *module,
@@ -152,10 +176,15 @@ jitAndCreateArgs(const std::string &name, MlirModule module,
       return llvmModule;
     };
 
-    auto jitOrError = ExecutionEngine::create(cloned, opts);
-    assert(!!jitOrError);
+    std::unique_ptr<JITEngine> uniqueJit;
+    if (objectCachePath)
+      uniqueJit = createCachingJITEngine(cloned, *objectCachePath);
+    if (!uniqueJit) {
+      auto jitOrError = ExecutionEngine::create(cloned, opts);
+      assert(!!jitOrError);
+      uniqueJit = std::make_unique<JITEngine>(std::move(jitOrError.get()));
+    }
 
-    auto uniqueJit = std::move(jitOrError.get());
     jit = uniqueJit.release();
     if (allowCache)
       jitCache->cache(hashKey, jit);
@@ -100,6 +100,45 @@ def test_stim_state_preparation_builder():
         cudaq.sample(kernel, state)
 
 
+def test_stim_sample_in_batches(monkeypatch):
+    # Force the shots to be split across several (partial) batches.
+    monkeypatch.setenv("CUDAQ_STIM_MAX_BATCH_SIZE", "1000")
+
+    @cudaq.kernel
+    def kernel():
+        qubits = cudaq.qvector(20)
+        h(qubits[0])
+        for i in range(1, 20):
+            cx(qubits[i - 1], qubits[i])
+        mz(qubits)
+
+    shots = 10500
+    counts = cudaq.sample(kernel, shots_count=shots)
+    assert len(counts) == 2
+    assert counts.count('0' * 20) + counts.count('1' * 20) == shots
+    assert len(counts.get_sequential_data()) == shots
+    # Each batch is seeded differently, so the outcomes are not correlated.
+    assert 4500 < counts.count('0' * 20) < 6000
+
+
+def test_stim_noisy_sample_in_batches(monkeypatch):
+    monkeypatch.setenv("CUDAQ_STIM_MAX_BATCH_SIZE", "1000")
+
+    noise = cudaq.NoiseModel()
+    noise.add_channel('x', [0], cudaq.BitFlipChannel(0.25))
+
+    @cudaq.kernel
+    def kernel():
+        q = cudaq.qubit()
+        x(q)
+        mz(q)
+
+    shots = 10500
+    counts = cudaq.sample(kernel, shots_count=shots, noise_model=noise)
+    assert counts.count('0') + counts.count('1') == shots
+    assert 2000 < counts.count('0') < 3250
+
+
 # leave for gdb debugging
 if __name__ == "__main__":
     loc = os.path.abspath(__file__)
@@ -0,0 +1,69 @@
+# ============================================================================ #
+# Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                   #
+# All rights reserved.                                                         #
+#                                                                              #
+# This source code and the accompanying materials are made available under     #
+# the terms of the Apache License 2.0 which accompanies this distribution.     #
+# ============================================================================ #
+
+import os
+import subprocess
+import sys
+import textwrap
+
+import pytest
+
+kernel_script = textwrap.dedent("""
+    import cudaq
+
+    @cudaq.kernel
+    def ghz(n: int):
+        q = cudaq.qvector(n)
+        h(q[0])
+        for i in range(n - 1):
+            x.ctrl(q[i], q[i + 1])
+        mz(q)
+
+    counts = cudaq.sample(ghz, 3, shots_count=100)
+    print(sorted(counts.keys()))
+    """)
+
+
+def run_kernel_script(cache_dir, log_file):
+    """Run the script in a new process and return its last line of output and
+    its log."""
+    env = dict(os.environ,
+               CUDAQ_JIT_CACHE_DIR=str(cache_dir),
+               CUDAQ_LOG_LEVEL="info",
+               CUDAQ_LOG_FILE=str(log_file))
+    result = subprocess.run([sys.executable, "-c", kernel_script],
+                            env=env,
+                            capture_output=True,
+                            text=True,
+                            check=True)
+    return result.stdout.strip().splitlines()[-1], log_file.read_text()
+
+
+def test_persistent_jit_object_cache(tmp_path):
+    """Test that a second process reuses the object compiled by the first."""
+    cache_dir = tmp_path / "jit_cache"
+
+    cold, cold_log = run_kernel_script(cache_dir, tmp_path / "cold.log")
+    objects = sorted(p.name for p in cache_dir.glob("*.o"))
+    assert len(objects) > 0
+    assert not list(cache_dir.glob("*.tmp"))
+    assert "JIT object cache: stored" in cold_log
+    assert "JIT object cache: loaded" not in cold_log
+
+    warm, warm_log = run_kernel_script(cache_dir, tmp_path / "warm.log")
+    assert warm == cold == "['000', '111']"
+    assert sorted(p.name for p in cache_dir.glob("*.o")) == objects
+    # The warm run loaded the object instead of compiling the kernel again.
+    assert "JIT object cache: loaded" in warm_log
+    assert "JIT object cache: stored" not in warm_log
+
+
+# leave for gdb debugging
+if __name__ == "__main__":
+    loc = os.path.abspath(__file__)
+    pytest.main([loc, "-rP"])
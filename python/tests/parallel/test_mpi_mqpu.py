@@ -48,6 +48,14 @@ def check_mpi(entity):
     expectation_value_no_shots = result_no_shots.expectation()
     assert np.isclose(want_expectation_value, expectation_value_no_shots)
 
+    # Every rank gets the results of all the terms, not only of its own terms.
+    reference = cudaq.observe(entity, hamiltonian, 0.59)
+    for term in hamiltonian:
+        if term.is_identity():
+            continue
+        assert np.isclose(result_no_shots.expectation(term),
+                          reference.expectation(term))
+
     # Test all gather
     numRanks = cudaq.mpi.num_ranks()
     local = [1.0]
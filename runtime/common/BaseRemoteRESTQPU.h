@@ -9,13 +9,17 @@
 #pragma once
 
 #include "common/ArgumentConversion.h"
+#include "common/CompiledJobCache.h"
 #include "common/Environment.h"
 #include "common/ExecutionContext.h"
 #include "common/Executor.h"
 #include "common/FmtCore.h"
+#include "common/JobPoller.h"
 #include "common/Logger.h"
+#include "common/MeasurementGrouping.h"
 #include "common/RestClient.h"
 #include "common/RuntimeMLIR.h"
+#include "common/Timing.h"
 #include "cudaq.h"
 #include "cudaq/Frontend/nvqpp/AttributeNames.h"
 #include "cudaq/Optimizer/Builder/Intrinsics.h"
@@ -46,13 +50,16 @@
 #include "mlir/ExecutionEngine/ExecutionEngine.h"
 #include "mlir/ExecutionEngine/OptUtils.h"
 #include "mlir/IR/ImplicitLocOpBuilder.h"
+#include "mlir/IR/Threading.h"
 #include "mlir/Parser/Parser.h"
 #include "mlir/Pass/PassManager.h"
 #include "mlir/Pass/PassRegistry.h"
 #include "mlir/Tools/mlir-translate/Translation.h"
 #include "mlir/Transforms/Passes.h"
+#include <exception>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 #include <netinet/in.h>
 #include <regex>
 #include <sys/socket.h>
@@ -116,7 +123,27 @@ protected:
 
   /// @brief If we are emulating locally, keep track
   /// of JIT engines for invoking the kernels.
-  std::vector<mlir::ExecutionEngine *> jitEngines;
+  std::vector<std::shared_ptr<mlir::ExecutionEngine>> jitEngines;
+
+  /// @brief Output of `lowerQuakeCode`, kept in the compiled job cache.
+  struct CompiledJob {
+    std::vector<cudaq::KernelExecution> codes;
+    /// @brief The qubit mapping reordering of `sample` results.
+    std::vector<std::size_t> reorderIdx;
+    /// @brief The JIT engines of the codes when emulating.
+    std::vector<std::shared_ptr<mlir::ExecutionEngine>> jitEngines;
+  };
+
+  /// @brief Process-wide cache of compiled jobs, shared by all the instances.
+  /// Resubmitting a kernel whose IR after argument synthesis, target and
+  /// observable are unchanged skips the lowering pipeline.
+  static cudaq::CompiledJobCache<CompiledJob> &getCompiledJobCache() {
+    // Intentionally leaked, so that the cached JIT engines are not destroyed
+    // during static destruction, possibly after the simulator.
+    static auto *cache = new cudaq::CompiledJobCache<CompiledJob>(
+        cudaq::getCompiledJobCacheCapacity());
+    return *cache;
+  }
 
   /// @brief Invoke the kernel in the JIT engine
   void invokeJITKernel(mlir::ExecutionEngine *jit,
@@ -130,17 +157,47 @@ protected:
     reinterpret_cast<void (*)()>(*funcPtr)();
   }
 
-  /// @brief Invoke the kernel in the JIT engine and then delete the JIT engine.
-  void invokeJITKernelAndRelease(mlir::ExecutionEngine *jit,
+  /// @brief Invoke the kernel in the JIT engine and then release the JIT
+  /// engine. It is deleted unless the compiled job cache still holds it.
+  void invokeJITKernelAndRelease(std::shared_ptr<mlir::ExecutionEngine> &jit,
                                  const std::string &kernelName) {
-    invokeJITKernel(jit, kernelName);
-    delete jit;
+    invokeJITKernel(jit.get(), kernelName);
+    jit.reset();
   }
 
   virtual std::tuple<mlir::ModuleOp, mlir::MLIRContext *, void *>
   extractQuakeCodeAndContext(const std::string &kernelName, void *data) = 0;
   virtual void cleanupContext(mlir::MLIRContext *context) { return; }
 
+  /// @brief Run `task(i)` for every `i` in `[0, n)`. The tasks run concurrently
+  /// on the thread pool of \p context, unless the IR, the pass statistics or
+  /// the pass timings are printed, since their output would interleave. The
+  /// first exception thrown by a task is rethrown once all of them completed.
+  template <typename Task>
+  void runLoweringTasks(mlir::MLIRContext &context, std::size_t n,
+                        Task &&task) {
+    std::mutex errorMutex;
+    std::exception_ptr error;
+    const auto runTask = [&](std::size_t i) {
+      try {
+        task(i);
+      } catch (...) {
+        std::scoped_lock lock(errorMutex);
+        if (!error)
+          error = std::current_exception();
+      }
+    };
+    if (printIR || enablePrintMLIREachPass || enablePassStatistics ||
+        cudaq::isTimingTagEnabled(cudaq::TIMING_JIT_PASSES)) {
+      for (std::size_t i = 0; i < n; ++i)
+        runTask(i);
+    } else {
+      mlir::parallelFor(&context, 0, n, runTask);
+    }
+    if (error)
+      std::rethrow_exception(error);
+  }
+
 public:
   /// @brief The constructor
   BaseRemoteRESTQPU() : QPU() {
@@ -149,7 +206,18 @@ public:
   }
 
   BaseRemoteRESTQPU(BaseRemoteRESTQPU &&) = delete;
-  virtual ~BaseRemoteRESTQPU() = default;
+
+  /// @brief Return the hit and miss counts of the compiled job cache.
+  static cudaq::CompiledJobCacheStatistics getCompiledJobCacheStatistics() {
+    return getCompiledJobCache().statistics();
+  }
+
+  /// @brief The destructor. Stops polling the jobs submitted to the server,
+  /// rather than leaving the poller threads to static destruction.
+  virtual ~BaseRemoteRESTQPU() {
+    if (serverHelper)
+      JobPoller::shutdown(serverHelper->name());
+  }
 
   void enqueue(cudaq::QuantumTask &task) override {
     execution_queue->enqueue(task);
@@ -401,6 +469,8 @@ public:
   std::vector<cudaq::KernelExecution>
   lowerQuakeCode(const std::string &kernelName, void *kernelArgs,
                  const std::vector<void *> &rawArgs) {
+    ScopedTraceWithContext(cudaq::TIMING_JIT,
+                           "BaseRemoteRESTQPU::lowerQuakeCode", kernelName);
 
     auto [m_module, contextPtr, updatedArgs] =
         extractQuakeCodeAndContext(kernelName, kernelArgs);
@@ -431,6 +501,11 @@ public:
         moduleOp.push_back(globalOp.clone());
     }
 
+    // Disable the multithreading of the context up front, since it cannot be
+    // changed while passes run concurrently on the modules of the terms.
+    if (disableMLIRthreading || enablePrintMLIREachPass)
+      context.disableMultithreading();
+
     // Lambda to apply a specific pipeline to the given ModuleOp
     auto runPassPipeline = [&](const std::string &pipeline,
                                mlir::ModuleOp moduleOpIn) {
@@ -442,8 +517,6 @@ public:
         throw std::runtime_error(
             "Remote rest platform failed to add passes to pipeline (" + errMsg +
             ").");
-      if (disableMLIRthreading || enablePrintMLIREachPass)
-        moduleOpIn.getContext()->disableMultithreading();
       if (enablePrintMLIREachPass)
         pm.enableIRPrinting();
       if (failed(pm.run(moduleOpIn)))
@@ -489,8 +562,6 @@ public:
         pm.addPass(cudaq::opt::createQuakeSynthesizer(kernelName, updatedArgs));
       }
       pm.addPass(mlir::createCanonicalizerPass());
-      if (disableMLIRthreading || enablePrintMLIREachPass)
-        moduleOp.getContext()->disableMultithreading();
       if (enablePrintMLIREachPass)
         pm.enableIRPrinting();
       if (failed(pm.run(moduleOp)))
@@ -511,6 +582,46 @@ public:
                   passPipelineConfig);
     }
 
+    // Everything the lowering below depends on: the target, the requested
+    // measurements and the kernel IR after argument synthesis.
+    auto &jobCache = getCompiledJobCache();
+    std::string jobKey;
+    if (jobCache.enabled() && !printIR && !enablePrintMLIREachPass &&
+        !enablePassStatistics) {
+      llvm::raw_string_ostream os(jobKey);
+      os << qpuName << '\n'
+         << codegenTranslation << '\n'
+         << passPipelineConfig << '\n'
+         << postCodeGenPasses << '\n'
+         << emulate << '\n';
+      if (executionContext) {
+        os << executionContext->name << '\n';
+        if (executionContext->name == "observe") {
+          os << static_cast<int>(cudaq::getMeasurementGrouping()) << '\n';
+          for (const auto &term : executionContext->spin.value())
+            os << term.get_term_id() << ';';
+          os << '\n';
+        }
+      }
+      moduleOp.print(os);
+    }
+    if (!jobKey.empty()) {
+      if (auto job = jobCache.get(jobKey)) {
+        cudaq::info("Reusing the compiled job of {} ({} hits, {} misses).",
+                    kernelName, jobCache.hits(), jobCache.misses());
+        if (executionContext) {
+          if (executionContext->name == "sample")
+            executionContext->reorderIdx = job->reorderIdx;
+          else
+            executionContext->reorderIdx.clear();
+        }
+        jitEngines = job->jitEngines;
+        cleanupContext(contextPtr);
+        return job->codes;
+      }
+    }
+    CompiledJob compiledJob;
+
     runPassPipeline(passPipelineConfig, moduleOp);
 
     auto entryPointFunc = moduleOp.lookupSymbol<mlir::func::FuncOp>(
@@ -525,6 +636,7 @@ public:
                      });
     }
 
+    compiledJob.reorderIdx = mapping_reorder_idx;
     if (executionContext) {
       if (executionContext->name == "sample")
         executionContext->reorderIdx = mapping_reorder_idx;
@@ -533,59 +645,100 @@ public:
     }
 
     std::vector<std::pair<std::string, mlir::ModuleOp>> modules;
+    // Name of each code to execute and the index of its module in `modules`.
+    std::vector<std::pair<std::string, std::size_t>> outputs;
     // Apply observations if necessary
     if (executionContext && executionContext->name == "observe") {
       mapping_reorder_idx.clear();
       runPassPipeline("canonicalize,cse", moduleOp);
       cudaq::spin_op &spin = executionContext->spin.value();
-      for (const auto &term : spin) {
-        if (term.is_identity())
-          continue;
+      // Circuits to build, named after the register of their results. Groups
+      // of qubit-wise commuting terms share a circuit, the term results are
+      // recovered from the group register when the results are processed.
+      std::vector<std::pair<std::string, cudaq::spin_op_term>> measurements;
+      if (cudaq::getMeasurementGrouping() != cudaq::MeasurementGrouping::none) {
+        for (auto &group : cudaq::groupMeasurements(
+                 spin, cudaq::MeasurementGrouping::qubit_wise))
+          measurements.emplace_back(group.name, *group.basis);
+      } else {
+        for (const auto &term : spin)
+          if (!term.is_identity())
+            measurements.emplace_back(term.get_term_id(), term);
+      }
 
-        // Get the ansatz
-        [[maybe_unused]] auto ansatz =
-            moduleOp.lookupSymbol<mlir::func::FuncOp>(
-                cudaq::runtime::cudaqGenPrefixName + kernelName);
-        assert(ansatz && "could not find the ansatz kernel");
+      // Measurements with the same basis produce the same circuit, which is
+      // only lowered once. `circuitIds` maps each measurement to its circuit.
+      std::vector<cudaq::spin_op_term> bases;
+      std::vector<std::size_t> circuitIds;
+      std::unordered_map<std::string, std::size_t> basisIds;
+      for (const auto &[name, term] : measurements) {
+        auto [iter, inserted] =
+            basisIds.try_emplace(term.get_term_id(), bases.size());
+        if (inserted)
+          bases.push_back(term);
+        circuitIds.push_back(iter->second);
+      }
 
+      // Get the ansatz
+      [[maybe_unused]] auto ansatz = moduleOp.lookupSymbol<mlir::func::FuncOp>(
+          cudaq::runtime::cudaqGenPrefixName + kernelName);
+      assert(ansatz && "could not find the ansatz kernel");
+
+      // The full pass pipeline was run above, but the ansatz pass can
+      // introduce gates that aren't supported by the backend, so we need to
+      // re-run the gate set mapping if that existed in the original pass
+      // pipeline.
+      std::vector<std::string> gateSetMappings;
+      for (auto &pass : cudaq::split(passPipelineConfig, ','))
+        if (pass.ends_with("-gate-set-mapping"))
+          gateSetMappings.push_back(pass);
+
+      ScopedTraceWithContext(cudaq::TIMING_JIT,
+                             "BaseRemoteRESTQPU::lowerObserveTerms",
+                             bases.size(), measurements.size());
+      // The circuits are independent, so they are lowered concurrently on the
+      // thread pool of the context (sequentially if its multithreading is
+      // disabled or the IR is printed).
+      std::vector<mlir::ModuleOp> circuits(bases.size());
+      runLoweringTasks(context, bases.size(), [&](std::size_t i) {
         // Create a new Module to clone the ansatz into it
         auto tmpModuleOp = moduleOp.clone();
 
-        // Create the pass manager, add the quake observe ansatz pass and run it
-        // followed by the canonicalizer
+        // Create the pass manager, add the quake observe ansatz pass and run
+        // it followed by the canonicalizer
         mlir::PassManager pm(&context);
         pm.addNestedPass<mlir::func::FuncOp>(
             cudaq::opt::createObserveAnsatzPass(
-                term.get_binary_symplectic_form()));
-        if (disableMLIRthreading || enablePrintMLIREachPass)
-          tmpModuleOp.getContext()->disableMultithreading();
+                bases[i].get_binary_symplectic_form()));
         if (enablePrintMLIREachPass)
           pm.enableIRPrinting();
         if (failed(pm.run(tmpModuleOp)))
           throw std::runtime_error("Could not apply measurements to ansatz.");
-        // The full pass pipeline was run above, but the ansatz pass can
-        // introduce gates that aren't supported by the backend, so we need to
-        // re-run the gate set mapping if that existed in the original pass
-        // pipeline.
-        auto csvSplit = cudaq::split(passPipelineConfig, ',');
-        for (auto &pass : csvSplit)
-          if (pass.ends_with("-gate-set-mapping"))
-            runPassPipeline(pass, tmpModuleOp);
+        for (auto &pass : gateSetMappings)
+          runPassPipeline(pass, tmpModuleOp);
         if (!emulate && combineMeasurements)
           runPassPipeline("func.func(combine-measurements)", tmpModuleOp);
-        modules.emplace_back(term.get_term_id(), tmpModuleOp);
-      }
-    } else
+        circuits[i] = tmpModuleOp;
+      });
+
+      for (std::size_t i = 0; i < bases.size(); ++i)
+        modules.emplace_back(bases[i].get_term_id(), circuits[i]);
+      for (std::size_t i = 0; i < measurements.size(); ++i)
+        outputs.emplace_back(measurements[i].first, circuitIds[i]);
+    } else {
       modules.emplace_back(kernelName, moduleOp);
+      outputs.emplace_back(kernelName, 0);
+    }
 
     if (emulate) {
       // If we are in emulation mode, we need to first get a full QIR
       // representation of the code. Then we'll map to an LLVM Module, create a
       // JIT ExecutionEngine pointer and use that for execution
-      for (auto &[name, module] : modules) {
-        auto clonedModule = module.clone();
+      for (auto &[name, moduleIdx] : outputs) {
+        auto clonedModule = modules[moduleIdx].second.clone();
         jitEngines.emplace_back(
             cudaq::createQIRJITEngine(clonedModule, codegenTranslation));
+        compiledJob.jitEngines.push_back(jitEngines.back());
       }
     }
 
@@ -596,14 +749,14 @@ public:
     // Get the code gen translation
     auto translation = cudaq::getTranslation(codegenTranslation);
 
-    // Apply user-specified codegen
-    std::vector<cudaq::KernelExecution> codes;
-    for (auto &[name, moduleOpI] : modules) {
-      std::string codeStr;
+    // Apply user-specified codegen. The modules are translated concurrently,
+    // unless the output of the translation is printed.
+    std::vector<std::string> codeStrs(modules.size());
+    std::vector<nlohmann::json> outputNames(modules.size());
+    runLoweringTasks(context, modules.size(), [&](std::size_t i) {
+      auto moduleOpI = modules[i].second;
       {
-        llvm::raw_string_ostream outStr(codeStr);
-        if (disableMLIRthreading)
-          moduleOpI.getContext()->disableMultithreading();
+        llvm::raw_string_ostream outStr(codeStrs[i]);
         if (failed(translation(moduleOpI, outStr, postCodeGenPasses, printIR,
                                enablePrintMLIREachPass, enablePassStatistics)))
           throw std::runtime_error("Could not successfully translate to " +
@@ -611,10 +764,18 @@ public:
       }
 
       // Form an output_names mapping from codeStr
-      nlohmann::json j =
-          formOutputNames(codegenTranslation, moduleOpI, codeStr);
+      outputNames[i] =
+          formOutputNames(codegenTranslation, moduleOpI, codeStrs[i]);
+    });
+
+    std::vector<cudaq::KernelExecution> codes;
+    for (auto &[name, moduleIdx] : outputs)
+      codes.emplace_back(name, codeStrs[moduleIdx], outputNames[moduleIdx],
+                         mapping_reorder_idx);
 
-      codes.emplace_back(name, codeStr, j, mapping_reorder_idx);
+    if (!jobKey.empty()) {
+      compiledJob.codes = codes;
+      jobCache.put(jobKey, std::move(compiledJob));
     }
 
     cleanupContext(contextPtr);
@@ -726,7 +887,7 @@ public:
                   cudaq::ExecutionContext context("sample", 1);
                   context.hasConditionalsOnMeasureResults = true;
                   cudaq::getExecutionManager()->setExecutionContext(&context);
-                  invokeJITKernel(localJIT[0], kernelName);
+                  invokeJITKernel(localJIT[0].get(), kernelName);
                   cudaq::getExecutionManager()->resetExecutionContext();
                   counts += context.result;
                 }
@@ -0,0 +1,145 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdlib>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace cudaq {
+
+/// @brief Environment variable setting the number of compiled jobs kept by the
+/// remote QPUs. Setting it to 0 disables the cache.
+static constexpr const char *COMPILED_JOB_CACHE_SIZE_ENV =
+    "CUDAQ_COMPILED_JOB_CACHE_SIZE";
+
+/// @brief Capacity of the compiled job caches, read from
+/// `CUDAQ_COMPILED_JOB_CACHE_SIZE`.
+inline std::size_t getCompiledJobCacheCapacity() {
+  constexpr std::size_t defaultCapacity = 64;
+  const char *envVal = std::getenv(COMPILED_JOB_CACHE_SIZE_ENV);
+  if (!envVal)
+    return defaultCapacity;
+  char *end = nullptr;
+  const long long value = std::strtoll(envVal, &end, 10);
+  if (end == envVal || *end != '\0' || value < 0)
+    return defaultCapacity;
+  return static_cast<std::size_t>(value);
+}
+
+/// @brief Numbers of lookups that found, or did not find, a compiled job.
+struct CompiledJobCacheStatistics {
+  std::size_t hits = 0;
+  std::size_t misses = 0;
+};
+
+/// @brief Return the statistics of the compiled job cache shared by the remote
+/// REST QPUs. Defined in the `cudaq-rest-qpu` library.
+CompiledJobCacheStatistics getCompiledJobCacheStatistics();
+
+/// @brief Thread-safe, least-recently-used cache of compiled jobs. A key
+/// identifies everything the compilation depends on, typically the kernel IR
+/// after argument synthesis and the target configuration, and the entry holds
+/// the compilation output. Once the cache holds `capacity` entries, inserting
+/// a new one evicts the least recently used entry.
+template <typename Entry>
+class CompiledJobCache {
+public:
+  explicit CompiledJobCache(std::size_t capacity) : capacity(capacity) {}
+
+  /// @brief Return the entry of \p key, if any, and mark it as the most
+  /// recently used one. Updates the hit and miss counters.
+  std::optional<Entry> get(const std::string &key) {
+    std::scoped_lock lock(mutex);
+    auto iter = index.find(key);
+    if (iter == index.end()) {
+      ++numMisses;
+      return std::nullopt;
+    }
+    ++numHits;
+    entries.splice(entries.begin(), entries, iter->second);
+    return iter->second->second;
+  }
+
+  /// @brief Insert or replace the entry of \p key.
+  void put(const std::string &key, Entry entry) {
+    std::scoped_lock lock(mutex);
+    if (capacity == 0)
+      return;
+    auto iter = index.find(key);
+    if (iter != index.end()) {
+      iter->second->second = std::move(entry);
+      entries.splice(entries.begin(), entries, iter->second);
+      return;
+    }
+    entries.emplace_front(key, std::move(entry));
+    index.emplace(key, entries.begin());
+    evict();
+  }
+
+  /// @brief Change the maximum number of entries, evicting the least recently
+  /// used entries if needed. A capacity of 0 disables the cache.
+  void setCapacity(std::size_t newCapacity) {
+    std::scoped_lock lock(mutex);
+    capacity = newCapacity;
+    evict();
+  }
+
+  /// @brief Remove all the entries and reset the counters.
+  void clear() {
+    std::scoped_lock lock(mutex);
+    entries.clear();
+    index.clear();
+    numHits = 0;
+    numMisses = 0;
+  }
+
+  bool enabled() const {
+    std::scoped_lock lock(mutex);
+    return capacity > 0;
+  }
+  std::size_t size() const {
+    std::scoped_lock lock(mutex);
+    return entries.size();
+  }
+  std::size_t hits() const {
+    std::scoped_lock lock(mutex);
+    return numHits;
+  }
+  std::size_t misses() const {
+    std::scoped_lock lock(mutex);
+    return numMisses;
+  }
+  CompiledJobCacheStatistics statistics() const {
+    std::scoped_lock lock(mutex);
+    return {numHits, numMisses};
+  }
+
+private:
+  void evict() {
+    while (entries.size() > capacity) {
+      index.erase(entries.back().first);
+      entries.pop_back();
+    }
+  }
+
+  mutable std::mutex mutex;
+  std::size_t capacity;
+  std::size_t numHits = 0;
+  std::size_t numMisses = 0;
+  using EntryList = std::list<std::pair<std::string, Entry>>;
+  /// Entries from the most to the least recently used one.
+  EntryList entries;
+  std::unordered_map<std::string, typename EntryList::iterator> index;
+};
+
+} // namespace cudaq
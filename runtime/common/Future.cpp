@@ -7,11 +7,10 @@
  ******************************************************************************/
 
 #include "Future.h"
+#include "JobPoller.h"
 #include "Logger.h"
 #include "ObserveResult.h"
-#include "RestClient.h"
 #include "ServerHelper.h"
-#include <thread>
 
 namespace cudaq::details {
 
@@ -20,25 +19,21 @@ sample_result future::get() {
     return inFuture.get();
 
 #ifdef CUDAQ_RESTCLIENT_AVAILABLE
-  RestClient client;
   auto serverHelper = registry::get<ServerHelper>(qpuName);
   serverHelper->initialize(serverConfig);
-  auto headers = serverHelper->getHeaders();
 
-  std::vector<ExecutionResult> results;
+  // The jobs are tracked concurrently by the background poller of the server,
+  // their results are processed in order as they complete.
+  auto &poller = JobPoller::get(qpuName, serverConfig);
+  std::vector<std::future<ServerMessage>> responses;
   for (auto &id : jobs) {
     cudaq::info("Future retrieving results for {}.", id.first);
+    responses.push_back(poller.watch(id.first));
+  }
 
-    auto jobGetPath = serverHelper->constructGetJobPath(id.first);
-
-    cudaq::info("Future got job retrieval path as {}.", jobGetPath);
-    auto resultResponse = client.get(jobGetPath, "", headers);
-    while (!serverHelper->jobIsDone(resultResponse)) {
-      auto polling_interval =
-          serverHelper->nextResultPollingInterval(resultResponse);
-      std::this_thread::sleep_for(polling_interval);
-      resultResponse = client.get(jobGetPath, "", headers);
-    }
+  std::vector<ExecutionResult> results;
+  for (std::size_t i = 0; auto &id : jobs) {
+    auto resultResponse = responses[i++].get();
     auto c = serverHelper->processResults(resultResponse, id.first);
 
     if (isObserve) {
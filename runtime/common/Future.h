@@ -8,6 +8,7 @@
 
 #pragma once
 #include "MeasureCounts.h"
+#include "MeasurementGrouping.h"
 #include "ObserveResult.h"
 
 #include <functional>
@@ -137,7 +138,9 @@ public:
       if (data.has_expectation(checkRegName))
         return observe_result(data.expectation(checkRegName), *spinOp, data);
 
-      // this assumes we ran in shots mode.
+      // this assumes we ran in shots mode, possibly measuring the terms in
+      // groups.
+      addGroupedTermResults(data, *spinOp);
       double sum = 0.0;
       for (const auto &term : spinOp.value()) {
         if (term.is_identity())
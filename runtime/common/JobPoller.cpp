@@ -0,0 +1,221 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "JobPoller.h"
+#include "Logger.h"
+#include "RestClient.h"
+#include "ServerHelper.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace cudaq {
+namespace {
+static constexpr const char *MAX_POLL_INTERVAL_ENV =
+    "CUDAQ_JOB_POLL_MAX_INTERVAL_MS";
+
+std::chrono::microseconds getMaxPollingInterval() {
+  constexpr std::chrono::milliseconds defaultInterval(2000);
+  const char *envVal = std::getenv(MAX_POLL_INTERVAL_ENV);
+  if (!envVal)
+    return defaultInterval;
+  char *end = nullptr;
+  const long long value = std::strtoll(envVal, &end, 10);
+  if (end == envVal || *end != '\0' || value <= 0)
+    throw std::runtime_error(std::string("Invalid ") + MAX_POLL_INTERVAL_ENV +
+                             " setting. Expected a positive number of "
+                             "milliseconds. Got: " +
+                             envVal);
+  return std::chrono::milliseconds(value);
+}
+
+// Entries of the server configuration that only matter to the processing of
+// the results of a specific job.
+bool isJobSpecificConfig(const std::string &key) {
+  return key == "shots" || key.starts_with("output_names.") ||
+         key.starts_with("reorderIdx.");
+}
+
+std::unique_ptr<ServerHelper>
+makeServerHelper(const std::string &qpuName,
+                 const std::map<std::string, std::string> &config) {
+  auto serverHelper = registry::get<ServerHelper>(qpuName);
+  if (!serverHelper)
+    throw std::runtime_error("Cannot poll jobs of unknown server " + qpuName +
+                             ".");
+  serverHelper->initialize(config);
+  return serverHelper;
+}
+
+// The pollers of every server, indexed by server name then by configuration.
+std::mutex pollersMutex;
+std::map<std::string, std::map<std::string, std::unique_ptr<JobPoller>>>
+    pollers;
+} // namespace
+
+JobPoller &JobPoller::get(const std::string &qpuName,
+                          const std::map<std::string, std::string> &config) {
+  std::map<std::string, std::string> serverConfig;
+  for (const auto &[key, value] : config)
+    if (!isJobSpecificConfig(key))
+      serverConfig.emplace(key, value);
+  const std::string configKey = nlohmann::json(serverConfig).dump();
+
+  std::scoped_lock lock(pollersMutex);
+  auto &poller = pollers[qpuName][configKey];
+  if (!poller)
+    poller = std::make_unique<JobPoller>(qpuName, serverConfig);
+  return *poller;
+}
+
+void JobPoller::shutdown(const std::string &qpuName) {
+  std::map<std::string, std::unique_ptr<JobPoller>> serverPollers;
+  {
+    std::scoped_lock lock(pollersMutex);
+    auto iter = pollers.find(qpuName);
+    if (iter == pollers.end())
+      return;
+    serverPollers = std::move(iter->second);
+    pollers.erase(iter);
+  }
+  // Join the threads without holding the lock, the callbacks of the failed
+  // jobs may submit new ones.
+  cudaq::info("Stopping {} job pollers of {}.", serverPollers.size(), qpuName);
+  serverPollers.clear();
+}
+
+JobPoller::JobPoller(const std::string &qpuName,
+                     const std::map<std::string, std::string> &config)
+    : JobPoller(makeServerHelper(qpuName, config)) {}
+
+JobPoller::JobPoller(std::unique_ptr<ServerHelper> helper, StatusQuery query)
+    : serverHelper(std::move(helper)), statusQuery(std::move(query)),
+      maxBackoff(getMaxPollingInterval()) {
+  if (!statusQuery)
+    statusQuery = [client = std::make_shared<RestClient>()](
+                      const std::string &path,
+                      std::map<std::string, std::string> &headers) {
+      return client->get(path, "", headers);
+    };
+  thread = std::thread(&JobPoller::run, this);
+}
+
+JobPoller::~JobPoller() {
+  {
+    std::scoped_lock lock(mutex);
+    stop = true;
+  }
+  wakeUp.notify_all();
+  thread.join();
+  for (auto &job : jobs)
+    job.callback({}, std::make_exception_ptr(std::runtime_error(
+                         "Stopped polling job " + job.id + ".")));
+}
+
+void JobPoller::watch(const std::string &jobId, Callback callback) {
+  {
+    std::scoped_lock lock(mutex);
+    jobs.push_back(Job{jobId, std::move(callback), Clock::now()});
+  }
+  wakeUp.notify_all();
+}
+
+std::future<JobPoller::ServerMessage>
+JobPoller::watch(const std::string &jobId) {
+  auto promise = std::make_shared<std::promise<ServerMessage>>();
+  auto result = promise->get_future();
+  watch(jobId, [promise](ServerMessage &&response, std::exception_ptr error) {
+    if (error)
+      promise->set_exception(error);
+    else
+      promise->set_value(std::move(response));
+  });
+  return result;
+}
+
+std::size_t JobPoller::numPending() const {
+  std::scoped_lock lock(mutex);
+  return jobs.size();
+}
+
+void JobPoller::run() {
+  std::unique_lock lock(mutex);
+  while (true) {
+    wakeUp.wait(lock, [&] { return stop || !jobs.empty(); });
+    if (stop)
+      return;
+
+    // Sleep until the next job is due, or until a new job arrives.
+    auto nextPoll = std::min_element(jobs.begin(), jobs.end(),
+                                     [](const Job &a, const Job &b) {
+                                       return a.nextPoll < b.nextPoll;
+                                     })
+                        ->nextPoll;
+    if (nextPoll > Clock::now()) {
+      wakeUp.wait_until(lock, nextPoll);
+      continue;
+    }
+
+    // Poll all the due jobs without holding the lock, so that new jobs can be
+    // submitted meanwhile.
+    const auto now = Clock::now();
+    auto firstDue = std::partition(jobs.begin(), jobs.end(), [&](Job &job) {
+      return job.nextPoll > now;
+    });
+    std::vector<Job> due(std::make_move_iterator(firstDue),
+                         std::make_move_iterator(jobs.end()));
+    jobs.erase(firstDue, jobs.end());
+    lock.unlock();
+
+    cudaq::info("Job poller querying {} jobs.", due.size());
+    std::vector<Job> waiting;
+    std::exception_ptr headersError;
+    RestHeaders headers;
+    try {
+      headers = serverHelper->getHeaders();
+    } catch (...) {
+      headersError = std::current_exception();
+    }
+    for (auto &job : due) {
+      ServerMessage response;
+      std::exception_ptr error = headersError;
+      bool done = true;
+      if (!error) {
+        try {
+          auto jobGetPath = serverHelper->constructGetJobPath(job.id);
+          response = statusQuery(jobGetPath, headers);
+          done = serverHelper->jobIsDone(response);
+          if (!done) {
+            const auto requested =
+                serverHelper->nextResultPollingInterval(response);
+            job.backoff = job.backoff.count() == 0
+                              ? requested
+                              : std::min(2 * job.backoff,
+                                         std::max(requested, maxBackoff));
+            job.nextPoll = Clock::now() + std::max(requested, job.backoff);
+          }
+        } catch (...) {
+          error = std::current_exception();
+          done = true;
+        }
+      }
+      if (!done) {
+        waiting.push_back(std::move(job));
+        continue;
+      }
+      try {
+        job.callback(std::move(response), error);
+      } catch (std::exception &e) {
+        cudaq::info("Job poller callback for {} failed: {}", job.id, e.what());
+      }
+    }
+
+    lock.lock();
+    std::move(waiting.begin(), waiting.end(), std::back_inserter(jobs));
+  }
+}
+} // namespace cudaq
@@ -0,0 +1,101 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include "nlohmann/json.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace cudaq {
+class ServerHelper;
+
+/// @brief Background service tracking the status of remote jobs. A single
+/// thread polls all the outstanding jobs of a server: every round queries the
+/// jobs that are due, then sleeps until the next one is. The polling interval
+/// of a job starts at the one requested by the server helper and doubles
+/// after every poll, up to `CUDAQ_JOB_POLL_MAX_INTERVAL_MS` (2000 ms by
+/// default), but never goes below the interval the server helper requests.
+class JobPoller {
+public:
+  using ServerMessage = nlohmann::json;
+
+  /// @brief Invoked on the poller thread with the final job response, or
+  /// with the exception raised while polling the job.
+  using Callback =
+      std::function<void(ServerMessage &&response, std::exception_ptr error)>;
+
+  /// @brief Query the status of a job at \p path, as constructed by the server
+  /// helper, with the given headers. A REST GET by default.
+  using StatusQuery = std::function<ServerMessage(
+      const std::string &path, std::map<std::string, std::string> &headers)>;
+
+  /// @brief Return the poller of the server \p qpuName with the
+  /// configuration \p config. The job-specific entries of the configuration
+  /// (output names, reordering indices and shots) are ignored, such that all
+  /// the jobs submitted to a server share a poller.
+  static JobPoller &get(const std::string &qpuName,
+                        const std::map<std::string, std::string> &config);
+
+  /// @brief Stop and join the pollers of the server \p qpuName, failing the
+  /// jobs they still track. The QPUs submitting the jobs call this when they
+  /// are destroyed, such that no poller thread is left running (e.g., issuing
+  /// requests or logging) while the process tears down its globals.
+  static void shutdown(const std::string &qpuName);
+
+  JobPoller(const std::string &qpuName,
+            const std::map<std::string, std::string> &config);
+
+  /// @brief Poll the jobs of the initialized \p serverHelper, querying their
+  /// status with \p statusQuery, or with REST GETs if it is empty.
+  JobPoller(std::unique_ptr<ServerHelper> serverHelper,
+            StatusQuery statusQuery = {});
+  JobPoller(const JobPoller &) = delete;
+  JobPoller &operator=(const JobPoller &) = delete;
+  ~JobPoller();
+
+  /// @brief Track the job \p jobId, \p callback is invoked once it is done.
+  void watch(const std::string &jobId, Callback callback);
+
+  /// @brief Track the job \p jobId, the returned future holds its final
+  /// response.
+  std::future<ServerMessage> watch(const std::string &jobId);
+
+  /// @brief Number of jobs that are not done yet.
+  std::size_t numPending() const;
+
+private:
+  using Clock = std::chrono::steady_clock;
+  struct Job {
+    std::string id;
+    Callback callback;
+    Clock::time_point nextPoll;
+    std::chrono::microseconds backoff{0};
+  };
+
+  void run();
+
+  std::unique_ptr<ServerHelper> serverHelper;
+  StatusQuery statusQuery;
+  std::chrono::microseconds maxBackoff;
+  mutable std::mutex mutex;
+  std::condition_variable wakeUp;
+  std::vector<Job> jobs;
+  bool stop = false;
+  std::thread thread;
+};
+} // namespace cudaq
@@ -61,7 +61,7 @@ namespace cudaq {
 inline void to_json(json &j, const ExecutionResult &result) {
   j = json{{"counts", result.counts},
            {"registerName", result.registerName},
-           {"sequentialData", result.sequentialData}};
+           {"sequentialData", result.getSequentialData()}};
   if (result.expectationValue.has_value())
     j["expectationValue"] = result.expectationValue.value();
 }
@@ -69,7 +69,8 @@ inline void to_json(json &j, const ExecutionResult &result) {
 inline void from_json(const json &j, ExecutionResult &result) {
   j.at("counts").get_to(result.counts);
   j.at("registerName").get_to(result.registerName);
-  j.at("sequentialData").get_to(result.sequentialData);
+  result.sequentialData =
+      j.at("sequentialData").get<std::vector<std::string>>();
   double expVal = 0.0;
   if (j.contains("expectationValue")) {
     j.at("expectationValue").get_to(expVal);
@@ -9,7 +9,10 @@
 #include "Logger.h"
 #include "Timing.h"
 #include "spdlog/sinks/stdout_color_sinks.h"
+#include <array>
+#include <atomic>
 #include <filesystem>
+#include <fstream>
 #include <set>
 #include <spdlog/cfg/env.h>
 #include <spdlog/cfg/helpers.h>
@@ -17,6 +20,7 @@
 #include <spdlog/sinks/rotating_file_sink.h>
 #include <spdlog/spdlog.h>
 #include <sstream>
+#include <unistd.h>
 
 namespace cudaq {
 
@@ -36,6 +40,183 @@ bool isTimingTagEnabled(int tag) {
   return g_timingList().contains(tag);
 }
 
+namespace {
+/// @brief A complete ("X") Chrome trace event.
+struct TraceEvent {
+  std::string name;
+  std::string args;
+  const char *fileName = nullptr;
+  int lineNo = 0;
+  int tag = 0;
+  std::int64_t qpuId = -1;
+  std::chrono::time_point<std::chrono::system_clock> startTime;
+  std::chrono::time_point<std::chrono::system_clock> endTime;
+};
+
+/// @brief Fixed-size block of trace events. Only the owning thread appends to
+/// a chunk; the number of events is published with release semantics, such
+/// that the events can be read at exit without locking the writers.
+struct TraceEventChunk {
+  static constexpr std::size_t capacity = 256;
+  std::array<TraceEvent, capacity> events;
+  std::atomic<std::size_t> size = 0;
+  std::atomic<TraceEventChunk *> next = nullptr;
+};
+
+/// @brief The trace events of a thread, as a list of chunks. Buffers are never
+/// released, since the events of a thread must outlive it.
+struct TraceEventBuffer {
+  std::uint32_t threadId = 0;
+  std::int64_t qpuId = -1;
+  TraceEventChunk head;
+  TraceEventChunk *tail = &head;
+  TraceEventBuffer *next = nullptr;
+
+  void append(TraceEvent &&event) {
+    if (tail->size.load(std::memory_order_relaxed) ==
+        TraceEventChunk::capacity) {
+      auto *chunk = new TraceEventChunk;
+      tail->next.store(chunk, std::memory_order_release);
+      tail = chunk;
+    }
+    const auto size = tail->size.load(std::memory_order_relaxed);
+    tail->events[size] = std::move(event);
+    tail->size.store(size + 1, std::memory_order_release);
+  }
+};
+
+/// @brief Collector of the trace events of all threads.
+struct TraceEventRegistry {
+  std::string fileName;
+  std::atomic<TraceEventBuffer *> buffers = nullptr;
+  std::atomic<std::uint32_t> numThreads = 0;
+
+  TraceEventBuffer &threadBuffer() {
+    thread_local TraceEventBuffer *buffer = nullptr;
+    if (!buffer) {
+      buffer = new TraceEventBuffer;
+      buffer->threadId = numThreads++;
+      buffer->next = buffers.load(std::memory_order_relaxed);
+      while (!buffers.compare_exchange_weak(buffer->next, buffer,
+                                            std::memory_order_release,
+                                            std::memory_order_relaxed))
+        ;
+    }
+    return *buffer;
+  }
+
+  void write() const;
+};
+
+// Allocated on first use and never destroyed, such that threads that are
+// still running at exit can keep recording.
+TraceEventRegistry *g_traceEvents = nullptr;
+
+std::string escapeJson(const std::string_view str) {
+  std::string escaped;
+  escaped.reserve(str.size());
+  for (char c : str) {
+    switch (c) {
+    case '"':
+      escaped += "\\\"";
+      break;
+    case '\\':
+      escaped += "\\\\";
+      break;
+    case '\n':
+      escaped += "\\n";
+      break;
+    case '\t':
+      escaped += "\\t";
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20)
+        escaped += fmt::format("\\u{:04x}", static_cast<int>(c));
+      else
+        escaped += c;
+    }
+  }
+  return escaped;
+}
+
+void TraceEventRegistry::write() const {
+  auto *first = buffers.load(std::memory_order_acquire);
+  // Nothing was recorded, do not clobber the file.
+  if (!first)
+    return;
+
+  std::ofstream out(fileName);
+  if (!out) {
+    fmt::print("WARNING: could not open CUDAQ_TRACE_EVENTS_FILE ({}), trace "
+               "events are not written.\n",
+               fileName);
+    return;
+  }
+
+  const auto pid = ::getpid();
+  // Timestamps are in microseconds, relative to the earliest event.
+  auto origin = std::chrono::time_point<std::chrono::system_clock>::max();
+  for (auto *buffer = first; buffer; buffer = buffer->next)
+    for (const auto *chunk = &buffer->head; chunk;
+         chunk = chunk->next.load(std::memory_order_acquire)) {
+      const auto size = chunk->size.load(std::memory_order_acquire);
+      for (std::size_t i = 0; i < size; i++)
+        origin = std::min(origin, chunk->events[i].startTime);
+    }
+  auto toMicroseconds = [](auto duration) {
+    return std::chrono::duration<double, std::micro>(duration).count();
+  };
+
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool firstEvent = true;
+  auto separator = [&]() -> const char * {
+    if (firstEvent) {
+      firstEvent = false;
+      return "\n";
+    }
+    return ",\n";
+  };
+  for (auto *buffer = first; buffer; buffer = buffer->next) {
+    out << separator()
+        << fmt::format("{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":{},"
+                       "\"tid\":{},\"args\":{{\"name\":\"thread {}\"}}}}",
+                       pid, buffer->threadId, buffer->threadId);
+    for (const auto *chunk = &buffer->head; chunk;
+         chunk = chunk->next.load(std::memory_order_acquire)) {
+      const auto size = chunk->size.load(std::memory_order_acquire);
+      for (std::size_t i = 0; i < size; i++) {
+        const auto &event = chunk->events[i];
+        std::string args;
+        if (!event.args.empty())
+          args += fmt::format(",\"args\":\"{}\"", escapeJson(event.args));
+        if (event.tag)
+          args += fmt::format(",\"tag\":{}", event.tag);
+        if (event.qpuId >= 0)
+          args += fmt::format(",\"qpu\":{}", event.qpuId);
+        if (event.fileName)
+          args += fmt::format(
+              ",\"source\":\"{}:{}\"",
+              escapeJson(details::pathToFileName(event.fileName)),
+              event.lineNo);
+        if (!args.empty())
+          args[0] = '{';
+        else
+          args = "{";
+        out << separator()
+            << fmt::format("{{\"name\":\"{}\",\"cat\":\"cudaq\",\"ph\":\"X\","
+                           "\"ts\":{:.3f},\"dur\":{:.3f},\"pid\":{},\"tid\":{},"
+                           "\"args\":{}}}}}",
+                           escapeJson(event.name),
+                           toMicroseconds(event.startTime - origin),
+                           toMicroseconds(event.endTime - event.startTime),
+                           pid, buffer->threadId, args);
+      }
+    }
+  }
+  out << "\n]}\n";
+}
+} // namespace
+
 /// @brief This function will run at startup and initialize
 /// the logger for the runtime to use. It will set the log
 /// level and optionally dump to file if specified.
@@ -86,6 +267,18 @@ __attribute__((constructor)) void initializeLogger() {
       }
     }
   }
+
+  // Record the scoped traces as Chrome trace events, which can be loaded in
+  // Perfetto or chrome://tracing. A `%p` in the file name is replaced by the
+  // process id, e.g., to keep the traces of MPI ranks apart.
+  if (auto *val = std::getenv("CUDAQ_TRACE_EVENTS_FILE");
+      val && *val && !g_traceEvents) {
+    g_traceEvents = new TraceEventRegistry;
+    g_traceEvents->fileName = val;
+    if (auto pos = g_traceEvents->fileName.find("%p"); pos != std::string::npos)
+      g_traceEvents->fileName.replace(pos, 2, std::to_string(::getpid()));
+    std::atexit([]() { g_traceEvents->write(); });
+  }
 }
 
 namespace details {
@@ -117,5 +310,21 @@ std::string pathToFileName(const std::string_view fullFilePath) {
   const std::filesystem::path file(fullFilePath);
   return file.filename().string();
 }
+bool should_record_trace_events() { return g_traceEvents != nullptr; }
+void record_trace_event(
+    const std::string_view name, const std::string_view args, int tag,
+    const char *fileName, int lineNo,
+    std::chrono::time_point<std::chrono::system_clock> startTime,
+    std::chrono::time_point<std::chrono::system_clock> endTime) {
+  if (!g_traceEvents)
+    return;
+  auto &buffer = g_traceEvents->threadBuffer();
+  buffer.append(TraceEvent{std::string(name), std::string(args), fileName,
+                           lineNo, tag, buffer.qpuId, startTime, endTime});
+}
+void set_trace_qpu_id(std::size_t qpuId) {
+  if (g_traceEvents)
+    g_traceEvents->threadBuffer().qpuId = static_cast<std::int64_t>(qpuId);
+}
 } // namespace details
 } // namespace cudaq
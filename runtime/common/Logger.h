@@ -30,6 +30,19 @@ void info(const std::string_view msg);
 void debug(const std::string_view msg);
 void warn(const std::string_view msg);
 std::string pathToFileName(const std::string_view fullFilePath);
+
+/// @brief Returns true if scoped traces are recorded as Chrome trace events,
+/// i.e., if `CUDAQ_TRACE_EVENTS_FILE` is set. Only decided at startup.
+bool should_record_trace_events();
+/// @brief Record a complete trace event on the buffer of the calling thread.
+/// The events of all threads are written to `CUDAQ_TRACE_EVENTS_FILE` at exit.
+void record_trace_event(
+    const std::string_view name, const std::string_view args, int tag,
+    const char *fileName, int lineNo,
+    std::chrono::time_point<std::chrono::system_clock> startTime,
+    std::chrono::time_point<std::chrono::system_clock> endTime);
+/// @brief Set the QPU id attached to the trace events of the calling thread.
+void set_trace_qpu_id(std::size_t qpuId);
 } // namespace details
 
 /// This type seeks to enable automated injection of the
@@ -135,7 +148,7 @@ private:
   /// @brief The name of this trace, typically the function name
   std::string traceName;
 
-  /// @brief Any arguments the user would also like to print
+  /// @brief Any arguments the user would also like to print, comma separated
   std::string argsMsg;
 
   /// @brief Integer timing tag value (used to enable/disable this trace)
@@ -144,15 +157,34 @@ private:
   /// @brief Whether or not timing tag is enabled
   bool tagFound = false;
 
+  /// @brief Whether or not this trace is recorded as a trace event (see
+  /// `CUDAQ_TRACE_EVENTS_FILE`)
+  bool eventFound = false;
+
   /// @brief File, line, etc. of trace caller
   TraceContext context;
 
   thread_local static inline short int globalTraceStack = -1;
 
+  /// @brief Format the user-specified arguments as a comma separated list.
+  template <typename... Args>
+  static std::string formatArgs(Args &&...args) {
+    constexpr std::size_t nArgs = sizeof...(Args);
+    if constexpr (nArgs == 0)
+      return {};
+    else {
+      std::string argsFormat;
+      for (std::size_t i = 0; i < nArgs; i++)
+        argsFormat += (i != nArgs - 1) ? "{}, " : "{}";
+      return fmt::format(fmt::runtime(argsFormat), args...);
+    }
+  }
+
   /// @brief Constructor with name only. This is private because you should
   /// probably be using ScopedTraceWithContext() instead.
   ScopedTrace(const std::string &name) {
-    if (details::should_log(details::LogLevel::trace)) {
+    eventFound = details::should_record_trace_events();
+    if (eventFound || details::should_log(details::LogLevel::trace)) {
       startTime = std::chrono::system_clock::now();
       traceName = name;
       globalTraceStack++;
@@ -164,15 +196,11 @@ private:
   /// instead.
   template <typename... Args>
   ScopedTrace(const std::string &name, Args &&...args) {
-    if (details::should_log(details::LogLevel::trace)) {
+    eventFound = details::should_record_trace_events();
+    if (eventFound || details::should_log(details::LogLevel::trace)) {
       startTime = std::chrono::system_clock::now();
       traceName = name;
-      argsMsg = " (args = {{";
-      constexpr std::size_t nArgs = sizeof...(Args);
-      for (std::size_t i = 0; i < nArgs; i++) {
-        argsMsg += (i != nArgs - 1) ? "{}, " : "{}}})";
-      }
-      argsMsg = fmt::format(fmt::runtime(argsMsg), args...);
+      argsMsg = formatArgs(args...);
       globalTraceStack++;
     }
   }
@@ -186,26 +214,12 @@ private:
   ScopedTrace(const int tag, const std::string &name, Args &&...args)
       : tag(tag) {
     tagFound = cudaq::isTimingTagEnabled(tag);
-    if (tagFound || details::should_log(details::LogLevel::trace)) {
+    eventFound = details::should_record_trace_events();
+    if (tagFound || eventFound ||
+        details::should_log(details::LogLevel::trace)) {
       startTime = std::chrono::system_clock::now();
       traceName = name;
-      if (tagFound) {
-        // This needs double double braces because it goes through
-        // fmt::format(fmt::runtime()) twice ... once in this function and once
-        // in the cudaq::log() in the destructor.
-        argsMsg = " (args = {{{{";
-        constexpr std::size_t nArgs = sizeof...(Args);
-        for (std::size_t i = 0; i < nArgs; i++) {
-          argsMsg += (i != nArgs - 1) ? "{}, " : "{}}}}})";
-        }
-      } else {
-        argsMsg = " (args = {{";
-        constexpr std::size_t nArgs = sizeof...(Args);
-        for (std::size_t i = 0; i < nArgs; i++) {
-          argsMsg += (i != nArgs - 1) ? "{}, " : "{}}})";
-        }
-      }
-      argsMsg = fmt::format(fmt::runtime(argsMsg), args...);
+      argsMsg = formatArgs(args...);
       globalTraceStack++;
     }
   }
@@ -220,7 +234,9 @@ private:
               int lineNo = __builtin_LINE())
       : tag(tag), context(funcName, fileName, lineNo) {
     tagFound = cudaq::isTimingTagEnabled(tag);
-    if (tagFound || details::should_log(details::LogLevel::trace)) {
+    eventFound = details::should_record_trace_events();
+    if (tagFound || eventFound ||
+        details::should_log(details::LogLevel::trace)) {
       startTime = std::chrono::system_clock::now();
       traceName = name;
       globalTraceStack++;
@@ -245,10 +261,19 @@ public:
 
   /// The destructor, get the elapsed time and trace.
   ~ScopedTrace() {
-    if (tagFound || details::should_log(details::LogLevel::trace)) {
+    const bool logTrace =
+        tagFound || details::should_log(details::LogLevel::trace);
+    if (!logTrace && !eventFound)
+      return;
+
+    const auto endTime = std::chrono::system_clock::now();
+    if (eventFound)
+      details::record_trace_event(traceName, argsMsg, tag, context.fileName,
+                                  context.lineNo, startTime, endTime);
+    if (logTrace) {
       auto duration = static_cast<double>(
-          std::chrono::duration_cast<std::chrono::microseconds>(
-              std::chrono::system_clock::now() - startTime)
+          std::chrono::duration_cast<std::chrono::microseconds>(endTime -
+                                                                startTime)
               .count() /
           1000.0);
       // If we're printing because the tag was found, then add that tag info
@@ -262,13 +287,14 @@ public:
       auto str = fmt::format(
           "{}{}{}{} executed in {} ms.{}",
           globalTraceStack > 0 ? std::string(globalTraceStack, '-') + " " : "",
-          tagStr, sourceInfo, traceName, duration, argsMsg);
+          tagStr, sourceInfo, traceName, duration,
+          argsMsg.empty() ? "" : " (args = {" + argsMsg + "})");
       if (tagFound)
-        cudaq::log(str);
+        cudaq::log("{}", str);
       else
         details::trace(str);
-      globalTraceStack--;
     }
+    globalTraceStack--;
   }
 };
 } // namespace cudaq
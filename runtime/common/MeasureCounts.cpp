@@ -10,6 +10,7 @@
 #include "cudaq/spin_op.h"
 
 #include <algorithm>
+#include <bit>
 #include <numeric>
 #include <string.h>
 
@@ -55,6 +56,256 @@ std::string extractNameFromData(std::vector<std::size_t> &data,
   return name;
 }
 
+PackedShotData::PackedShotData(const std::vector<std::string> &bitStrings) {
+  *this = bitStrings;
+}
+
+PackedShotData &
+PackedShotData::operator=(const std::vector<std::string> &bitStrings) {
+  clear();
+  if (bitStrings.empty())
+    return *this;
+  reserve(bitStrings.size(), bitStrings.front().size());
+  for (const auto &bits : bitStrings)
+    append(bits);
+  return *this;
+}
+
+void PackedShotData::prepareNumBits(std::size_t bits) {
+  if (numShots == 0) {
+    clear();
+    numBits = bits;
+    return;
+  }
+  if (!unpacked && bits != numBits)
+    unpack();
+}
+
+void PackedShotData::unpack() {
+  unpackedShots = toBitStrings();
+  unpacked = true;
+  numBits = 0;
+  words.clear();
+  words.shrink_to_fit();
+}
+
+void PackedShotData::clear() {
+  numBits = 0;
+  numShots = 0;
+  words.clear();
+  unpacked = false;
+  unpackedShots.clear();
+}
+
+void PackedShotData::reserve(std::size_t shots, std::size_t bits) {
+  if (unpacked)
+    unpackedShots.reserve(unpackedShots.size() + shots);
+  else
+    words.reserve(words.size() + shots * ((bits + 63) / 64));
+}
+
+void PackedShotData::append(std::string_view bitString, std::size_t count) {
+  if (count == 0)
+    return;
+  prepareNumBits(bitString.size());
+  if (unpacked) {
+    unpackedShots.insert(unpackedShots.end(), count, std::string(bitString));
+    numShots += count;
+    return;
+  }
+  const auto nWords = wordsPerShot();
+  const auto first = words.size();
+  words.resize(first + nWords, 0);
+  for (std::size_t b = 0; b < numBits; b++)
+    if (bitString[b] == '1')
+      words[first + b / 64] |= (1ULL << (b % 64));
+
+  // Replicate the packed shot for repeated observations
+  for (std::size_t c = 1; c < count; c++)
+    words.insert(words.end(), words.begin() + first,
+                 words.begin() + first + nWords);
+  numShots += count;
+}
+
+void PackedShotData::append(const PackedShotData &other) {
+  if (other.empty())
+    return;
+  if (other.unpacked) {
+    if (numShots == 0)
+      clear();
+    else if (!unpacked)
+      unpack();
+    unpacked = true;
+    unpackedShots.insert(unpackedShots.end(), other.unpackedShots.begin(),
+                         other.unpackedShots.end());
+    numShots += other.numShots;
+    return;
+  }
+  prepareNumBits(other.numBits);
+  if (unpacked) {
+    auto otherShots = other.toBitStrings();
+    unpackedShots.insert(unpackedShots.end(),
+                         std::make_move_iterator(otherShots.begin()),
+                         std::make_move_iterator(otherShots.end()));
+    numShots += other.numShots;
+    return;
+  }
+  words.insert(words.end(), other.words.begin(), other.words.end());
+  numShots += other.numShots;
+}
+
+void PackedShotData::concatenate(const PackedShotData &other) {
+  if (other.numShots != numShots)
+    throw std::runtime_error(
+        "Cannot concatenate sequential data with different number of shots");
+
+  if (unpacked || other.unpacked) {
+    if (!unpacked)
+      unpack();
+    for (std::size_t s = 0; s < numShots; s++)
+      unpackedShots[s] += other.getBitString(s);
+    return;
+  }
+
+  PackedShotData result;
+  result.numBits = numBits + other.numBits;
+  result.numShots = numShots;
+  const auto nWords = result.wordsPerShot();
+  result.words.resize(numShots * nWords, 0);
+  for (std::size_t s = 0; s < numShots; s++) {
+    auto *dst = result.words.data() + s * nWords;
+    for (std::size_t b = 0; b < numBits; b++)
+      if (getBit(s, b))
+        dst[b / 64] |= (1ULL << (b % 64));
+    for (std::size_t b = 0; b < other.numBits; b++)
+      if (other.getBit(s, b))
+        dst[(numBits + b) / 64] |= (1ULL << ((numBits + b) % 64));
+  }
+  *this = std::move(result);
+}
+
+void PackedShotData::reorder(const std::vector<std::size_t> &index) {
+  if (empty())
+    return;
+  if (unpacked) {
+    for (auto &bits : unpackedShots) {
+      if (index.size() != bits.size())
+        throw std::runtime_error(
+            "Calling reorder() with invalid parameter idx");
+      std::string newBits(bits);
+      for (std::size_t b = 0; b < index.size(); b++)
+        newBits[b] = bits[index[b]];
+      bits = std::move(newBits);
+    }
+    return;
+  }
+  if (index.size() != numBits)
+    throw std::runtime_error("Calling reorder() with invalid parameter idx");
+
+  const auto nWords = wordsPerShot();
+  std::vector<std::uint64_t> newWords(words.size(), 0);
+  for (std::size_t s = 0; s < numShots; s++)
+    for (std::size_t b = 0; b < numBits; b++)
+      if (getBit(s, index[b]))
+        newWords[s * nWords + b / 64] |= (1ULL << (b % 64));
+  words = std::move(newWords);
+}
+
+std::size_t PackedShotData::popcount(std::size_t shot) const {
+  if (unpacked)
+    return std::count(unpackedShots[shot].begin(), unpackedShots[shot].end(),
+                      '1');
+  const auto nWords = wordsPerShot();
+  std::size_t c = 0;
+  for (std::size_t w = 0; w < nWords; w++)
+    c += std::popcount(words[shot * nWords + w]);
+  return c;
+}
+
+PackedShotData
+PackedShotData::marginal(const std::vector<std::size_t> &indices) const {
+  if (unpacked) {
+    PackedShotData result;
+    for (const auto &bits : unpackedShots) {
+      std::string newBits;
+      newBits.reserve(indices.size());
+      for (auto index : indices) {
+        if (index >= bits.size())
+          throw std::runtime_error("Invalid marginal index (" +
+                                   std::to_string(index) +
+                                   ", size=" + std::to_string(bits.size()));
+        newBits.push_back(bits[index]);
+      }
+      result.append(newBits);
+    }
+    return result;
+  }
+
+  for (auto index : indices)
+    if (index >= numBits)
+      throw std::runtime_error("Invalid marginal index (" +
+                               std::to_string(index) +
+                               ", size=" + std::to_string(numBits));
+
+  PackedShotData result;
+  result.numBits = indices.size();
+  result.numShots = numShots;
+  const auto nWords = result.wordsPerShot();
+  result.words.resize(numShots * nWords, 0);
+  for (std::size_t s = 0; s < numShots; s++)
+    for (std::size_t b = 0; b < indices.size(); b++)
+      if (getBit(s, indices[b]))
+        result.words[s * nWords + b / 64] |= (1ULL << (b % 64));
+  return result;
+}
+
+CountsDictionary PackedShotData::toCounts() const {
+  if (unpacked) {
+    CountsDictionary counts;
+    for (const auto &bits : unpackedShots)
+      counts[bits]++;
+    return counts;
+  }
+
+  // Key each shot by a view of its packed words.
+  const auto nWords = wordsPerShot();
+  std::unordered_map<std::string_view, std::pair<std::size_t, std::size_t>>
+      packedCounts;
+  for (std::size_t s = 0; s < numShots; s++) {
+    std::string_view key(
+        reinterpret_cast<const char *>(words.data() + s * nWords),
+        nWords * sizeof(std::uint64_t));
+    auto [iter, inserted] = packedCounts.try_emplace(key, s, 0);
+    iter->second.second++;
+  }
+
+  CountsDictionary counts;
+  counts.reserve(packedCounts.size());
+  for (const auto &[key, entry] : packedCounts)
+    counts.emplace(getBitString(entry.first), entry.second);
+  return counts;
+}
+
+std::string PackedShotData::getBitString(std::size_t shot) const {
+  if (unpacked)
+    return unpackedShots[shot];
+  std::string bits(numBits, '0');
+  for (std::size_t b = 0; b < numBits; b++)
+    if (getBit(shot, b))
+      bits[b] = '1';
+  return bits;
+}
+
+std::vector<std::string> PackedShotData::toBitStrings() const {
+  if (unpacked)
+    return unpackedShots;
+  std::vector<std::string> ret;
+  ret.reserve(numShots);
+  for (std::size_t s = 0; s < numShots; s++)
+    ret.emplace_back(getBitString(s));
+  return ret;
+}
+
 ExecutionResult::ExecutionResult(CountsDictionary c) : counts(c) {}
 ExecutionResult::ExecutionResult(std::string name) : registerName(name) {}
 ExecutionResult::ExecutionResult(double e) : expectationValue(e) {}
@@ -83,7 +334,7 @@ void ExecutionResult::appendResult(std::string bitString, std::size_t count) {
   if (!inserted)
     iter->second += count;
 
-  sequentialData.insert(sequentialData.end(), count, iter->first);
+  sequentialData.append(iter->first, count);
 }
 
 bool ExecutionResult::operator==(const ExecutionResult &result) const {
@@ -203,13 +454,11 @@ void sample_result::append(ExecutionResult &result, bool concatenate) {
     if (concatenate) {
       // Stitch the bitstrings together
       if (this->totalShots == result.sequentialData.size()) {
+        auto &sequentialData = existingExecResult.sequentialData;
+        sequentialData.concatenate(result.sequentialData);
         existingExecResult.counts.clear();
-        for (std::size_t i = 0; i < this->totalShots; i++) {
-          std::string newStr =
-              existingExecResult.sequentialData[i] + result.sequentialData[i];
-          existingExecResult.counts[newStr]++;
-          existingExecResult.sequentialData[i] = std::move(newStr);
-        }
+        for (std::size_t i = 0; i < this->totalShots; i++)
+          existingExecResult.counts[sequentialData.getBitString(i)]++;
       }
     } else {
       // Replace the existing one
@@ -247,10 +496,7 @@ sample_result &sample_result::operator+=(const sample_result &other) {
           ourCounts.insert({bits, count});
       }
 
-      if (!otherResults.second.sequentialData.empty())
-        sr.sequentialData.insert(sr.sequentialData.end(),
-                                 otherResults.second.sequentialData.begin(),
-                                 otherResults.second.sequentialData.end());
+      sr.sequentialData.append(otherResults.second.sequentialData);
     }
     if (regName == GlobalRegisterName)
       totalShots += other.totalShots;
@@ -370,11 +616,21 @@ double sample_result::expectation(const std::string_view registerName) const {
   if (result.expectationValue.has_value())
     return result.expectationValue.value();
 
+  // Prefer the packed shot data, where the parity of each shot is a
+  // word-level popcount.
+  const auto &shots = result.sequentialData;
+  if (!shots.empty() && shots.size() == totalShots) {
+    std::size_t numOdd = 0;
+    for (std::size_t s = 0; s < shots.size(); s++)
+      numOdd += shots.popcount(s) & 1;
+    return 1.0 - 2.0 * static_cast<double>(numOdd) / totalShots;
+  }
+
   double aver = 0.0;
   const auto &counts = result.counts;
   for (auto &kv : counts) {
     auto par = has_even_parity(kv.first);
-    auto p = probability(kv.first, registerName);
+    auto p = static_cast<double>(kv.second) / totalShots;
     if (!par) {
       p = -p;
     }
@@ -401,11 +657,21 @@ sample_result::to_map(const std::string_view registerName) const {
 sample_result
 sample_result::get_marginal(const std::vector<std::size_t> &marginalIndices,
                             const std::string_view registerName) const {
-  const auto &counts = retrieve_result(registerName.data()).counts;
+  const auto &result = retrieve_result(registerName.data());
   auto mutableIndices = marginalIndices;
 
   std::sort(mutableIndices.begin(), mutableIndices.end());
 
+  // If we have the data for every shot, marginalize it in packed form.
+  if (!result.sequentialData.empty() &&
+      result.sequentialData.size() == totalShots) {
+    ExecutionResult sr;
+    sr.sequentialData = result.sequentialData.marginal(mutableIndices);
+    sr.counts = sr.sequentialData.toCounts();
+    return sample_result(sr);
+  }
+
+  const auto &counts = result.counts;
   ExecutionResult sr;
   for (auto &[bits, count] : counts) {
     std::string newBits;
@@ -505,12 +771,6 @@ void sample_result::reorder(const std::vector<std::size_t> &idx,
   result.counts = newCounts;
 
   // Now process the sequential data
-  for (auto &s : result.sequentialData) {
-    std::string newBits(s);
-    int i = 0;
-    for (auto oldIdx : idx)
-      newBits[i++] = s[oldIdx];
-    s = newBits;
-  }
+  result.sequentialData.reorder(idx);
 }
 } // namespace cudaq
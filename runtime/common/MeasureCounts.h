@@ -8,8 +8,10 @@
 
 #pragma once
 
+#include <cstdint>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -20,6 +22,108 @@ using CountsDictionary = std::unordered_map<std::string, std::size_t>;
 
 inline static const std::string GlobalRegisterName = "__global__";
 
+/// The `PackedShotData` type stores sequential (per-shot) measurement bit
+/// strings in packed form. Every shot occupies the same number of 64-bit
+/// words, one bit per measured qubit, so that large sampling tasks do not
+/// allocate one `std::string` per shot. Bit strings are only materialized on
+/// request. Shots of different lengths (e.g., merged from different kernels)
+/// are supported by falling back to storing one bit string per shot.
+class PackedShotData {
+private:
+  /// @brief Number of bits in each shot, 0 if the shots have different
+  /// lengths.
+  std::size_t numBits = 0;
+
+  /// @brief Number of shots stored
+  std::size_t numShots = 0;
+
+  /// @brief The packed data, `wordsPerShot()` consecutive words per shot.
+  /// Bit `b` of a shot (i.e., character `b` of its bit string) is stored in
+  /// bit `b % 64` of word `b / 64`.
+  std::vector<std::uint64_t> words;
+
+  /// @brief True if the shots have different lengths. They are then stored as
+  /// bit strings in `unpackedShots` instead of `words`.
+  bool unpacked = false;
+  std::vector<std::string> unpackedShots;
+
+  std::size_t wordsPerShot() const { return (numBits + 63) / 64; }
+
+  /// @brief Set the number of bits per shot on first use. On subsequent uses
+  /// with a different number of bits, switch to the unpacked form.
+  void prepareNumBits(std::size_t bits);
+
+  /// @brief Convert the packed shots to the unpacked form.
+  void unpack();
+
+public:
+  PackedShotData() = default;
+
+  /// @brief Construct from a vector of bit strings
+  PackedShotData(const std::vector<std::string> &bitStrings);
+  PackedShotData &operator=(const std::vector<std::string> &bitStrings);
+
+  /// @brief Return the number of shots
+  std::size_t size() const { return numShots; }
+
+  /// @brief Return true if no shots are stored
+  bool empty() const { return numShots == 0; }
+
+  /// @brief Return the number of bits in each shot, 0 if the shots have
+  /// different lengths
+  std::size_t getNumBits() const { return numBits; }
+
+  /// @brief Return true if the shots have different lengths, and are stored
+  /// as bit strings
+  bool isUnpacked() const { return unpacked; }
+
+  /// @brief Remove all shots
+  void clear();
+
+  /// @brief Reserve storage for the given number of shots of `bits` bits.
+  void reserve(std::size_t shots, std::size_t bits);
+
+  /// @brief Append the bit string `count` times
+  void append(std::string_view bitString, std::size_t count = 1);
+
+  /// @brief Append all the shots of `other`
+  void append(const PackedShotData &other);
+
+  /// @brief Concatenate the bits of each shot of `other` to the bits of the
+  /// corresponding shot of this one. Both must have the same number of shots.
+  void concatenate(const PackedShotData &other);
+
+  /// @brief Reorder the bits of every shot such that
+  /// `newBits(:) = oldBits(index(:))`
+  void reorder(const std::vector<std::size_t> &index);
+
+  /// @brief Return the given bit of the given shot
+  bool getBit(std::size_t shot, std::size_t bit) const {
+    if (unpacked)
+      return unpackedShots[shot][bit] == '1';
+    return (words[shot * wordsPerShot() + bit / 64] >> (bit % 64)) & 1;
+  }
+
+  /// @brief Return the number of 1 bits in the given shot
+  std::size_t popcount(std::size_t shot) const;
+
+  /// @brief Return the shot data restricted to the given bit indices
+  PackedShotData marginal(const std::vector<std::size_t> &indices) const;
+
+  /// @brief Collate the shots into a counts dictionary. Shots are hashed in
+  /// packed form, only unique outcomes are converted to bit strings.
+  CountsDictionary toCounts() const;
+
+  /// @brief Return the given shot as a bit string
+  std::string getBitString(std::size_t shot) const;
+  std::string operator[](std::size_t shot) const { return getBitString(shot); }
+
+  /// @brief Return all shots as bit strings
+  std::vector<std::string> toBitStrings() const;
+
+  bool operator==(const PackedShotData &other) const = default;
+};
+
 /// The `ExecutionResult` models the result of a typical
 /// quantum state sampling task. It will contain the
 /// observed measurement bit strings and corresponding number
@@ -35,8 +139,9 @@ struct ExecutionResult {
   /// Register name for the classical bits
   std::string registerName = GlobalRegisterName;
 
-  /// @brief Sequential bit strings observed (not collated into a map)
-  std::vector<std::string> sequentialData;
+  /// @brief Sequential bit strings observed (not collated into a map), in
+  /// packed form
+  PackedShotData sequentialData;
 
   /// @brief Serialize this sample result to a vector of integers.
   /// Encoding: 1st element is size of the register name N, then next N
@@ -95,7 +200,9 @@ struct ExecutionResult {
   /// @param count
   void appendResult(std::string bitString, std::size_t count);
 
-  std::vector<std::string> getSequentialData() const { return sequentialData; }
+  std::vector<std::string> getSequentialData() const {
+    return sequentialData.toBitStrings();
+  }
 };
 
 /// @brief The sample_result abstraction wraps a set of `ExecutionResult`s for
@@ -0,0 +1,453 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "MeasurementGrouping.h"
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <numeric>
+#include <stdexcept>
+#include <unordered_set>
+
+namespace cudaq {
+
+MeasurementGrouping getMeasurementGrouping() {
+  const char *envVal = std::getenv(MEASUREMENT_GROUPING_ENV);
+  if (!envVal)
+    return MeasurementGrouping::none;
+  std::string value(envVal);
+  std::transform(value.begin(), value.end(), value.begin(), ::tolower);
+  if (value.empty() || value == "none")
+    return MeasurementGrouping::none;
+  if (value == "qubit_wise")
+    return MeasurementGrouping::qubit_wise;
+  if (value == "general")
+    return MeasurementGrouping::general;
+  throw std::runtime_error(std::string("Invalid ") + MEASUREMENT_GROUPING_ENV +
+                           " setting. Expected one of none, qubit_wise or "
+                           "general. Got: " +
+                           envVal);
+}
+
+namespace {
+
+/// @brief The non-identity Paulis of a term, by qubit.
+using PauliMap = std::map<std::size_t, pauli>;
+
+PauliMap getPaulis(const spin_op_term &term) {
+  PauliMap paulis;
+  for (const auto &op : term) {
+    auto p = op.as_pauli();
+    if (p != pauli::I)
+      paulis.emplace(op.target(), p);
+  }
+  return paulis;
+}
+
+/// @brief Return true if \p a and \p b act with the same Pauli on all the
+/// qubits they share.
+bool commuteQubitWise(const PauliMap &a, const PauliMap &b) {
+  for (const auto &[qubit, p] : a) {
+    auto iter = b.find(qubit);
+    if (iter != b.end() && iter->second != p)
+      return false;
+  }
+  return true;
+}
+
+/// @brief Return true if \p a and \p b commute, i.e., they anti-commute on an
+/// even number of qubits.
+bool commute(const PauliMap &a, const PauliMap &b) {
+  bool anticommute = false;
+  for (const auto &[qubit, p] : a) {
+    auto iter = b.find(qubit);
+    if (iter != b.end() && iter->second != p)
+      anticommute = !anticommute;
+  }
+  return !anticommute;
+}
+
+/// @brief A Pauli string in binary symplectic form over the local qubits of a
+/// group. `(x, z) = (1, 1)` stands for Y.
+struct SymplecticPauli {
+  std::vector<std::uint8_t> x;
+  std::vector<std::uint8_t> z;
+  bool negative = false;
+
+  SymplecticPauli &operator^=(const SymplecticPauli &other) {
+    for (std::size_t i = 0; i < x.size(); i++) {
+      x[i] ^= other.x[i];
+      z[i] ^= other.z[i];
+    }
+    return *this;
+  }
+};
+
+/// @brief A Clifford gate on local qubits: `h` and `s` act on `a`, `x` is a
+/// CNOT from `a` to `b` and `z` is a CZ between `a` and `b`.
+struct LocalGate {
+  char kind;
+  std::size_t a;
+  std::size_t b = 0;
+};
+
+void applyH(SymplecticPauli &p, std::size_t a) {
+  p.negative ^= p.x[a] & p.z[a];
+  std::swap(p.x[a], p.z[a]);
+}
+
+void applyCNOT(SymplecticPauli &p, std::size_t a, std::size_t b) {
+  p.negative ^= p.x[a] & p.z[b] & (p.x[b] ^ p.z[a] ^ 1);
+  p.x[b] ^= p.x[a];
+  p.z[a] ^= p.z[b];
+}
+
+/// @brief Conjugate \p p by \p gate, i.e., compute `U p U^dagger`.
+void conjugate(SymplecticPauli &p, const LocalGate &gate) {
+  switch (gate.kind) {
+  case 'h':
+    applyH(p, gate.a);
+    break;
+  case 's':
+    p.negative ^= p.x[gate.a] & p.z[gate.a];
+    p.z[gate.a] ^= p.x[gate.a];
+    break;
+  case 'x':
+    applyCNOT(p, gate.a, gate.b);
+    break;
+  case 'z':
+    applyH(p, gate.b);
+    applyCNOT(p, gate.a, gate.b);
+    applyH(p, gate.b);
+    break;
+  }
+}
+
+bool isZero(const SymplecticPauli &p) {
+  return std::none_of(p.x.begin(), p.x.end(), [](auto b) { return b; }) &&
+         std::none_of(p.z.begin(), p.z.end(), [](auto b) { return b; });
+}
+
+/// @brief Return a Clifford circuit that maps each of the pairwise commuting
+/// Pauli strings \p paulis to a product of Z, up to a sign.
+///
+/// An independent set of generators is put in a form whose X block is the
+/// identity on a set of pivot qubits (using Hadamards where needed), the
+/// remaining X entries are cleared with CNOTs, the Z entries with CZs and
+/// phase gates, and Hadamards on the pivots turn the generators into single
+/// qubit Zs.
+std::vector<LocalGate>
+diagonalize(const std::vector<SymplecticPauli> &paulis) {
+  if (paulis.empty())
+    return {};
+  const std::size_t n = paulis.front().x.size();
+
+  // Select independent generators by Gaussian elimination on (x | z).
+  std::vector<SymplecticPauli> gens;
+  std::vector<std::size_t> genPivots;
+  const auto bit = [n](const SymplecticPauli &p, std::size_t i) {
+    return i < n ? p.x[i] : p.z[i - n];
+  };
+  for (auto row : paulis) {
+    for (std::size_t k = 0; k < gens.size(); k++)
+      if (bit(row, genPivots[k]))
+        row ^= gens[k];
+    if (isZero(row))
+      continue;
+    std::size_t pivot = 0;
+    while (!bit(row, pivot))
+      pivot++;
+    gens.push_back(row);
+    genPivots.push_back(pivot);
+  }
+
+  std::vector<LocalGate> gates;
+  const auto apply = [&](LocalGate gate) {
+    gates.push_back(gate);
+    for (auto &gen : gens)
+      conjugate(gen, gate);
+  };
+
+  // Make the X block the identity on one pivot qubit per generator.
+  std::vector<std::size_t> pivotQubit(gens.size());
+  std::vector<bool> isPivot(n, false);
+  for (std::size_t i = 0; i < gens.size(); i++) {
+    std::size_t j = 0;
+    while (j < n && (isPivot[j] || !gens[i].x[j]))
+      j++;
+    if (j == n) {
+      // The generator has no X component outside of the pivots. Commutation
+      // with the previous generators guarantees it has a Z component there.
+      j = 0;
+      while (j < n && (isPivot[j] || !gens[i].z[j]))
+        j++;
+      if (j == n)
+        throw std::logic_error("Cannot diagonalize non-commuting terms.");
+      apply({'h', j});
+    }
+    pivotQubit[i] = j;
+    isPivot[j] = true;
+    for (std::size_t r = 0; r < gens.size(); r++)
+      if (r != i && gens[r].x[j])
+        gens[r] ^= gens[i];
+  }
+
+  // Clear the X entries outside of the pivots.
+  for (std::size_t i = 0; i < gens.size(); i++)
+    for (std::size_t j = 0; j < n; j++)
+      if (!isPivot[j] && gens[i].x[j])
+        apply({'x', pivotQubit[i], j});
+
+  // Clear the Z entries. Commutation makes the Z block on the pivots
+  // symmetric, so a CZ clears a pair of entries.
+  for (std::size_t i = 0; i < gens.size(); i++) {
+    for (std::size_t j = 0; j < n; j++)
+      if (j != pivotQubit[i] && gens[i].z[j])
+        apply({'z', pivotQubit[i], j});
+    if (gens[i].z[pivotQubit[i]])
+      apply({'s', pivotQubit[i]});
+  }
+
+  for (std::size_t i = 0; i < gens.size(); i++)
+    apply({'h', pivotQubit[i]});
+
+  return gates;
+}
+
+spin_op_term getBasisTerm(const PauliMap &paulis) {
+  spin_op_term basis = spin_op::identity();
+  for (const auto &[qubit, p] : paulis)
+    basis *= spin_op_term(spin_handler(p, qubit));
+  return spin_op_term::canonicalize(basis);
+}
+
+/// @brief Build a group that is measured after single-qubit basis changes.
+MeasurementGroup makeQubitWiseGroup(const std::vector<spin_op_term> &terms,
+                                    const std::vector<PauliMap> &paulis,
+                                    const std::vector<std::size_t> &members) {
+  PauliMap merged;
+  for (auto idx : members)
+    merged.insert(paulis[idx].begin(), paulis[idx].end());
+
+  MeasurementGroup group;
+  group.basis = getBasisTerm(merged);
+  group.name = group.basis->get_term_id();
+  for (const auto &[qubit, p] : merged)
+    group.measuredQubits.push_back(qubit);
+  for (auto idx : members) {
+    MeasurementGroup::Term term{terms[idx], {}, false};
+    for (const auto &[qubit, p] : paulis[idx])
+      term.qubits.push_back(qubit);
+    group.terms.push_back(std::move(term));
+  }
+  return group;
+}
+
+/// @brief Build a group that is measured after a Clifford circuit.
+MeasurementGroup makeGeneralGroup(const std::vector<spin_op_term> &terms,
+                                  const std::vector<PauliMap> &paulis,
+                                  const std::vector<std::size_t> &members,
+                                  std::size_t groupIdx) {
+  MeasurementGroup group;
+  for (auto idx : members)
+    for (const auto &[qubit, p] : paulis[idx])
+      group.measuredQubits.push_back(qubit);
+  std::sort(group.measuredQubits.begin(), group.measuredQubits.end());
+  group.measuredQubits.erase(
+      std::unique(group.measuredQubits.begin(), group.measuredQubits.end()),
+      group.measuredQubits.end());
+  const std::size_t n = group.measuredQubits.size();
+
+  const auto toSymplectic = [&](const PauliMap &paulis) {
+    SymplecticPauli s{std::vector<std::uint8_t>(n, 0),
+                      std::vector<std::uint8_t>(n, 0)};
+    for (const auto &[qubit, p] : paulis) {
+      auto local = std::distance(group.measuredQubits.begin(),
+                                 std::lower_bound(group.measuredQubits.begin(),
+                                                  group.measuredQubits.end(),
+                                                  qubit));
+      s.x[local] = p == pauli::X || p == pauli::Y;
+      s.z[local] = p == pauli::Z || p == pauli::Y;
+    }
+    return s;
+  };
+
+  std::vector<SymplecticPauli> symplectic;
+  for (auto idx : members)
+    symplectic.push_back(toSymplectic(paulis[idx]));
+  const auto gates = diagonalize(symplectic);
+
+  // The name cannot collide with a term id, which only contains Paulis and
+  // qubit indices.
+  group.name = "group" + std::to_string(groupIdx);
+  for (const auto &gate : gates) {
+    const auto a = group.measuredQubits[gate.a];
+    const auto b = group.measuredQubits[gate.b];
+    if (gate.kind == 'h' || gate.kind == 's')
+      group.basisChange.push_back({std::string(1, gate.kind), {}, a});
+    else
+      group.basisChange.push_back({std::string(1, gate.kind), {a}, b});
+  }
+
+  for (std::size_t i = 0; i < members.size(); i++) {
+    auto p = symplectic[i];
+    for (const auto &gate : gates)
+      conjugate(p, gate);
+    MeasurementGroup::Term term{terms[members[i]], {}, p.negative};
+    for (std::size_t q = 0; q < n; q++) {
+      if (p.x[q])
+        throw std::logic_error("Basis change did not diagonalize the group.");
+      if (p.z[q])
+        term.qubits.push_back(group.measuredQubits[q]);
+    }
+    group.terms.push_back(std::move(term));
+  }
+  return group;
+}
+} // namespace
+
+std::vector<MeasurementGroup> groupMeasurements(const spin_op &H,
+                                                MeasurementGrouping grouping) {
+  std::vector<spin_op_term> terms;
+  std::vector<PauliMap> paulis;
+  for (const auto &term : H) {
+    if (term.is_identity())
+      continue;
+    terms.push_back(term);
+    paulis.push_back(getPaulis(term));
+  }
+
+  std::vector<MeasurementGroup> groups;
+  if (grouping == MeasurementGrouping::none) {
+    for (std::size_t i = 0; i < terms.size(); i++)
+      groups.push_back(makeQubitWiseGroup(terms, paulis, {i}));
+    return groups;
+  }
+
+  const auto compatible = [&](std::size_t i, std::size_t j) {
+    return grouping == MeasurementGrouping::qubit_wise
+               ? commuteQubitWise(paulis[i], paulis[j])
+               : commute(paulis[i], paulis[j]);
+  };
+
+  // Visit the terms with the most conflicts first.
+  std::vector<std::size_t> conflicts(terms.size(), 0);
+  for (std::size_t i = 0; i < terms.size(); i++)
+    for (std::size_t j = i + 1; j < terms.size(); j++)
+      if (!compatible(i, j)) {
+        conflicts[i]++;
+        conflicts[j]++;
+      }
+  std::vector<std::size_t> order(terms.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](auto a, auto b) {
+    return conflicts[a] > conflicts[b];
+  });
+
+  // Put each term in the first group it is compatible with.
+  std::vector<std::vector<std::size_t>> members;
+  for (auto i : order) {
+    auto iter = std::find_if(members.begin(), members.end(), [&](auto &m) {
+      return std::all_of(m.begin(), m.end(),
+                         [&](auto j) { return compatible(i, j); });
+    });
+    if (iter == members.end())
+      members.push_back({i});
+    else
+      iter->push_back(i);
+  }
+
+  for (auto &m : members) {
+    // Qubit-wise commuting groups only need single-qubit basis changes.
+    bool qubitWise = true;
+    for (std::size_t a = 0; a < m.size() && qubitWise; a++)
+      for (std::size_t b = a + 1; b < m.size() && qubitWise; b++)
+        qubitWise = commuteQubitWise(paulis[m[a]], paulis[m[b]]);
+    if (qubitWise)
+      groups.push_back(makeQubitWiseGroup(terms, paulis, m));
+    else
+      groups.push_back(makeGeneralGroup(terms, paulis, m, groups.size()));
+  }
+  return groups;
+}
+
+std::vector<ExecutionResult>
+getTermResults(const MeasurementGroup &group,
+               const ExecutionResult &groupResult,
+               const std::vector<std::size_t> &bitQubits) {
+  std::vector<ExecutionResult> results;
+  for (const auto &term : group.terms) {
+    auto name = term.term.get_term_id();
+    if (name == group.name)
+      continue;
+
+    std::vector<std::size_t> positions;
+    for (auto qubit : term.qubits) {
+      auto iter = std::find(bitQubits.begin(), bitQubits.end(), qubit);
+      if (iter == bitQubits.end())
+        throw std::runtime_error("Qubit " + std::to_string(qubit) +
+                                 " was not measured for group " + group.name);
+      positions.push_back(std::distance(bitQubits.begin(), iter));
+    }
+
+    // The parity of the selected bits gives the value of the term. A negated
+    // term flips the first selected bit.
+    const auto termBits = [&](const std::string &bits) {
+      std::string result;
+      result.reserve(positions.size());
+      for (auto pos : positions)
+        result += bits[pos];
+      if (term.negate && !result.empty())
+        result[0] = result[0] == '1' ? '0' : '1';
+      return result;
+    };
+
+    CountsDictionary counts;
+    std::size_t numShots = 0;
+    double parity = 0.0;
+    for (const auto &[bits, count] : groupResult.counts) {
+      auto selected = termBits(bits);
+      counts[selected] += count;
+      numShots += count;
+      parity += std::count(selected.begin(), selected.end(), '1') % 2
+                    ? -static_cast<double>(count)
+                    : static_cast<double>(count);
+    }
+    ExecutionResult result(counts, name,
+                           numShots ? parity / numShots : 0.0);
+    for (std::size_t shot = 0; shot < groupResult.sequentialData.size(); shot++)
+      result.sequentialData.append(
+          termBits(groupResult.sequentialData.getBitString(shot)));
+    results.push_back(std::move(result));
+  }
+  return results;
+}
+
+void addGroupedTermResults(sample_result &data, const spin_op &H) {
+  const auto names = data.register_names();
+  std::unordered_set<std::string> registers(names.begin(), names.end());
+  const bool missingTerms = std::any_of(H.begin(), H.end(), [&](auto &term) {
+    return !term.is_identity() && !registers.count(term.get_term_id());
+  });
+  if (!missingTerms)
+    return;
+
+  for (const auto &group :
+       groupMeasurements(H, MeasurementGrouping::qubit_wise)) {
+    if (!registers.count(group.name))
+      continue;
+    ExecutionResult groupResult(data.to_map(group.name), group.name);
+    groupResult.sequentialData = data.sequential_data(group.name);
+    for (auto &result :
+         getTermResults(group, groupResult, group.measuredQubits))
+      if (registers.insert(result.registerName).second)
+        data.append(result);
+  }
+}
+
+} // namespace cudaq
@@ -0,0 +1,103 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include "MeasureCounts.h"
+#include "cudaq/operators.h"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace cudaq {
+
+/// @brief Strategy used to group the terms of a `spin_op` that can be
+/// estimated from the same set of shots in a shot-based `observe`.
+enum class MeasurementGrouping {
+  /// Every term is measured on its own.
+  none,
+  /// Terms are grouped if they commute qubit-wise, i.e., they act with the
+  /// same Pauli on every qubit they share. A group is measured after
+  /// single-qubit basis changes.
+  qubit_wise,
+  /// Terms are grouped if they commute. A group is measured after a Clifford
+  /// circuit that maps all its terms to products of Z.
+  general
+};
+
+/// @brief Environment variable that selects the measurement grouping strategy
+/// for shot-based `observe`. One of `none` (default), `qubit_wise` or
+/// `general`.
+static constexpr const char *MEASUREMENT_GROUPING_ENV =
+    "CUDAQ_OBSERVE_GROUPING";
+
+/// @brief Return the measurement grouping strategy requested through the
+/// `CUDAQ_OBSERVE_GROUPING` environment variable.
+MeasurementGrouping getMeasurementGrouping();
+
+/// @brief A set of terms of a `spin_op` that are estimated from the same
+/// measurement.
+struct MeasurementGroup {
+  /// @brief A gate of the basis change circuit. Controlled gates have a single
+  /// control.
+  struct Gate {
+    std::string name;
+    std::vector<std::size_t> controls;
+    std::size_t target;
+  };
+
+  /// @brief A term of the group, estimated as the parity of the Z
+  /// measurements of `qubits` after the basis change, negated if `negate`.
+  struct Term {
+    spin_op_term term;
+    std::vector<std::size_t> qubits;
+    bool negate = false;
+  };
+
+  /// @brief Name of the register holding the group measurement results.
+  std::string name;
+
+  /// @brief For qubit-wise commuting groups, the Pauli measured on each qubit.
+  /// Measuring this term measures all the terms of the group.
+  std::optional<spin_op_term> basis;
+
+  /// @brief For general groups, the Clifford circuit that maps every term of
+  /// the group to a product of Z (up to a sign), applied before measuring
+  /// `measuredQubits` in the Z basis.
+  std::vector<Gate> basisChange;
+
+  /// @brief The qubits measured for this group, in increasing order.
+  std::vector<std::size_t> measuredQubits;
+
+  /// @brief The terms of the group.
+  std::vector<Term> terms;
+};
+
+/// @brief Group the non-identity terms of \p H according to \p grouping.
+/// Groups are formed greedily, by visiting the terms in decreasing order of
+/// the number of terms they conflict with (largest-first graph coloring).
+std::vector<MeasurementGroup> groupMeasurements(const spin_op &H,
+                                                MeasurementGrouping grouping);
+
+/// @brief Compute the measurement results and expectation values of every term
+/// of \p group from the group results \p groupResult, whose bit `i` is the Z
+/// measurement of `bitQubits[i]`. Results of terms whose name matches the group
+/// register are not duplicated.
+std::vector<ExecutionResult>
+getTermResults(const MeasurementGroup &group,
+               const ExecutionResult &groupResult,
+               const std::vector<std::size_t> &bitQubits);
+
+/// @brief Shot-based `observe` may have measured the terms of \p H in
+/// qubit-wise commuting groups, with one register per group. Add a register
+/// for every term of \p H that was measured as part of such a group to
+/// \p data, such that all terms can be looked up by their term id.
+void addGroupedTermResults(sample_result &data, const spin_op &H);
+
+} // namespace cudaq
@@ -236,6 +236,7 @@ void noise_model::add_channel(const std::string &quantumOp,
     cudaq::info("Adding new kraus_channel to noise_model ({}, {})", quantumOp,
                 qubits);
     noiseModel.insert({key, {channel}});
+    channelLookupCache.clear();
     return;
   }
 
@@ -244,6 +245,7 @@ void noise_model::add_channel(const std::string &quantumOp,
               quantumOp, qubits);
 
   iter->second.push_back(channel);
+  channelLookupCache.clear();
 }
 
 void noise_model::add_all_qubit_channel(const std::string &quantumOp,
@@ -278,6 +280,7 @@ void noise_model::add_all_qubit_channel(const std::string &quantumOp,
                 "of control bits = {})",
                 actualGateName, numControls);
     defaultNoiseModel.insert({key, {channel}});
+    channelLookupCache.clear();
     return;
   }
 
@@ -286,6 +289,7 @@ void noise_model::add_all_qubit_channel(const std::string &quantumOp,
               actualGateName, numControls);
 
   iter->second.push_back(channel);
+  channelLookupCache.clear();
 }
 
 void noise_model::add_channel(const std::string &quantumOp,
@@ -300,6 +304,7 @@ void noise_model::add_channel(const std::string &quantumOp,
     cudaq::info("Adding new callback kraus_channel to noise_model for {}.",
                 quantumOp);
     gatePredicates.insert({quantumOp, pred});
+    channelLookupCache.clear();
     return;
   }
 
@@ -312,6 +317,48 @@ noise_model::get_channels(const std::string &quantumOp,
                           const std::vector<std::size_t> &targetQubits,
                           const std::vector<std::size_t> &controlQubits,
                           const std::vector<double> &params) const {
+  return *lookup_channels(quantumOp, targetQubits, controlQubits, params);
+}
+
+std::shared_ptr<const std::vector<kraus_channel>>
+noise_model::lookup_channels(const std::string &quantumOp,
+                             const std::vector<std::size_t> &targetQubits,
+                             const std::vector<std::size_t> &controlQubits,
+                             const std::vector<double> &params) const {
+  ChannelLookupKey key{quantumOp,
+                       {controlQubits.begin(), controlQubits.end()},
+                       controlQubits.size(),
+                       {}};
+  key.qubits.insert(key.qubits.end(), targetQubits.begin(),
+                    targetQubits.end());
+  // Only callback channels depend on the gate parameters.
+  if (gatePredicates.contains(quantumOp))
+    key.params = params;
+
+  {
+    std::lock_guard<std::mutex> lock(channelLookupCache.mutex);
+    auto iter = channelLookupCache.entries.find(key);
+    if (iter != channelLookupCache.entries.end())
+      return iter->second;
+  }
+
+  // Compute outside of the lock, callbacks may be slow (e.g., Python).
+  auto channels = std::make_shared<const std::vector<kraus_channel>>(
+      compute_channels(quantumOp, targetQubits, controlQubits, params));
+
+  std::lock_guard<std::mutex> lock(channelLookupCache.mutex);
+  auto &entries = channelLookupCache.entries;
+  if (entries.size() >= maxCachedChannelLookups)
+    entries.clear();
+  return entries.try_emplace(std::move(key), std::move(channels))
+      .first->second;
+}
+
+std::vector<kraus_channel>
+noise_model::compute_channels(const std::string &quantumOp,
+                              const std::vector<std::size_t> &targetQubits,
+                              const std::vector<std::size_t> &controlQubits,
+                              const std::vector<double> &params) const {
   std::vector<std::size_t> qubits{controlQubits.begin(), controlQubits.end()};
   qubits.insert(qubits.end(), targetQubits.begin(), targetQubits.end());
   const auto verifyChannelDimension =
@@ -14,6 +14,8 @@
 #include <cstdint>
 #include <functional>
 #include <math.h>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <variant>
 #include <vector>
@@ -386,6 +388,62 @@ protected:
                    std::function<kraus_channel(const std::vector<double> &)>>>
       registeredChannels;
 
+  /// @brief Key of a memoized `get_channels` lookup. The gate parameters are
+  /// only part of the key if a callback channel is defined for the gate.
+  struct ChannelLookupKey {
+    std::string name;
+    std::vector<std::size_t> qubits;
+    std::size_t numControls;
+    std::vector<double> params;
+    bool operator==(const ChannelLookupKey &other) const = default;
+  };
+
+  struct ChannelLookupKeyHash {
+    std::size_t operator()(const ChannelLookupKey &key) const {
+      auto hash = std::hash<std::string>{}(key.name);
+      hash ^= key.numControls + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+      for (auto &i : key.qubits)
+        hash ^= i + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+      for (auto &p : key.params)
+        hash ^= std::hash<double>{}(p) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+      return hash;
+    }
+  };
+
+  using ChannelsPtr = std::shared_ptr<const std::vector<kraus_channel>>;
+
+  /// @brief Memoized `get_channels` lookups, cleared whenever a channel is
+  /// added. A copied noise model starts with an empty cache.
+  struct ChannelLookupCache {
+    std::mutex mutex;
+    std::unordered_map<ChannelLookupKey, ChannelsPtr, ChannelLookupKeyHash>
+        entries;
+    ChannelLookupCache() = default;
+    ChannelLookupCache(const ChannelLookupCache &) {}
+    ChannelLookupCache &operator=(const ChannelLookupCache &) {
+      clear();
+      return *this;
+    }
+    void clear() {
+      std::lock_guard<std::mutex> lock(mutex);
+      entries.clear();
+    }
+  };
+
+  /// @brief Maximum number of memoized lookups. Callback channels are memoized
+  /// per gate parameters, which may take many distinct values (e.g., rotation
+  /// angles), so the cache is dropped when it grows past this size.
+  static constexpr std::size_t maxCachedChannelLookups = 1 << 16;
+
+  mutable ChannelLookupCache channelLookupCache;
+
+  /// @brief Compute the `get_channels` result, without memoization.
+  std::vector<kraus_channel>
+  compute_channels(const std::string &quantumOp,
+                   const std::vector<std::size_t> &targetQubits,
+                   const std::vector<std::size_t> &controlQubits,
+                   const std::vector<double> &params) const;
+
 public:
   /// @brief default constructor
   noise_model();
@@ -410,6 +468,8 @@ public:
   // parameters whenever the specified quantum operation is executed. The
   // callback function should return a concrete noise channel. This can be an
   // empty noise channel if no noise is expected.
+  // The returned channel is memoized per gate operands and parameters, hence
+  // the callback should only depend on its arguments.
   /// @param quantumOp Quantum operation that the noise channel applies to.
   /// @param pred Callback function that generates a noise channel.
   void add_channel(const std::string &quantumOp, const PredicateFuncTy &pred);
@@ -567,6 +627,16 @@ public:
                const std::vector<std::size_t> &controlQubits = {},
                const std::vector<double> &params = {}) const;
 
+  /// @brief Return the same kraus_channels as `get_channels`, without copying
+  /// them. Lookups are memoized, so this is meant for simulators querying the
+  /// noise model after every gate. The returned channels are immutable and
+  /// remain valid even if the noise model changes.
+  std::shared_ptr<const std::vector<kraus_channel>>
+  lookup_channels(const std::string &quantumOp,
+                  const std::vector<std::size_t> &targetQubits,
+                  const std::vector<std::size_t> &controlQubits = {},
+                  const std::vector<double> &params = {}) const;
+
   /// @brief Get all kraus_channels on the given qubits
   template <typename QuantumOp>
   std::vector<kraus_channel>
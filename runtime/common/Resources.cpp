@@ -9,6 +9,7 @@
 #include "Resources.h"
 #include "common/FmtCore.h"
 #include <algorithm>
+#include <cassert>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
@@ -17,21 +18,23 @@ namespace cudaq {
 
 Resources Resources::compute(const Trace &trace) {
   Resources resources;
+  for (const auto &inst : trace)
+    resources.appendInstruction(inst.name, inst.controls, inst.targets);
+  return resources;
+}
 
-  auto convertToID = [](std::vector<QuditInfo> qudits) {
-    std::vector<std::size_t> ids;
-    ids.reserve(qudits.size());
-    std::transform(qudits.cbegin(), qudits.cend(), std::back_inserter(ids),
-                   [](auto &q) { return q.id; });
-    return ids;
-  };
-  for (const auto &inst : trace) {
-    auto controlIDs = convertToID(inst.controls);
-    auto targetIDs = convertToID(inst.targets);
-    resources.appendInstruction(
-        Instruction(inst.name, controlIDs, targetIDs[0]));
+template <typename Iterator>
+void Resources::updateDepth(Iterator begin, Iterator end) {
+  std::size_t layer = 0;
+  for (auto iter = begin; iter != end; ++iter) {
+    if (*iter >= qubitDepths.size())
+      qubitDepths.resize(*iter + 1, 0);
+    layer = std::max(layer, qubitDepths[*iter]);
   }
-  return resources;
+  ++layer;
+  for (auto iter = begin; iter != end; ++iter)
+    qubitDepths[*iter] = layer;
+  circuitDepth = std::max(circuitDepth, layer);
 }
 
 std::size_t
@@ -92,6 +95,33 @@ void Resources::appendInstruction(const Resources::Instruction &instruction) {
     instructions.insert(std::make_pair(instruction, 1));
   else
     iter->second++;
+
+  std::vector<std::size_t> qubits(instruction.controls);
+  qubits.push_back(instruction.target);
+  updateDepth(qubits.begin(), qubits.end());
+}
+
+void Resources::appendInstruction(std::string_view name,
+                                  const std::vector<QuditInfo> &controls,
+                                  const std::vector<QuditInfo> &targets) {
+  assert(!targets.empty() && "An instruction must have at least one target");
+  Instruction instruction(std::string(name), targets.front().id);
+  instruction.controls.reserve(controls.size());
+  for (const auto &control : controls)
+    instruction.controls.push_back(control.id);
+
+  auto iter = instructions.find(instruction);
+  if (iter == instructions.end())
+    instructions.emplace(std::move(instruction), 1);
+  else
+    iter->second++;
+
+  std::vector<std::size_t> qubits;
+  qubits.reserve(controls.size() + targets.size());
+  for (const auto &qudits : {&controls, &targets})
+    for (const auto &qudit : *qudits)
+      qubits.push_back(qudit.id);
+  updateDepth(qubits.begin(), qubits.end());
 }
 
 void Resources::dump(std::ostream &os) const {
@@ -145,6 +175,7 @@ void Resources::dump(std::ostream &os) const {
   os << "Number of qubits required: " << numQubits << "\n";
   os << "Total Operations: " << totalNumberGates << "\n";
   os << "Total Control Operations: " << totalCtrlOperations << "\n";
+  os << "Circuit Depth: " << circuitDepth << "\n";
   os << "Operation Count Report: \n";
   os << stream.str();
 }
@@ -91,9 +91,26 @@ public:
   /// @brief Return the total number of operations
   std::size_t count() const;
 
+  /// @brief Return the number of qubits used by the kernel, i.e., one more
+  /// than the largest qubit index used.
+  std::size_t num_qubits() const { return qubitDepths.size(); }
+
+  /// @brief Return the depth of the kernel, i.e., the number of layers of
+  /// operations when each operation starts as soon as all its qubits are
+  /// available.
+  std::size_t depth() const { return circuitDepth; }
+
   /// @brief Append the given instruction to the resource estimate.
   void appendInstruction(const Instruction &instruction);
 
+  /// @brief Append the instruction with the given name acting on the given
+  /// qudits to the resource estimate. Like `compute`, only the first target
+  /// is recorded in the instruction, but all the qudits contribute to the
+  /// depth.
+  void appendInstruction(std::string_view name,
+                         const std::vector<QuditInfo> &controls,
+                         const std::vector<QuditInfo> &targets);
+
   /// @brief Dump resource count to the given output stream
   void dump(std::ostream &os) const;
   void dump() const;
@@ -102,6 +119,17 @@ private:
   /// @brief Map of Instructions in the current kernel to the
   /// number of times the Instruction is used.
   std::unordered_map<Instruction, std::size_t, InstructionHash> instructions;
+
+  /// @brief Number of operations applied so far to each qubit, along the
+  /// longest path through the circuit.
+  std::vector<std::size_t> qubitDepths;
+
+  /// @brief The largest entry of `qubitDepths`.
+  std::size_t circuitDepth = 0;
+
+  /// @brief Account for an operation on the given qubits in the depth.
+  template <typename Iterator>
+  void updateDepth(Iterator begin, Iterator end);
 };
 
 } // namespace cudaq
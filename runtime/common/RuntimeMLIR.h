@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "llvm/Support/CodeGen.h"
 #include "mlir/Tools/mlir-translate/Translation.h"
 #include <memory>
 
@@ -43,6 +44,19 @@ bool setupTargetTriple(llvm::Module *);
 /// @brief Run the LLVM PassManager.
 void optimizeLLVM(llvm::Module *);
 
+/// @brief Optimization level of the JIT code generation.
+static constexpr llvm::CodeGenOpt::Level JIT_CODEGEN_OPT_LEVEL =
+    llvm::CodeGenOpt::None;
+
+/// @brief LLVM command line option set by `disableFastInstructionSelection`.
+static constexpr const char *JIT_FAST_ISEL_OPTION = "-fast-isel=0";
+
+/// @brief Disable the "fast" instruction selection of LLVM for the JIT code
+/// generation. This sets a process-wide LLVM command line option, so all the
+/// JIT compilations, including the ones on background threads, go through
+/// this function.
+void disableFastInstructionSelection();
+
 /// @brief Lower ModuleOp to a full QIR LLVMIR representation
 /// and return an ExecutionEngine pointer for JIT function pointer
 /// execution. Clients are responsible for deleting this pointer.
@@ -43,6 +43,7 @@
 #include "mlir/Target/LLVMIR/Dialect/LLVMIR/LLVMToLLVMIRTranslation.h"
 #include "mlir/Target/LLVMIR/Export.h"
 #include "mlir/Tools/ParseUtilities.h"
+#include <mutex>
 
 namespace cudaq {
 
@@ -637,8 +638,7 @@ void insertSetupAndCleanupOperations(mlir::Operation *module) {
   }
 }
 
-mlir::ExecutionEngine *createQIRJITEngine(mlir::ModuleOp &moduleOp,
-                                          llvm::StringRef convertTo) {
+void disableFastInstructionSelection() {
   // The "fast" instruction selection compilation algorithm is actually very
   // slow for large quantum circuits. Disable that here. Revisit this
   // decision by testing large UCCSD circuits if jitCodeGenOptLevel is changed
@@ -646,13 +646,21 @@ mlir::ExecutionEngine *createQIRJITEngine(mlir::ModuleOp &moduleOp,
   // setO0WantsFastISel() do not retain their values in our current version of
   // LLVM. This use of LLVM command line parameters could be changed if the LLVM
   // JIT ever supports the TargetMachine options in the future.
-  ScopedTraceWithContext(cudaq::TIMING_JIT, "createQIRJITEngine");
-  const char *argv[] = {"", "-fast-isel=0", nullptr};
+  // The options are global, and parsing them is not thread safe.
+  static std::mutex optionsMutex;
+  std::scoped_lock<std::mutex> lock(optionsMutex);
+  const char *argv[] = {"", cudaq::JIT_FAST_ISEL_OPTION, nullptr};
   llvm::cl::ParseCommandLineOptions(2, argv);
+}
+
+mlir::ExecutionEngine *createQIRJITEngine(mlir::ModuleOp &moduleOp,
+                                          llvm::StringRef convertTo) {
+  ScopedTraceWithContext(cudaq::TIMING_JIT, "createQIRJITEngine");
+  disableFastInstructionSelection();
 
   mlir::ExecutionEngineOptions opts;
   opts.transformer = [](llvm::Module *m) { return llvm::ErrorSuccess(); };
-  opts.jitCodeGenOptLevel = llvm::CodeGenOpt::None;
+  opts.jitCodeGenOptLevel = cudaq::JIT_CODEGEN_OPT_LEVEL;
   opts.llvmModuleBuilder =
       [convertTo = convertTo.str()](
           mlir::Operation *module,
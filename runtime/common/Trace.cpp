@@ -7,13 +7,14 @@
  ******************************************************************************/
 
 #include "Trace.h"
+#include "Resources.h"
 #include <algorithm>
 #include <cassert>
 
 void cudaq::Trace::appendInstruction(std::string_view name,
-                                     std::vector<double> params,
-                                     std::vector<QuditInfo> controls,
-                                     std::vector<QuditInfo> targets) {
+                                     const std::vector<double> &params,
+                                     const std::vector<QuditInfo> &controls,
+                                     const std::vector<QuditInfo> &targets) {
   assert(!targets.empty() && "An instruction must have at least one target");
   auto findMaxID = [](const std::vector<QuditInfo> &qudits) -> std::size_t {
     return std::max_element(qudits.cbegin(), qudits.cend(),
@@ -24,5 +25,9 @@ void cudaq::Trace::appendInstruction(std::string_view name,
   if (!controls.empty())
     maxID = std::max(maxID, findMaxID(controls));
   numQudits = std::max(numQudits, maxID + 1);
+  if (resourceSink) {
+    resourceSink->appendInstruction(name, controls, targets);
+    return;
+  }
   instructions.emplace_back(name, params, controls, targets);
 }
@@ -15,6 +15,7 @@
 namespace cudaq {
 
 struct QuditInfo;
+class Resources;
 
 /// @brief A trace is a circuit representation of the executed computation, as
 /// seen by the execution manager. (Here, a circuit is represented as a list
@@ -34,9 +35,20 @@ public:
         : name(name), params(params), controls(controls), targets(targets) {}
   };
 
-  void appendInstruction(std::string_view name, std::vector<double> params,
-                         std::vector<QuditInfo> controls,
-                         std::vector<QuditInfo> targets);
+  void appendInstruction(std::string_view name,
+                         const std::vector<double> &params,
+                         const std::vector<QuditInfo> &controls,
+                         const std::vector<QuditInfo> &targets);
+
+  /// @brief Count the instructions appended from now on into \p resources
+  /// instead of recording them, so that the memory used by the trace does not
+  /// grow with the number of instructions. The resources must outlive the
+  /// trace, or a later call with `nullptr` which restores the recording.
+  void streamTo(Resources *resources) { resourceSink = resources; }
+
+  /// @brief Return true if the instructions are counted into resources instead
+  /// of being recorded.
+  bool isStreaming() const { return resourceSink != nullptr; }
 
   auto getNumQudits() const { return numQudits; }
 
@@ -47,6 +59,7 @@ public:
 private:
   std::size_t numQudits = 0;
   std::vector<Instruction> instructions;
+  Resources *resourceSink = nullptr;
 };
 
 } // namespace cudaq
@@ -0,0 +1,269 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "cudaq/algorithms/observe.h"
+#include "common/Logger.h"
+#include "cudaq.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <numeric>
+#include <queue>
+#include <thread>
+
+namespace cudaq::details {
+
+/// @brief Number of chunks per QPU the terms are split into. More chunks give
+/// a finer load balance, at the cost of more kernel launches.
+static constexpr std::size_t chunksPerQpu = 8;
+
+observe_result distributeComputations(
+    std::function<async_observe_result(std::size_t, const spin_op &)>
+        &&asyncLauncher,
+    const spin_op &H, std::size_t nQpus) {
+
+  auto op = cudaq::spin_op::canonicalize(H);
+  // Split the given spin_op into chunks that are picked up by the QPUs as
+  // they become available.
+  const std::size_t numChunks = std::max<std::size_t>(
+      1, std::min(op.num_terms(), nQpus * chunksPerQpu));
+  auto chunks = op.distribute_terms(numChunks);
+
+  struct QpuStats {
+    std::size_t numChunks = 0;
+    std::size_t numTerms = 0;
+    std::chrono::duration<double> busyTime{0};
+  };
+  std::vector<QpuStats> qpuStats(nQpus);
+  std::vector<sample_result> chunkData(chunks.size());
+  std::vector<double> chunkResults(chunks.size(), 0.0);
+
+  std::atomic<std::size_t> nextChunk = 0;
+  // Launches are serialized, as they were when all chunks were launched from
+  // the calling thread. Only the waits for the results overlap.
+  std::mutex launchMutex;
+  std::mutex errorMutex;
+  std::exception_ptr error;
+
+  // Each QPU has a driver thread that runs one chunk at a time on it.
+  auto driveQpu = [&](std::size_t qpuId) {
+    try {
+      for (std::size_t i = nextChunk++; i < chunks.size(); i = nextChunk++) {
+        const auto start = std::chrono::steady_clock::now();
+        async_observe_result asyncResult = [&]() {
+          std::scoped_lock lock(launchMutex);
+          return asyncLauncher(qpuId, chunks[i]);
+        }();
+        auto res = asyncResult.get();
+        chunkData[i] = res.raw_data();
+        chunkResults[i] = chunkData[i].expectation();
+
+        auto &stats = qpuStats[qpuId];
+        stats.numChunks++;
+        stats.numTerms += chunks[i].num_terms();
+        stats.busyTime += std::chrono::steady_clock::now() - start;
+      }
+    } catch (...) {
+      std::scoped_lock lock(errorMutex);
+      if (!error)
+        error = std::current_exception();
+      // Stop handing out chunks.
+      nextChunk = chunks.size();
+    }
+  };
+
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> drivers;
+  drivers.reserve(nQpus);
+  for (std::size_t qpuId = 0; qpuId < nQpus; qpuId++)
+    drivers.emplace_back(driveQpu, qpuId);
+  for (auto &driver : drivers)
+    driver.join();
+  const std::chrono::duration<double> wallTime =
+      std::chrono::steady_clock::now() - start;
+
+  if (error)
+    std::rethrow_exception(error);
+
+  for (std::size_t qpuId = 0; qpuId < nQpus; qpuId++) {
+    const auto &stats = qpuStats[qpuId];
+    cudaq::info("[observe] QPU {}: {} chunks, {} terms, busy {:.3f} s of "
+                "{:.3f} s ({:.1f}% utilization)",
+                qpuId, stats.numChunks, stats.numTerms,
+                stats.busyTime.count(), wallTime.count(),
+                wallTime.count() > 0.0
+                    ? 100.0 * stats.busyTime.count() / wallTime.count()
+                    : 100.0);
+  }
+
+  // Combine the results in chunk order, independently of which QPU ran them.
+  double result = 0.0;
+  sample_result data;
+  for (std::size_t i = 0; i < chunks.size(); i++) {
+    result += chunkResults[i];
+    data += chunkData[i];
+  }
+
+  return observe_result(result, op, data);
+}
+
+std::vector<spin_op> distributeTermsByCost(const spin_op &H,
+                                           std::size_t numParts) {
+  struct Term {
+    spin_op_term term;
+    std::string id;
+    std::size_t cost;
+  };
+  std::vector<Term> terms;
+  terms.reserve(H.num_terms());
+  for (const auto &term : H) {
+    const auto word = term.get_pauli_word();
+    // Every term has a fixed cost (e.g., a kernel launch), on top of the
+    // basis change and measurement of each non-identity Pauli.
+    const std::size_t cost =
+        1 + std::count_if(word.begin(), word.end(),
+                          [](char pauli) { return pauli != 'I'; });
+    terms.push_back({term, term.get_term_id(), cost});
+  }
+  // Break ties on the term id, such that the split does not depend on the
+  // order of the terms.
+  std::sort(terms.begin(), terms.end(), [](const Term &a, const Term &b) {
+    return a.cost != b.cost ? a.cost > b.cost : a.id < b.id;
+  });
+
+  std::vector<spin_op> parts(numParts, spin_op::empty());
+  // Min-heap of (total cost, part index), the lowest index wins ties.
+  using Load = std::pair<std::size_t, std::size_t>;
+  std::priority_queue<Load, std::vector<Load>, std::greater<Load>> loads;
+  for (std::size_t i = 0; i < numParts; i++)
+    loads.emplace(0, i);
+  for (auto &term : terms) {
+    auto [load, part] = loads.top();
+    loads.pop();
+    parts[part] += std::move(term.term);
+    loads.emplace(load + term.cost, part);
+  }
+  return parts;
+}
+
+namespace {
+/// Binary encoding of the per-term results of a rank: its expectation value,
+/// the number of registers, and for each register its name, its expectation
+/// value and its counts.
+class PackedRankResult {
+public:
+  static std::string pack(double expectation, const sample_result &data) {
+    PackedRankResult packed;
+    packed.write(expectation);
+    auto names = data.register_names();
+    std::erase(names, GlobalRegisterName);
+    packed.write<std::uint64_t>(names.size());
+    for (const auto &name : names) {
+      packed.write(name);
+      packed.write(data.expectation(name));
+      auto counts = data.to_map(name);
+      packed.write<std::uint64_t>(counts.size());
+      for (const auto &[bits, count] : counts) {
+        packed.write(bits);
+        packed.write<std::uint64_t>(count);
+      }
+    }
+    return std::move(packed.buffer);
+  }
+
+  /// Unpack the rank results of `buffer` into `results`, returns the
+  /// expectation value of the rank.
+  static double unpack(const std::string &buffer,
+                       std::vector<ExecutionResult> &results) {
+    PackedRankResult packed;
+    packed.buffer = buffer;
+    const auto expectation = packed.read<double>();
+    const auto numRegisters = packed.read<std::uint64_t>();
+    for (std::uint64_t i = 0; i < numRegisters; i++) {
+      auto name = packed.readString();
+      const auto registerExpectation = packed.read<double>();
+      CountsDictionary counts;
+      const auto numCounts = packed.read<std::uint64_t>();
+      for (std::uint64_t j = 0; j < numCounts; j++) {
+        auto bits = packed.readString();
+        counts.emplace(std::move(bits), packed.read<std::uint64_t>());
+      }
+      results.emplace_back(std::move(counts), std::move(name),
+                           registerExpectation);
+    }
+    return expectation;
+  }
+
+private:
+  std::string buffer;
+  std::size_t offset = 0;
+
+  template <typename T>
+  void write(const T &value) {
+    buffer.append(reinterpret_cast<const char *>(&value), sizeof(T));
+  }
+  void write(const std::string &str) {
+    write<std::uint64_t>(str.size());
+    buffer.append(str);
+  }
+  template <typename T>
+  T read() {
+    if (offset + sizeof(T) > buffer.size())
+      throw std::runtime_error("Truncated observe result received from an "
+                               "MPI rank.");
+    T value;
+    std::memcpy(&value, buffer.data() + offset, sizeof(T));
+    offset += sizeof(T);
+    return value;
+  }
+  std::string readString() {
+    const auto size = read<std::uint64_t>();
+    if (offset + size > buffer.size())
+      throw std::runtime_error("Truncated observe result received from an "
+                               "MPI rank.");
+    std::string str = buffer.substr(offset, size);
+    offset += size;
+    return str;
+  }
+};
+} // namespace
+
+observe_result distributeRankComputations(
+    std::function<observe_result(const spin_op &)> &&rankObserve,
+    const spin_op &H) {
+  auto op = cudaq::spin_op::canonicalize(H);
+  const auto rank = mpi::rank();
+  const auto nRanks = mpi::num_ranks();
+  auto parts = distributeTermsByCost(op, nRanks);
+
+  // Ranks without terms (more ranks than terms) still take part in the gather.
+  std::string local;
+  if (parts[rank].num_terms() > 0) {
+    auto localResult = rankObserve(parts[rank]);
+    local = PackedRankResult::pack(localResult.expectation(),
+                                   localResult.raw_data());
+  } else {
+    local = PackedRankResult::pack(0.0, sample_result());
+  }
+
+  std::vector<std::string> gathered;
+  mpi::all_gather(gathered, local);
+
+  // Combine the results in rank order, such that all ranks agree on the
+  // global expectation value.
+  double expectation = 0.0;
+  std::vector<ExecutionResult> results;
+  for (const auto &rankResult : gathered)
+    expectation += PackedRankResult::unpack(rankResult, results);
+  return observe_result(expectation, op, sample_result(expectation, results));
+}
+
+} // namespace cudaq::details
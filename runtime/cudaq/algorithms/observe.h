@@ -10,6 +10,7 @@
 
 #include "common/ExecutionContext.h"
 #include "common/KernelWrapper.h"
+#include "common/MeasurementGrouping.h"
 #include "common/ObserveResult.h"
 #include "cudaq/algorithms/broadcast.h"
 #include "cudaq/concepts.h"
@@ -121,7 +122,9 @@ runObservation(KernelFunctor &&k, const cudaq::spin_op &H,
   if (ctx->expectationValue.has_value())
     expectationValue = ctx->expectationValue.value_or(0.0);
   else {
-    // If not, we have everything we need to compute it.
+    // If not, we have everything we need to compute it. The terms may have
+    // been measured in groups, recover their results first.
+    addGroupedTermResults(data, ctx->spin.value());
     double sum = 0.0;
     for (const auto &term : ctx->spin.value()) {
       if (term.is_identity())
@@ -180,40 +183,32 @@ auto runObservationAsync(KernelFunctor &&wrappedKernel, const spin_op &H,
 /// @brief Distribute the expectation value computations among the
 /// available platform QPUs. The `asyncLauncher` functor takes as input the
 /// QPU index and the `spin_op` chunk and returns an `async_observe_result`.
-inline auto distributeComputations(
+///
+/// The terms are split into many small chunks, which are handed out to the
+/// QPUs on demand: each QPU picks up the next pending chunk as soon as it is
+/// done with the previous one. Faster QPUs and cheaper chunks thus do not
+/// leave QPUs idle while the slowest chunk completes. The per-QPU utilization
+/// is reported in the `info` log.
+observe_result distributeComputations(
     std::function<async_observe_result(std::size_t, const spin_op &)>
         &&asyncLauncher,
-    const spin_op &H, std::size_t nQpus) {
-
-  auto op = cudaq::spin_op::canonicalize(H);
-  // Distribute the given spin_op into subsets for each QPU
-  auto spins = op.distribute_terms(nQpus);
-
-  // Observe each sub-spin_op asynchronously
-  std::vector<async_observe_result> asyncResults;
-#if CUDAQ_USE_STD20
-  for (std::size_t i = 0; auto &op : spins) {
-#else
-  std::size_t i = 0;
-  for (auto &op : spins) {
-#endif
-    asyncResults.emplace_back(asyncLauncher(i, op));
-    i++;
-  }
-
-  // Wait for the results, should be executing
-  // in parallel on the available QPUs.
-  double result = 0.0;
-  sample_result data;
-  for (auto &asyncResult : asyncResults) {
-    auto res = asyncResult.get();
-    auto incomingData = res.raw_data();
-    result += incomingData.expectation();
-    data += incomingData;
-  }
-
-  return observe_result(result, op, data);
-}
+    const spin_op &H, std::size_t nQpus);
+
+/// @brief Split the terms of `H` into `numParts` sums of terms of similar
+/// cost. The cost of a term is estimated from its number of non-identity Pauli
+/// operators, and terms are assigned greedily, costliest first, to the part
+/// with the lowest total cost. The split only depends on `H`, such that all the
+/// MPI ranks agree on it.
+std::vector<spin_op> distributeTermsByCost(const spin_op &H,
+                                           std::size_t numParts);
+
+/// @brief Distribute the expectation value computations among the MPI ranks.
+/// Each rank computes its share of the terms of `H` with `rankObserve`, and the
+/// per-term results of all ranks are gathered on every rank, such that each
+/// rank returns the complete `observe_result`.
+observe_result distributeRankComputations(
+    std::function<observe_result(const spin_op &)> &&rankObserve,
+    const spin_op &H);
 
 } // namespace details
 
@@ -339,8 +334,9 @@ observe_result observe(std::size_t shots, QuantumKernel &&kernel,
             std::size_t i, const spin_op &op) mutable {
           return std::apply(
               [&](auto &&...args) {
-                observe_async(shots, i, std::forward<QuantumKernel>(kernel), op,
-                              std::forward<Args>(args)...);
+                return observe_async(shots, i,
+                                     std::forward<QuantumKernel>(kernel), op,
+                                     std::forward<Args>(args)...);
               },
               std::move(args));
         },
@@ -359,47 +355,34 @@ observe_result observe(std::size_t shots, QuantumKernel &&kernel,
     // FIXME, how do we handle an mpi run where each rank
     // is targeting the same GPU? Should we even allow that?
 
-    // Get the rank and the number of ranks
-    auto rank = mpi::rank();
-    auto nRanks = mpi::num_ranks();
-
-    // Each rank gets a subset of the spin terms
-    auto spins = H.distribute_terms(nRanks);
-
-    // Get this rank's set of spins to compute
-    auto localH = spins[rank].canonicalize();
-
-    // Distribute locally, i.e. to the local nodes QPUs
-    auto localRankResult = details::distributeComputations(
+    // Each rank gets a cost-balanced subset of the spin terms, and
+    // distributes them locally, i.e. to the local node's QPUs
+    return details::distributeRankComputations(
+        [&](const spin_op &localH) {
+          return details::distributeComputations(
 #if CUDAQ_USE_STD20
-        [&kernel, shots, ... args = std::forward<Args>(args)](
-            std::size_t i, const spin_op &op) mutable {
-          return observe_async(shots, i, std::forward<QuantumKernel>(kernel),
-                               op, std::forward<Args>(args)...);
-        },
+              [&kernel, shots, ... args = std::forward<Args>(args)](
+                  std::size_t i, const spin_op &op) mutable {
+                return observe_async(shots, i,
+                                     std::forward<QuantumKernel>(kernel), op,
+                                     std::forward<Args>(args)...);
+              },
 #else
-        [&kernel, shots,
-         args = std::forward_as_tuple(std::forward<Args>(args)...)](
-            std::size_t i, const spin_op &op) mutable {
-          return std::apply(
-              [&](auto &&...args) {
-                observe_async(shots, i, std::forward<QuantumKernel>(kernel), op,
-                              std::forward<Args>(args)...);
+              [&kernel, shots,
+               args = std::forward_as_tuple(std::forward<Args>(args)...)](
+                  std::size_t i, const spin_op &op) mutable {
+                return std::apply(
+                    [&](auto &&...args) {
+                      return observe_async(
+                          shots, i, std::forward<QuantumKernel>(kernel), op,
+                          std::forward<Args>(args)...);
+                    },
+                    std::move(args));
               },
-              std::move(args));
-        },
 #endif
-        localH, nQpus);
-
-    // combine all the data via an all_reduce
-    auto exp_val = localRankResult.expectation();
-    auto globalExpVal = mpi::all_reduce(exp_val, std::plus<double>());
-    // we need the canonicalized version of H -
-    // maybe we can get it from the context instead?
-    cudaq::spin_op canonH;
-    for (auto &&terms : spins)
-      canonH += std::move(terms);
-    return observe_result(globalExpVal, canonH);
+              localH, nQpus);
+        },
+        H);
 
   } else
     throw std::runtime_error("Invalid cudaq::par execution type.");
@@ -455,8 +438,9 @@ observe_result observe(std::size_t shots, QuantumKernel &&kernel,
             std::size_t i, const spin_op &op) mutable {
           return std::apply(
               [&](auto &&...args) {
-                observe_async(shots, i, std::forward<QuantumKernel>(kernel), op,
-                              std::forward<Args>(args)...);
+                return observe_async(shots, i,
+                                     std::forward<QuantumKernel>(kernel), op,
+                                     std::forward<Args>(args)...);
               },
               std::move(args));
         },
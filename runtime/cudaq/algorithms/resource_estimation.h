@@ -18,15 +18,18 @@ namespace cudaq {
 /// return the resources that this kernel will use. This does not execute the
 /// circuit simulation, it only traces the quantum operation calls and returns
 /// a `resources` type that allows the programmer to query the number and types
-/// of operations in the kernel.
+/// of operations in the kernel. The operations are counted as they are traced,
+/// so the memory used does not grow with the length of the kernel.
 template <typename QuantumKernel, typename... Args>
 auto estimate_resources(QuantumKernel &&kernel, Args &&...args) {
   ExecutionContext context("tracer");
+  Resources resources;
+  context.kernelTrace.streamTo(&resources);
   auto &platform = get_platform();
   platform.set_exec_ctx(&context);
   kernel(args...);
   platform.reset_exec_ctx();
-  return cudaq::Resources::compute(context.kernelTrace);
+  return resources;
 }
 
 } // namespace cudaq
@@ -0,0 +1,155 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "cudaq/algorithms/sample.h"
+#include "common/Logger.h"
+#include "cudaq.h"
+#include "cudaq/qis/execution_manager.h"
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <exception>
+#include <mutex>
+#include <random>
+#include <thread>
+
+namespace nvqir {
+class CircuitSimulator;
+CircuitSimulator *getCircuitSimulatorInternal();
+void cloneCircuitSimulatorForThread(CircuitSimulator *);
+bool canSimulateShotsConcurrently();
+void setInstanceRandomSeed(std::size_t);
+} // namespace nvqir
+
+namespace cudaq::details {
+
+/// @brief Environment variable name that sets the number of threads the shots
+/// of a kernel with conditional feedback are spread over. Unset or 1 runs the
+/// shots serially, 0 uses all hardware threads.
+static constexpr const char shotThreadsEnvVar[] =
+    "CUDAQ_PARALLEL_SHOT_THREADS";
+
+/// @brief Number of sampling calls that ran their shots on several threads.
+static std::atomic<std::size_t> numShotParallelSamplings = 0;
+
+std::size_t getNumShotParallelSamplings() { return numShotParallelSamplings; }
+
+std::size_t getNumShotThreads(quantum_platform &platform, std::size_t qpu_id,
+                              std::size_t shots) {
+  const char *envVal = std::getenv(shotThreadsEnvVar);
+  if (!envVal)
+    return 1;
+  const std::string numThreadsStr(envVal);
+  char *endptr = nullptr;
+  errno = 0;
+  const long value = std::strtol(numThreadsStr.c_str(), &endptr, 10);
+  if (endptr == numThreadsStr.c_str() || errno != 0 || value < 0)
+    throw std::runtime_error(
+        std::string("Invalid ") + shotThreadsEnvVar +
+        " setting. Expected a non-negative number. Got: " + numThreadsStr);
+  std::size_t numThreads = value == 0 ? std::thread::hardware_concurrency()
+                                      : static_cast<std::size_t>(value);
+
+  // Worker threads launch kernels directly on their own simulator, which is
+  // only possible for a single local simulated QPU whose execution manager is
+  // thread-local, and a backend whose clones do not share random numbers.
+  if (platform.num_qpus() != 1 || !platform.is_simulator(qpu_id) ||
+      platform.is_remote(qpu_id) || platform.is_emulated(qpu_id) ||
+      getExecutionManagerInternal() || !nvqir::canSimulateShotsConcurrently())
+    return 1;
+
+  return std::max<std::size_t>(1, std::min(numThreads, shots));
+}
+
+sample_result runShotParallelSampling(const std::function<void()> &kernel,
+                                      quantum_platform &platform,
+                                      const ExecutionContext &ctx,
+                                      std::size_t shots,
+                                      std::size_t numThreads) {
+  // Give every thread its own random number stream. With a user seed, the
+  // streams (and thus the results) only depend on the seed and the number of
+  // threads.
+  std::vector<std::uint32_t> threadSeeds(numThreads);
+  if (const std::size_t seed = cudaq::get_random_seed(); seed > 0) {
+    std::seed_seq seq{static_cast<std::uint32_t>(seed),
+                      static_cast<std::uint32_t>(seed >> 32)};
+    seq.generate(threadSeeds.begin(), threadSeeds.end());
+  } else {
+    std::random_device device;
+    for (auto &threadSeed : threadSeeds)
+      threadSeed = device();
+  }
+
+  auto *simulator = nvqir::getCircuitSimulatorInternal();
+  const auto *noiseModel = platform.get_noise();
+  std::vector<sample_result> threadCounts(numThreads);
+  std::exception_ptr error;
+  std::mutex errorMutex;
+
+  auto runShots = [&](std::size_t threadId) {
+    try {
+      // Each thread simulates with its own instance of the current backend.
+      nvqir::cloneCircuitSimulatorForThread(simulator);
+      // Only seed the clone, since other threads may use the process-wide
+      // generator of the backend concurrently.
+      nvqir::setInstanceRandomSeed(threadSeeds[threadId]);
+
+      // Split the shots into contiguous ranges, one per thread.
+      const std::size_t threadShots = (threadId + 1) * shots / numThreads -
+                                      threadId * shots / numThreads;
+      ExecutionContext threadCtx("sample", threadShots);
+      threadCtx.kernelName = ctx.kernelName;
+      threadCtx.batchIteration = ctx.batchIteration;
+      threadCtx.totalIterations = ctx.totalIterations;
+      threadCtx.hasConditionalsOnMeasureResults = true;
+      threadCtx.registerNames = ctx.registerNames;
+      threadCtx.noiseModel = noiseModel;
+
+      auto *executionManager = getExecutionManager();
+      auto &counts = threadCounts[threadId];
+      while (counts.get_total_shots() < threadShots) {
+        executionManager->setExecutionContext(&threadCtx);
+        kernel();
+        executionManager->resetExecutionContext();
+        if (threadCtx.result.get_total_shots() == 0) {
+          printf("WARNING: this kernel invocation produced 0 shots worth "
+                 "of results when executed. Exiting shot loop to avoid "
+                 "infinite loop.");
+          break;
+        }
+        counts += threadCtx.result;
+        threadCtx.result.clear();
+      }
+    } catch (...) {
+      std::scoped_lock lock(errorMutex);
+      if (!error)
+        error = std::current_exception();
+    }
+  };
+
+  cudaq::info("Running {} shots of {} on {} threads.", shots, ctx.kernelName,
+              numThreads);
+  numShotParallelSamplings++;
+  std::vector<std::thread> workers;
+  workers.reserve(numThreads);
+  for (std::size_t threadId = 0; threadId < numThreads; threadId++)
+    workers.emplace_back(runShots, threadId);
+  for (auto &worker : workers)
+    worker.join();
+
+  if (error)
+    std::rethrow_exception(error);
+
+  // Combine the results in thread order.
+  sample_result counts = std::move(threadCounts.front());
+  for (std::size_t threadId = 1; threadId < numThreads; threadId++)
+    counts += threadCounts[threadId];
+  return counts;
+}
+
+} // namespace cudaq::details
@@ -34,6 +34,28 @@ concept SampleCallValid =
 
 namespace details {
 
+/// @brief Return the number of threads to run the shots of a kernel with
+/// conditional feedback on, as set by the `CUDAQ_PARALLEL_SHOT_THREADS`
+/// environment variable. Returns 1 (serial execution) if unset, or if the
+/// `qpu_id` QPU of `platform` is not a local simulator.
+std::size_t getNumShotThreads(quantum_platform &platform, std::size_t qpu_id,
+                              std::size_t shots);
+
+/// @brief Return the number of sampling calls whose shots ran on several
+/// threads through `runShotParallelSampling`, e.g., to check that
+/// `CUDAQ_PARALLEL_SHOT_THREADS` took effect.
+std::size_t getNumShotParallelSamplings();
+
+/// @brief Run the `shots` executions of a kernel with conditional feedback on
+/// `numThreads` threads, each with its own simulator and random number stream,
+/// and merge their results. The settings of the executions (kernel name,
+/// register names) are taken from `ctx`.
+sample_result runShotParallelSampling(const std::function<void()> &kernel,
+                                      quantum_platform &platform,
+                                      const ExecutionContext &ctx,
+                                      std::size_t shots,
+                                      std::size_t numThreads);
+
 /// @brief Take the input KernelFunctor (a lambda that captures runtime
 /// arguments and invokes the quantum kernel) and invoke the sampling process.
 template <typename KernelFunctor>
@@ -89,6 +111,14 @@ runSampling(KernelFunctor &&wrappedKernel, quantum_platform &platform,
   }
 #endif
 
+  // Kernels with conditional feedback execute one shot at a time, which can
+  // be spread over several threads of a local simulator.
+  if (ctx->hasConditionalsOnMeasureResults && !futureResult)
+    if (auto numThreads = getNumShotThreads(platform, qpu_id, shots);
+        numThreads > 1)
+      return runShotParallelSampling([&]() { wrappedKernel(); }, platform,
+                                     *ctx, shots, numThreads);
+
   // Indicate that this is an async exec
   ctx->asyncExec = futureResult != nullptr;
 
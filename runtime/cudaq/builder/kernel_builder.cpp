@@ -31,6 +31,7 @@
 #include "mlir/Target/LLVMIR/ModuleTranslation.h"
 #include "mlir/Transforms/Passes.h"
 
+#include <mutex>
 #include <numeric>
 
 using namespace mlir;
@@ -45,6 +46,17 @@ namespace cudaq::details {
 /// @brief Track unique measurement register names.
 static std::size_t regCounter = 0;
 
+namespace {
+/// @brief Builder listener that counts the operations and blocks created with
+/// a kernel builder. The count serves as the version of the kernel's `ModuleOp`
+/// and tells whether the kernel must be JIT compiled again.
+struct ModuleVersionListener : public OpBuilder::Listener {
+  void notifyOperationInserted(Operation *) override { ++version; }
+  void notifyBlockCreated(Block *) override { ++version; }
+  std::size_t version = 0;
+};
+} // namespace
+
 KernelBuilderType convertArgumentTypeToMLIR(double &e) {
   return KernelBuilderType(
       [](MLIRContext *ctx) { return Float64Type::get(ctx); });
@@ -145,6 +157,7 @@ initializeBuilder(MLIRContext *context,
 
   auto location = FileLineColLoc::get(context, "<builder>", 1, 1);
   auto *opBuilder = new ImplicitLocOpBuilder(location, context);
+  opBuilder->setListener(new ModuleVersionListener());
 
   auto moduleOp = opBuilder->create<ModuleOp>();
   opBuilder->setInsertionPointToEnd(moduleOp.getBody());
@@ -181,7 +194,14 @@ initializeBuilder(MLIRContext *context,
   opBuilder->setInsertionPoint(terminator);
   return opBuilder;
 }
-void deleteBuilder(ImplicitLocOpBuilder *builder) { delete builder; }
+void deleteBuilder(ImplicitLocOpBuilder *builder) {
+  delete builder->getListener();
+  delete builder;
+}
+
+std::size_t getModuleVersion(ImplicitLocOpBuilder &builder) {
+  return static_cast<ModuleVersionListener *>(builder.getListener())->version;
+}
 
 bool isArgStdVec(std::vector<QuakeValue> &args, std::size_t idx) {
   return args[idx].isStdVec();
@@ -907,38 +927,15 @@ void tagEntryPoint(ImplicitLocOpBuilder &builder, ModuleOp &module,
   });
 }
 
-std::tuple<bool, ExecutionEngine *>
-jitCode(ImplicitLocOpBuilder &builder, ExecutionEngine *jit,
-        std::unordered_map<ExecutionEngine *, std::size_t> &jitHash,
-        std::string kernelName, std::vector<std::string> extraLibPaths,
-        StateVectorStorage &stateVectorStorage) {
-
+std::function<ExecutionEngine *()>
+prepareJitCode(ImplicitLocOpBuilder &builder, std::string kernelName,
+               std::vector<std::string> extraLibPaths,
+               StateVectorStorage &stateVectorStorage) {
   // Start of by getting the current ModuleOp
   auto *block = builder.getBlock();
-  auto *context = builder.getContext();
   auto *function = block->getParentOp();
   auto currentModule = function->getParentOfType<ModuleOp>();
 
-  // Create a unique hash from that ModuleOp
-  auto hash = llvm::hash_code{0};
-  currentModule.walk([&hash](Operation *op) {
-    hash = llvm::hash_combine(hash, OperationEquivalence::computeHash(op));
-  });
-  auto moduleHash = static_cast<size_t>(hash);
-
-  if (jit) {
-    // Have we added more instructions since the last time we jit the code? If
-    // so, we need to delete this JIT engine and create a new one.
-    if (moduleHash == jitHash[jit])
-      return std::make_tuple(false, jit);
-    else {
-      // need to redo the jit, remove the old one
-      jitHash.erase(jit);
-    }
-  }
-
-  cudaq::info("kernel_builder running jitCode.");
-
   auto module = currentModule.clone();
   auto ctx = module.getContext();
   SmallVector<mlir::NamedAttribute> names;
@@ -950,121 +947,146 @@ jitCode(ImplicitLocOpBuilder &builder, ExecutionEngine *jit,
   // Tag as an entrypoint if it is one
   tagEntryPoint(builder, module, StringRef{});
 
-  {
-    PassManager pm(context);
-    pm.addNestedPass<func::FuncOp>(cudaq::opt::createUnwindLoweringPass());
-    cudaq::opt::addAggressiveEarlyInlining(pm);
-    pm.addPass(createCanonicalizerPass());
-    pm.addPass(cudaq::opt::createApplyOpSpecializationPass());
-    pm.addNestedPass<func::FuncOp>(cudaq::opt::createClassicalMemToReg());
-    pm.addNestedPass<func::FuncOp>(createCanonicalizerPass());
-    pm.addPass(cudaq::opt::createExpandMeasurementsPass());
-    pm.addNestedPass<func::FuncOp>(cudaq::opt::createLoopNormalize());
-    pm.addNestedPass<func::FuncOp>(cudaq::opt::createLoopUnroll());
-    pm.addNestedPass<func::FuncOp>(createCanonicalizerPass());
-    pm.addNestedPass<func::FuncOp>(cudaq::opt::createQuakeAddDeallocs());
-    pm.addNestedPass<func::FuncOp>(cudaq::opt::createQuakeAddMetadata());
-    pm.addNestedPass<func::FuncOp>(createCanonicalizerPass());
-    pm.addNestedPass<func::FuncOp>(createCSEPass());
-    pm.addPass(cudaq::opt::createGenerateDeviceCodeLoader({.jitTime = true}));
-    pm.addPass(cudaq::opt::createGenerateKernelExecution());
-    pm.addPass(createSymbolDCEPass());
-    if (failed(pm.run(module)))
-      throw std::runtime_error(
-          "cudaq::builder failed to JIT compile the Quake representation.");
-  }
-  {
-    // Start a new pipeline. We want the above pipeline to completely flush it's
-    // rewrites before lowering to a raw CFG form. Loop unrolling depends on the
-    // cc.loop op and GKE generates new code which may have cc.loop ops, etc.
-    PassManager pm(context);
-    pm.addNestedPass<func::FuncOp>(cudaq::opt::createLowerToCFGPass());
-    // We want quantum allocations to stay where they are if
-    // we are simulating and have user-provided state vectors.
-    // This check could be better / smarter probably, in tandem
-    // with some synth strategy to rewrite initState with circuit
-    // synthesis result
-    if (stateVectorStorage.empty())
-      pm.addNestedPass<func::FuncOp>(
-          cudaq::opt::createCombineQuantumAllocations());
-    pm.addNestedPass<func::FuncOp>(createCanonicalizerPass());
-    pm.addNestedPass<func::FuncOp>(createCSEPass());
-    pm.addPass(cudaq::opt::createConvertToQIR());
-    pm.addPass(createCanonicalizerPass());
-
-    if (failed(pm.run(module)))
-      throw std::runtime_error(
-          "cudaq::builder failed to JIT compile the Quake representation.");
-  }
+  // The compilation only works on the clone, so the kernel can still be
+  // modified while it runs.
+  return [module, kernelName = std::move(kernelName),
+          extraLibPaths = std::move(extraLibPaths),
+          hasStateVectors = !stateVectorStorage.empty()]() mutable {
+    OwningOpRef<ModuleOp> ownedModule(module);
+    auto *context = module.getContext();
+    cudaq::info("kernel_builder running jitCode.");
+    {
+      PassManager pm(context);
+      pm.addNestedPass<func::FuncOp>(cudaq::opt::createUnwindLoweringPass());
+      cudaq::opt::addAggressiveEarlyInlining(pm);
+      pm.addPass(createCanonicalizerPass());
+      pm.addPass(cudaq::opt::createApplyOpSpecializationPass());
+      pm.addNestedPass<func::FuncOp>(cudaq::opt::createClassicalMemToReg());
+      pm.addNestedPass<func::FuncOp>(createCanonicalizerPass());
+      pm.addPass(cudaq::opt::createExpandMeasurementsPass());
+      pm.addNestedPass<func::FuncOp>(cudaq::opt::createLoopNormalize());
+      pm.addNestedPass<func::FuncOp>(cudaq::opt::createLoopUnroll());
+      pm.addNestedPass<func::FuncOp>(createCanonicalizerPass());
+      pm.addNestedPass<func::FuncOp>(cudaq::opt::createQuakeAddDeallocs());
+      pm.addNestedPass<func::FuncOp>(cudaq::opt::createQuakeAddMetadata());
+      pm.addNestedPass<func::FuncOp>(createCanonicalizerPass());
+      pm.addNestedPass<func::FuncOp>(createCSEPass());
+      pm.addPass(cudaq::opt::createGenerateDeviceCodeLoader({.jitTime = true}));
+      pm.addPass(cudaq::opt::createGenerateKernelExecution());
+      pm.addPass(createSymbolDCEPass());
+      if (failed(pm.run(module)))
+        throw std::runtime_error(
+            "cudaq::builder failed to JIT compile the Quake representation.");
+    }
+    {
+      // Start a new pipeline. We want the above pipeline to completely flush
+      // it's rewrites before lowering to a raw CFG form. Loop unrolling depends
+      // on the cc.loop op and GKE generates new code which may have cc.loop
+      // ops, etc.
+      PassManager pm(context);
+      pm.addNestedPass<func::FuncOp>(cudaq::opt::createLowerToCFGPass());
+      // We want quantum allocations to stay where they are if
+      // we are simulating and have user-provided state vectors.
+      // This check could be better / smarter probably, in tandem
+      // with some synth strategy to rewrite initState with circuit
+      // synthesis result
+      if (!hasStateVectors)
+        pm.addNestedPass<func::FuncOp>(
+            cudaq::opt::createCombineQuantumAllocations());
+      pm.addNestedPass<func::FuncOp>(createCanonicalizerPass());
+      pm.addNestedPass<func::FuncOp>(createCSEPass());
+      pm.addPass(cudaq::opt::createConvertToQIR());
+      pm.addPass(createCanonicalizerPass());
+
+      if (failed(pm.run(module)))
+        throw std::runtime_error(
+            "cudaq::builder failed to JIT compile the Quake representation.");
+    }
 
-  // The "fast" instruction selection compilation algorithm is actually very
-  // slow for large quantum circuits. Disable that here. Revisit this
-  // decision by testing large UCCSD circuits if jitCodeGenOptLevel is changed
-  // in the future. Also note that llvm::TargetMachine::setFastIsel() and
-  // setO0WantsFastISel() do not retain their values in our current version of
-  // LLVM. This use of LLVM command line parameters could be changed if the LLVM
-  // JIT ever supports the TargetMachine options in the future.
-  const char *argv[] = {"", "-fast-isel=0", nullptr};
-  llvm::cl::ParseCommandLineOptions(2, argv);
-
-  cudaq::info("- Pass manager was applied.");
-  ExecutionEngineOptions opts;
-  opts.transformer = [](llvm::Module *m) { return llvm::ErrorSuccess(); };
-  opts.jitCodeGenOptLevel = llvm::CodeGenOpt::None;
-  SmallVector<StringRef, 4> sharedLibs;
-  for (auto &lib : extraLibPaths) {
-    cudaq::info("Extra library loaded: {}", lib);
-    sharedLibs.push_back(lib);
-  }
-  opts.sharedLibPaths = sharedLibs;
-  opts.llvmModuleBuilder =
-      [](Operation *module,
-         llvm::LLVMContext &llvmContext) -> std::unique_ptr<llvm::Module> {
-    llvmContext.setOpaquePointers(false);
-    auto llvmModule = translateModuleToLLVMIR(module, llvmContext);
-    if (!llvmModule) {
-      llvm::errs() << "Failed to emit LLVM IR\n";
-      return nullptr;
+    cudaq::disableFastInstructionSelection();
+
+    cudaq::info("- Pass manager was applied.");
+    ExecutionEngineOptions opts;
+    opts.transformer = [](llvm::Module *m) { return llvm::ErrorSuccess(); };
+    opts.jitCodeGenOptLevel = cudaq::JIT_CODEGEN_OPT_LEVEL;
+    SmallVector<StringRef, 4> sharedLibs;
+    for (auto &lib : extraLibPaths) {
+      cudaq::info("Extra library loaded: {}", lib);
+      sharedLibs.push_back(lib);
     }
-    ExecutionEngine::setupTargetTriple(llvmModule.get());
-    return llvmModule;
-  };
+    opts.sharedLibPaths = sharedLibs;
+    opts.llvmModuleBuilder =
+        [](Operation *module,
+           llvm::LLVMContext &llvmContext) -> std::unique_ptr<llvm::Module> {
+      llvmContext.setOpaquePointers(false);
+      auto llvmModule = translateModuleToLLVMIR(module, llvmContext);
+      if (!llvmModule) {
+        llvm::errs() << "Failed to emit LLVM IR\n";
+        return nullptr;
+      }
+      ExecutionEngine::setupTargetTriple(llvmModule.get());
+      return llvmModule;
+    };
 
-  cudaq::info(" - Creating the MLIR ExecutionEngine");
-  auto jitOrError = ExecutionEngine::create(module, opts);
-  assert(!!jitOrError);
+    cudaq::info(" - Creating the MLIR ExecutionEngine");
+    auto jitOrError = ExecutionEngine::create(module, opts);
+    assert(!!jitOrError);
 
-  auto uniqueJit = std::move(jitOrError.get());
-  jit = uniqueJit.release();
+    auto uniqueJit = std::move(jitOrError.get());
+    auto *jit = uniqueJit.release();
 
-  cudaq::info("- JIT Engine created successfully.");
+    cudaq::info("- JIT Engine created successfully.");
 
-  // Kernel names are __nvqpp__mlirgen__BuilderKernelPTRSTR for the following we
-  // want the proper name, BuilderKernelPTRST
-  std::string properName = name(kernelName);
+    // Kernel names are __nvqpp__mlirgen__BuilderKernelPTRSTR for the following
+    // we want the proper name, BuilderKernelPTRST
+    std::string properName = name(kernelName);
 
-  // Need to first invoke the init_func()
-  auto kernelInitFunc = properName + ".init_func";
-  auto initFuncPtr = jit->lookup(kernelInitFunc);
-  if (!initFuncPtr) {
-    throw std::runtime_error(
-        "cudaq::builder failed to get kernelReg function.");
-  }
-  auto kernelInit = reinterpret_cast<void (*)()>(*initFuncPtr);
-  kernelInit();
+    // Need to first invoke the init_func()
+    auto kernelInitFunc = properName + ".init_func";
+    auto initFuncPtr = jit->lookup(kernelInitFunc);
+    if (!initFuncPtr) {
+      throw std::runtime_error(
+          "cudaq::builder failed to get kernelReg function.");
+    }
+    auto kernelInit = reinterpret_cast<void (*)()>(*initFuncPtr);
+    kernelInit();
 
-  // Need to first invoke the kernelRegFunc()
-  auto kernelRegFunc = properName + ".kernelRegFunc";
-  auto regFuncPtr = jit->lookup(kernelRegFunc);
-  if (!regFuncPtr) {
-    throw std::runtime_error(
-        "cudaq::builder failed to get kernelReg function.");
+    // Need to first invoke the kernelRegFunc()
+    auto kernelRegFunc = properName + ".kernelRegFunc";
+    auto regFuncPtr = jit->lookup(kernelRegFunc);
+    if (!regFuncPtr) {
+      throw std::runtime_error(
+          "cudaq::builder failed to get kernelReg function.");
+    }
+    auto kernelReg = reinterpret_cast<void (*)()>(*regFuncPtr);
+    kernelReg();
+    return jit;
+  };
+}
+
+std::tuple<bool, ExecutionEngine *>
+jitCode(ImplicitLocOpBuilder &builder, ExecutionEngine *jit,
+        std::unordered_map<ExecutionEngine *, std::size_t> &jitVersions,
+        std::string kernelName, std::vector<std::string> extraLibPaths,
+        StateVectorStorage &stateVectorStorage) {
+  auto moduleVersion = getModuleVersion(builder);
+
+  if (jit) {
+    // Have we added more instructions since the last time we jit the code? If
+    // so, we need to delete this JIT engine and create a new one.
+    if (moduleVersion == jitVersions[jit])
+      return std::make_tuple(false, jit);
+    else {
+      // need to redo the jit, remove the old one
+      jitVersions.erase(jit);
+    }
   }
-  auto kernelReg = reinterpret_cast<void (*)()>(*regFuncPtr);
-  kernelReg();
 
-  // Map this JIT Engine to its unique hash integer.
-  jitHash.insert({jit, moduleHash});
+  jit = prepareJitCode(builder, std::move(kernelName), std::move(extraLibPaths),
+                       stateVectorStorage)();
+
+  // Map this JIT Engine to the version of the ModuleOp it was compiled from.
+  jitVersions.insert({jit, moduleVersion});
   return std::make_tuple(true, jit);
 }
 
@@ -15,6 +15,7 @@
 #include "cudaq/utils/cudaq_utils.h"
 #include <cstring>
 #include <functional>
+#include <future>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -250,6 +251,18 @@ std::string name(std::string_view kernelName);
 /// @brief Apply our MLIR passes before JIT execution
 void applyPasses(mlir::PassManager &);
 
+/// @brief Return the version of the `ModuleOp` built with the given builder.
+/// The version changes whenever the builder creates an operation or block, so
+/// it tells whether the kernel changed without hashing the whole module.
+std::size_t getModuleVersion(mlir::ImplicitLocOpBuilder &);
+
+/// @brief Clone the `ModuleOp` built with the given builder and return a task
+/// that compiles the clone into an `ExecutionEngine`. The task does not use the
+/// builder, so it may run on another thread.
+std::function<mlir::ExecutionEngine *()>
+prepareJitCode(mlir::ImplicitLocOpBuilder &, std::string,
+               std::vector<std::string>, StateVectorStorage &);
+
 /// @brief Create the `ExecutionEngine` and return a raw pointer, which we will
 /// wrap in a `unique_ptr`
 std::tuple<bool, mlir::ExecutionEngine *>
@@ -403,10 +416,21 @@ private:
   std::unique_ptr<mlir::ExecutionEngine, void (*)(mlir::ExecutionEngine *)>
       jitEngine;
 
-  /// @brief Map created ExecutionEngines to a unique hash of the
+  /// @brief Map created ExecutionEngines to the version of the
   /// ModuleOp they derive from.
   std::unordered_map<mlir::ExecutionEngine *, std::size_t>
-      jitEngineToModuleHash;
+      jitEngineToModuleVersion;
+
+  /// @brief The `ExecutionEngine` being compiled in the background by
+  /// `compile_async`, and the ModuleOp version it derives from. Declared after
+  /// the context and builder, so it is destroyed (waiting for the compilation
+  /// to finish) before them.
+  std::future<decltype(jitEngine)> pendingJitEngine;
+  std::size_t pendingJitVersion = 0;
+
+  /// @brief Number of JIT compilations run when the kernel was invoked, as
+  /// opposed to the ones started ahead by `compile_async`.
+  std::size_t numBlockingJitCompilations = 0;
 
   /// @brief Name of the CUDA-Q kernel Quake function
   std::string kernelName = "__nvqpp__mlirgen____nvqppBuilderKernel";
@@ -426,6 +450,25 @@ private:
   /// @brief Storage for any user-provided state-vector data.
   details::StateVectorStorage stateVectorStorage;
 
+  /// @brief Serialize the JIT compilation of kernels invoked from several
+  /// threads.
+  static std::mutex &getJitMutex() {
+    static std::mutex jitMutex;
+    return jitMutex;
+  }
+
+  /// @brief Wait for the background compilation started by `compile_async`, if
+  /// any, and make its `ExecutionEngine` the current one. Rethrows the error of
+  /// a failed compilation.
+  void adoptPendingJitEngine() {
+    if (!pendingJitEngine.valid())
+      return;
+    auto engine = pendingJitEngine.get();
+    jitEngineToModuleVersion.erase(jitEngine.get());
+    jitEngineToModuleVersion.insert({engine.get(), pendingJitVersion});
+    jitEngine = std::move(engine);
+  }
+
 public:
   /// @brief The constructor, takes the input `KernelBuilderType`s which is
   /// used to create the MLIR function type
@@ -862,9 +905,12 @@ public:
 
   /// @brief Lower the Quake code to the LLVM Dialect, call `PassManager`.
   void jitCode(std::vector<std::string> extraLibPaths = {}) override {
+    adoptPendingJitEngine();
     auto [wasChanged, ptr] =
-        details::jitCode(*opBuilder, jitEngine.get(), jitEngineToModuleHash,
+        details::jitCode(*opBuilder, jitEngine.get(), jitEngineToModuleVersion,
                          kernelName, extraLibPaths, stateVectorStorage);
+    if (wasChanged)
+      numBlockingJitCompilations++;
     // If we had a jitEngine, but the code changed, delete the one we had.
     if (jitEngine && wasChanged)
       details::deleteJitEngine(jitEngine.release());
@@ -876,12 +922,39 @@ public:
           ptr, details::deleteJitEngine);
   }
 
+  /// @brief Start the JIT compilation of the kernel on a background thread, so
+  /// that its first invocation does not block on code generation. The
+  /// compilation works on a copy of the kernel. Instructions added afterwards
+  /// are compiled when the kernel is next invoked.
+  void compile_async(std::vector<std::string> extraLibPaths = {}) {
+    std::scoped_lock<std::mutex> lock(getJitMutex());
+    auto version = details::getModuleVersion(*opBuilder);
+    if (pendingJitEngine.valid() && pendingJitVersion == version)
+      return;
+    adoptPendingJitEngine();
+    if (jitEngine && jitEngineToModuleVersion[jitEngine.get()] == version)
+      return;
+
+    auto compile = details::prepareJitCode(
+        *opBuilder, kernelName, std::move(extraLibPaths), stateVectorStorage);
+    pendingJitEngine =
+        std::async(std::launch::async, [compile = std::move(compile)]() {
+          return decltype(jitEngine)(compile(), details::deleteJitEngine);
+        });
+    pendingJitVersion = version;
+  }
+
+  /// @brief Return the number of JIT compilations that ran when the kernel was
+  /// invoked, i.e., that were not started ahead by `compile_async`.
+  std::size_t get_num_blocking_compilations() const {
+    return numBlockingJitCompilations;
+  }
+
   /// @brief Invoke JIT compilation and extract a function pointer and execute.
   void jitAndInvoke(void **argsArray,
                     std::vector<std::string> extraLibPaths = {}) {
-    static std::mutex jitMutex;
     {
-      std::scoped_lock<std::mutex> lock(jitMutex);
+      std::scoped_lock<std::mutex> lock(getJitMutex());
       // Scoped locking since jitCode is not thread-safe while this jitAndInvoke
       // can be invoked by kernel_builder::operator()(Args... args) in a
       // multi-threaded context.
@@ -162,6 +162,11 @@ CUDAQ_ALL_REDUCE_IMPL(double, std::multiplies, PROD)
 CUDAQ_ALL_GATHER_IMPL(double)
 CUDAQ_ALL_GATHER_IMPL(int)
 
+void all_gather(std::vector<std::string> &global, const std::string &local) {
+  auto *commPlugin = getMpiPlugin();
+  commPlugin->all_gather(global, local);
+}
+
 void broadcast(std::vector<double> &data, int rootRank) {
   auto *commPlugin = getMpiPlugin();
   commPlugin->broadcast(data, rootRank);
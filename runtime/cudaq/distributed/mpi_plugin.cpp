@@ -94,6 +94,27 @@ void MPIPlugin::all_gather(std::vector<int> &global,
       m_comm, local.data(), global.data(), local.size(), dataType));
 }
 
+void MPIPlugin::all_gather(std::vector<std::string> &global,
+                           const std::string &local) {
+  const auto np = num_ranks();
+  std::int32_t localSize = local.size();
+  std::vector<std::int32_t> sizes(np);
+  HANDLE_MPI_ERROR(m_distributedInterface->Allgather(
+      m_comm, &localSize, sizes.data(), 1, INT_32));
+
+  std::vector<std::int32_t> displs(np, 0);
+  for (int i = 1; i < np; i++)
+    displs[i] = displs[i - 1] + sizes[i - 1];
+  std::string buffer(displs.back() + sizes.back(), '\0');
+  HANDLE_MPI_ERROR(m_distributedInterface->AllgatherV(
+      m_comm, local.data(), localSize, buffer.data(), sizes.data(),
+      displs.data(), INT_8));
+
+  global.resize(np);
+  for (int i = 0; i < np; i++)
+    global[i] = buffer.substr(displs[i], sizes[i]);
+}
+
 void MPIPlugin::broadcast(std::vector<double> &data, int rootRank) {
   HANDLE_MPI_ERROR(m_distributedInterface->Bcast(
       m_comm, data.data(), data.size(), FLOAT_64, rootRank));
@@ -63,6 +63,12 @@ public:
   /// vector elements coming from individual ranks.
   void all_gather(std::vector<int> &global, const std::vector<int> &local);
 
+  /// @brief Gather the (variable length) string of every rank on all ranks.
+  ///
+  /// Global vector is resized to the number of ranks, the i-th element holds
+  /// the string of rank i.
+  void all_gather(std::vector<std::string> &global, const std::string &local);
+
   /// @brief Broadcast a vector from a root rank to all other ranks
   void broadcast(std::vector<double> &data, int rootRank);
 
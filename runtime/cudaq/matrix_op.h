@@ -9,6 +9,7 @@
 #pragma once
 
 #include <complex>
+#include <optional>
 #include <unordered_map>
 #include <vector>
 
@@ -39,6 +40,8 @@ public:
 private:
   static std::unordered_map<std::string, Definition> defined_ops;
 
+  static void define(std::string operator_id, Definition &&definition);
+
   // used when converting other operators to matrix operators
   template <typename T>
   static std::string type_prefix();
@@ -97,6 +100,17 @@ public:
                      std::vector<int64_t> expected_dimensions,
                      matrix_callback &&create);
 
+  /// @brief Adds the definition of an elementary operator with the given id to
+  /// the class, and declares the parameters that its matrix depends on. See
+  /// the overload above for the other arguments.
+  /// @arg parameter_descriptions : A description of each parameter that the
+  ///      `create` function uses, by parameter name. The matrix of the operator
+  ///      is independent of all other parameters.
+  static void
+  define(std::string operator_id, std::vector<int64_t> expected_dimensions,
+         matrix_callback &&create,
+         std::unordered_map<std::string, std::string> &&parameter_descriptions);
+
   /// @brief Instantiates a custom operator.
   /// @arg operator_id : The ID of the operator as specified when it was
   /// defined.
@@ -122,6 +136,12 @@ public:
 
   virtual std::vector<std::size_t> degrees() const override;
 
+  /// @brief Return a description of each parameter that the matrix of the
+  /// operator depends on, by parameter name, or `std::nullopt` if the
+  /// parameters were not declared when the operator was defined.
+  std::optional<std::unordered_map<std::string, std::string>>
+  get_parameter_descriptions() const;
+
   // constructors and destructors
 
   matrix_handler(std::size_t target);
@@ -64,10 +64,23 @@ private:
   template <typename EvalTy>
   EvalTy evaluate(operator_arithmetics<EvalTy> arithmetics) const;
 
+  // hash of a term that is consistent with its term id; spin terms are
+  // hashed on their packed (X, Z) bits without building the id
+  static std::size_t term_hash(const std::vector<HandlerTy> &term);
+
+  // true if the two terms have the same term id
+  static bool same_term(const std::vector<HandlerTy> &term,
+                        const std::vector<HandlerTy> &other);
+
+  // index of the term with the given operators and hash, or the number of
+  // terms if there is no such term
+  std::size_t find_term(const std::vector<HandlerTy> &term,
+                        std::size_t hash) const;
+
 protected:
-  std::unordered_map<std::string, std::size_t>
-      term_map; // quick access to term index given its id (used for aggregating
-                // terms)
+  std::unordered_multimap<std::size_t, std::size_t>
+      term_map; // quick access to term index given its hash (used for
+                // aggregating terms)
   std::vector<std::vector<HandlerTy>> terms;
   std::vector<scalar_operator> coefficients;
   bool is_default = false;
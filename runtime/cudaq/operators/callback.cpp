@@ -35,15 +35,19 @@ complex_matrix matrix_callback::operator()(
 
 // Definition
 
-Definition::Definition(std::string operator_id,
-                       const std::vector<int64_t> &expected_dimensions,
-                       matrix_callback &&create)
+Definition::Definition(
+    std::string operator_id, const std::vector<int64_t> &expected_dimensions,
+    matrix_callback &&create,
+    std::optional<std::unordered_map<std::string, std::string>>
+        parameter_descriptions)
     : id(operator_id), generator(std::move(create)),
-      required_dimensions(expected_dimensions) {}
+      required_dimensions(expected_dimensions),
+      parameter_info(std::move(parameter_descriptions)) {}
 
 Definition::Definition(Definition &&def)
     : id(def.id), generator(std::move(def.generator)),
-      required_dimensions(std::move(def.expected_dimensions)) {}
+      required_dimensions(std::move(def.expected_dimensions)),
+      parameter_info(std::move(def.parameter_info)) {}
 
 complex_matrix Definition::generate_matrix(
     const std::vector<int64_t> &relevant_dimensions,
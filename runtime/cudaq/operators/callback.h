@@ -13,6 +13,7 @@
 
 #include <complex>
 #include <functional>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -89,13 +90,20 @@ private:
   std::string id;
   matrix_callback generator;
   std::vector<int64_t> required_dimensions;
+  std::optional<std::unordered_map<std::string, std::string>> parameter_info;
 
 public:
   const std::vector<int64_t> &expected_dimensions = this->required_dimensions;
+  // The descriptions of the parameters the generator depends on, by name, or
+  // `std::nullopt` if they were not declared in the definition.
+  const std::optional<std::unordered_map<std::string, std::string>>
+      &parameter_descriptions = this->parameter_info;
 
   Definition(std::string operator_id,
              const std::vector<int64_t> &expected_dimensions,
-             matrix_callback &&create);
+             matrix_callback &&create,
+             std::optional<std::unordered_map<std::string, std::string>>
+                 parameter_descriptions = std::nullopt);
   Definition(Definition &&def);
   ~Definition();
 
@@ -53,8 +53,22 @@ void matrix_handler::define(std::string operator_id,
                             matrix_callback &&create) {
   auto defn = Definition(operator_id, expected_dimensions,
                          std::forward<matrix_callback>(create));
+  matrix_handler::define(std::move(operator_id), std::move(defn));
+}
+
+void matrix_handler::define(
+    std::string operator_id, std::vector<int64_t> expected_dimensions,
+    matrix_callback &&create,
+    std::unordered_map<std::string, std::string> &&parameter_descriptions) {
+  auto defn = Definition(operator_id, expected_dimensions,
+                         std::forward<matrix_callback>(create),
+                         std::move(parameter_descriptions));
+  matrix_handler::define(std::move(operator_id), std::move(defn));
+}
+
+void matrix_handler::define(std::string operator_id, Definition &&definition) {
   auto result =
-      matrix_handler::defined_ops.insert({operator_id, std::move(defn)});
+      matrix_handler::defined_ops.insert({operator_id, std::move(definition)});
   if (!result.second)
     throw std::runtime_error("an matrix operator with name " + operator_id +
                              "is already defined");
@@ -150,6 +164,14 @@ std::vector<std::size_t> matrix_handler::degrees() const {
   return this->targets;
 }
 
+std::optional<std::unordered_map<std::string, std::string>>
+matrix_handler::get_parameter_descriptions() const {
+  auto it = matrix_handler::defined_ops.find(this->op_code);
+  assert(it != matrix_handler::defined_ops
+                   .end()); // should be validated upon instantiation
+  return it->second.parameter_descriptions;
+}
+
 // constructors
 
 matrix_handler::matrix_handler(std::size_t degree)
@@ -170,7 +192,7 @@ matrix_handler::matrix_handler(std::size_t degree)
           }
           return mat;
         };
-    matrix_handler::define(this->op_code, {-1}, std::move(func));
+    matrix_handler::define(this->op_code, {-1}, std::move(func), {});
   }
 }
 
@@ -246,7 +268,8 @@ matrix_handler::matrix_handler(const T &other,
     // the to_matrix method on the spin op will check the dimensions, so we
     // allow arbitrary here
     std::vector<int64_t> required_dimensions(this->targets.size(), -1);
-    matrix_handler::define(this->op_code, std::move(required_dimensions), func);
+    matrix_handler::define(this->op_code, std::move(required_dimensions), func,
+                           {});
   }
 }
 
@@ -372,7 +395,7 @@ matrix_handler matrix_handler::number(std::size_t degree) {
           }
           return mat;
         };
-    matrix_handler::define(op_code, {-1}, func);
+    matrix_handler::define(op_code, {-1}, func, {});
   }
   return matrix_handler(op_code, {degree});
 }
@@ -391,7 +414,7 @@ matrix_handler matrix_handler::parity(std::size_t degree) {
           }
           return mat;
         };
-    matrix_handler::define(op_code, {-1}, func);
+    matrix_handler::define(op_code, {-1}, func, {});
   }
   return matrix_handler(op_code, {degree});
 }
@@ -412,7 +435,7 @@ matrix_handler matrix_handler::position(std::size_t degree) {
           }
           return mat;
         };
-    matrix_handler::define(op_code, {-1}, func);
+    matrix_handler::define(op_code, {-1}, func, {});
   }
   return matrix_handler(op_code, {degree});
 }
@@ -435,7 +458,7 @@ matrix_handler matrix_handler::momentum(std::size_t degree) {
           }
           return mat;
         };
-    matrix_handler::define(op_code, {-1}, func);
+    matrix_handler::define(op_code, {-1}, func, {});
   }
   return matrix_handler(op_code, {degree});
 }
@@ -462,7 +485,9 @@ matrix_handler matrix_handler::displace(std::size_t degree) {
       auto term2 = std::conj(displacement_amplitude) * annihilate;
       return (term1 - term2).exponential();
     };
-    matrix_handler::define(op_code, {-1}, func);
+    matrix_handler::define(
+        op_code, {-1}, func,
+        {{"displacement", "Amplitude of the displacement in phase space."}});
   }
   return matrix_handler(op_code, {degree});
 }
@@ -490,7 +515,8 @@ matrix_handler matrix_handler::squeeze(std::size_t degree) {
       auto difference = 0.5 * (term1 - term2);
       return difference.exponential();
     };
-    matrix_handler::define(op_code, {-1}, func);
+    matrix_handler::define(op_code, {-1}, func,
+                           {{"squeezing", "Amplitude of the squeezing."}});
   }
   return matrix_handler(op_code, {degree});
 }
@@ -7,6 +7,7 @@
  ******************************************************************************/
 
 #include <algorithm>
+#include <cstdint>
 #include <iostream>
 #include <numeric>
 #include <set>
@@ -23,19 +24,73 @@ namespace cudaq {
 
 // private methods
 
+template <typename HandlerTy>
+std::size_t sum_op<HandlerTy>::term_hash(const std::vector<HandlerTy> &term) {
+  if constexpr (std::is_same_v<HandlerTy, spin_handler>) {
+    // Spin terms are hashed on their binary symplectic form; each operator
+    // contributes its degree together with its packed (X, Z) bits. This
+    // avoids building and hashing the string id for every term.
+    auto mix = [](std::uint64_t x) {
+      x ^= x >> 30;
+      x *= 0xbf58476d1ce4e5b9ull;
+      x ^= x >> 27;
+      x *= 0x94d049bb133111ebull;
+      return x ^ (x >> 31);
+    };
+    std::uint64_t hash = term.size();
+    for (const auto &op : term) {
+      auto pauli = op.as_pauli();
+      std::uint64_t xz = (pauli == pauli::X || pauli == pauli::Y) << 1 |
+                         (pauli == pauli::Z || pauli == pauli::Y);
+      hash = mix(hash ^ ((static_cast<std::uint64_t>(op.target()) << 2) | xz));
+    }
+    return hash;
+  } else {
+    std::string term_id;
+    for (const auto &op : term)
+      term_id += op.unique_id();
+    return std::hash<std::string>{}(term_id);
+  }
+}
+
+template <typename HandlerTy>
+bool sum_op<HandlerTy>::same_term(const std::vector<HandlerTy> &term,
+                                  const std::vector<HandlerTy> &other) {
+  if (term.size() != other.size())
+    return false;
+  for (std::size_t i = 0; i < term.size(); ++i) {
+    if constexpr (std::is_same_v<HandlerTy, spin_handler>) {
+      if (term[i].target() != other[i].target() ||
+          term[i].as_pauli() != other[i].as_pauli())
+        return false;
+    } else if (term[i].unique_id() != other[i].unique_id())
+      return false;
+  }
+  return true;
+}
+
+template <typename HandlerTy>
+std::size_t sum_op<HandlerTy>::find_term(const std::vector<HandlerTy> &term,
+                                         std::size_t hash) const {
+  auto range = this->term_map.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it)
+    if (same_term(this->terms[it->second], term))
+      return it->second;
+  return this->terms.size();
+}
+
 /// expects is_default to be false
 template <typename HandlerTy>
 void sum_op<HandlerTy>::insert(const product_op<HandlerTy> &other) {
   assert(!this->is_default);
-  auto term_id = other.get_term_id();
-  auto it = this->term_map.find(term_id);
-  if (it == this->term_map.cend()) {
+  auto hash = term_hash(other.operators);
+  auto idx = this->find_term(other.operators, hash);
+  if (idx == this->terms.size()) {
     this->coefficients.push_back(other.coefficient);
-    this->term_map.insert(
-        it, std::make_pair(std::move(term_id), this->terms.size()));
+    this->term_map.emplace(hash, idx);
     this->terms.push_back(other.operators);
   } else {
-    this->coefficients[it->second] += other.coefficient;
+    this->coefficients[idx] += other.coefficient;
   }
 }
 
@@ -43,15 +98,14 @@ void sum_op<HandlerTy>::insert(const product_op<HandlerTy> &other) {
 template <typename HandlerTy>
 void sum_op<HandlerTy>::insert(product_op<HandlerTy> &&other) {
   assert(!this->is_default);
-  auto term_id = other.get_term_id();
-  auto it = this->term_map.find(term_id);
-  if (it == this->term_map.cend()) {
+  auto hash = term_hash(other.operators);
+  auto idx = this->find_term(other.operators, hash);
+  if (idx == this->terms.size()) {
     this->coefficients.push_back(std::move(other.coefficient));
-    this->term_map.insert(
-        it, std::make_pair(std::move(term_id), this->terms.size()));
+    this->term_map.emplace(hash, idx);
     this->terms.push_back(std::move(other.operators));
   } else {
-    this->coefficients[it->second] += other.coefficient;
+    this->coefficients[idx] += other.coefficient;
   }
 }
 
@@ -111,6 +165,16 @@ sum_op<HandlerTy>::evaluate(operator_arithmetics<EvalTy> arithmetics) const {
 
 #define INSTANTIATE_SUM_PRIVATE_METHODS(HandlerTy)                             \
                                                                                \
+  template std::size_t sum_op<HandlerTy>::term_hash(                           \
+      const std::vector<HandlerTy> &term);                                     \
+                                                                               \
+  template bool sum_op<HandlerTy>::same_term(                                  \
+      const std::vector<HandlerTy> &term,                                      \
+      const std::vector<HandlerTy> &other);                                    \
+                                                                               \
+  template std::size_t sum_op<HandlerTy>::find_term(                           \
+      const std::vector<HandlerTy> &term, std::size_t hash) const;             \
+                                                                               \
   template void sum_op<HandlerTy>::insert(product_op<HandlerTy> &&other);      \
                                                                                \
   template void sum_op<HandlerTy>::insert(const product_op<HandlerTy> &other); \
@@ -244,9 +308,7 @@ sum_op<HandlerTy>::sum_op(const sum_op<T> &other)
   for (const auto &operators : other.terms) {
     product_op<HandlerTy> term(
         product_op<T>(1., operators)); // coefficient does not matter
-    this->term_map.insert(
-        this->term_map.cend(),
-        std::make_pair(term.get_term_id(), this->terms.size()));
+    this->term_map.emplace(term_hash(term.operators), this->terms.size());
     this->terms.push_back(std::move(term.operators));
   }
 }
@@ -265,9 +327,7 @@ sum_op<HandlerTy>::sum_op(const sum_op<T> &other,
   for (const auto &operators : other.terms) {
     product_op<HandlerTy> term(product_op<T>(1., operators),
                                behavior); // coefficient does not matter
-    this->term_map.insert(
-        this->term_map.cend(),
-        std::make_pair(term.get_term_id(), this->terms.size()));
+    this->term_map.emplace(term_hash(term.operators), this->terms.size());
     this->terms.push_back(std::move(term.operators));
   }
 }
@@ -287,7 +347,7 @@ sum_op<HandlerTy>::sum_op(const sum_op<HandlerTy> &other, bool is_default,
     for (const auto &coeff : other.coefficients)
       this->coefficients.push_back(coeff);
     for (const auto &entry : other.term_map)
-      this->term_map.insert(this->term_map.cend(), entry);
+      this->term_map.insert(entry);
     for (const auto &term : other.terms)
       this->terms.push_back(term);
   }
@@ -401,8 +461,7 @@ sum_op<HandlerTy>::operator=(const product_op<HandlerTy> &other) {
   this->term_map.clear();
   this->terms.clear();
   this->coefficients.push_back(other.coefficient);
-  this->term_map.insert(this->term_map.cend(),
-                        std::make_pair(other.get_term_id(), 0));
+  this->term_map.emplace(term_hash(other.operators), 0);
   this->terms.push_back(other.operators);
   return *this;
 }
@@ -414,8 +473,7 @@ sum_op<HandlerTy> &sum_op<HandlerTy>::operator=(product_op<HandlerTy> &&other) {
   this->term_map.clear();
   this->terms.clear();
   this->coefficients.push_back(std::move(other.coefficient));
-  this->term_map.insert(this->term_map.cend(),
-                        std::make_pair(other.get_term_id(), 0));
+  this->term_map.emplace(term_hash(other.operators), 0);
   this->terms.push_back(std::move(other.operators));
   return *this;
 }
@@ -547,22 +605,10 @@ bool sum_op<HandlerTy>::operator==(const sum_op<HandlerTy> &other) const {
   if (this->terms.size() != other.terms.size() ||
       this->is_default != other.is_default)
     return false;
-  std::vector<std::string> self_keys;
-  std::vector<std::string> other_keys;
-  self_keys.reserve(this->terms.size());
-  other_keys.reserve(other.terms.size());
-  for (const auto &entry : this->term_map)
-    self_keys.push_back(entry.first);
-  for (const auto &entry : other.term_map)
-    other_keys.push_back(entry.first);
-  std::sort(self_keys.begin(), self_keys.end());
-  std::sort(other_keys.begin(), other_keys.end());
-  if (self_keys != other_keys)
-    return false;
-  for (const auto &key : self_keys) {
-    auto self_idx = this->term_map.find(key)->second;
-    auto other_idx = other.term_map.find(key)->second;
-    if (this->coefficients[self_idx] != other.coefficients[other_idx])
+  for (const auto &[hash, self_idx] : this->term_map) {
+    auto other_idx = other.find_term(this->terms[self_idx], hash);
+    if (other_idx == other.terms.size() ||
+        this->coefficients[self_idx] != other.coefficients[other_idx])
       return false;
   }
   return true;
@@ -1632,15 +1678,14 @@ sum_op<HandlerTy>::distribute_terms(std::size_t numChunks) const {
 
   // Slice the given spin_op into subsets for each chunk
   std::vector<sum_op<HandlerTy>> chunks;
-  for (auto it = this->term_map.cbegin();
-       it != this->term_map.cend();) { // order does not matter here
+  for (std::size_t idx = 0; idx < this->terms.size();) {
     sum_op<HandlerTy> chunk(false);
     // Evenly distribute any leftovers across the early chunks
     for (auto count = nTermsPerChunk + (chunks.size() < leftover ? 1 : 0);
-         count > 0; --count, ++it)
-      chunk += product_op<HandlerTy>(this->coefficients[it->second],
-                                     this->terms[it->second]);
-    chunks.push_back(chunk);
+         count > 0; --count, ++idx)
+      chunk.insert(
+          product_op<HandlerTy>(this->coefficients[idx], this->terms[idx]));
+    chunks.push_back(std::move(chunk));
   }
   // Not sure if we need this - we might need this when parallelizing a spin_op
   // over QPUs when the system has more processors than we have terms.
@@ -1956,9 +2001,7 @@ sum_op<HandlerTy>::sum_op(const std::vector<std::vector<bool>> &bsf_terms,
         ops.push_back(spin_handler(pauli::Z, i));
     }
     product_op<HandlerTy> prod(coeffs[this->terms.size()], std::move(ops));
-    this->term_map.insert(
-        this->term_map.cend(),
-        std::make_pair(prod.get_term_id(), this->terms.size()));
+    this->term_map.emplace(term_hash(prod.operators), this->terms.size());
     this->terms.push_back(std::move(prod.operators));
     this->coefficients.push_back(std::move(prod.coefficient));
   }
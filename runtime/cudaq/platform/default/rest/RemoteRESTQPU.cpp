@@ -54,4 +54,8 @@ public:
 };
 } // namespace
 
+cudaq::CompiledJobCacheStatistics cudaq::getCompiledJobCacheStatistics() {
+  return RemoteRESTQPU::getCompiledJobCacheStatistics();
+}
+
 CUDAQ_REGISTER_TYPE(cudaq::QPU, RemoteRESTQPU, remote_rest)
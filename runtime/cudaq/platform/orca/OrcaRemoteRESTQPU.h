@@ -11,6 +11,7 @@
 #include "OrcaExecutor.h"
 #include "common/ExecutionContext.h"
 #include "common/Future.h"
+#include "common/JobPoller.h"
 #include "common/RestClient.h"
 #include "common/ServerHelper.h"
 #include "cudaq/platform/qpu.h"
@@ -68,8 +69,11 @@ public:
 
   OrcaRemoteRESTQPU(OrcaRemoteRESTQPU &&) = delete;
 
-  /// @brief The destructor
-  virtual ~OrcaRemoteRESTQPU() = default;
+  /// @brief The destructor. Stops polling the jobs submitted to the server.
+  virtual ~OrcaRemoteRESTQPU() {
+    if (serverHelper)
+      JobPoller::shutdown(serverHelper->name());
+  }
 
   /// @brief Get id of the thread this queue executes on.
   std::thread::id getExecutionThreadId() const {
@@ -10,6 +10,7 @@
 
 #include "QuantumExecutionQueue.h"
 #include "common/Logger.h"
+#include "common/MeasurementGrouping.h"
 #include "common/Registry.h"
 #include "common/ThunkInterface.h"
 #include "common/Timing.h"
@@ -17,6 +18,7 @@
 #include "cudaq/qis/qubit_qis.h"
 #include "cudaq/remote_capabilities.h"
 #include "cudaq/utils/cudaq_utils.h"
+#include <algorithm>
 #include <optional>
 
 namespace cudaq {
@@ -52,6 +54,36 @@ protected:
   /// @brief Noise model specified for QPU execution.
   const noise_model *noiseModel = nullptr;
 
+  /// @brief Measure all the terms of \p group at once. The basis change of a
+  /// general group is applied before, and undone after, the measurement.
+  SpinMeasureResult measureGroup(const MeasurementGroup &group) {
+    if (group.basis)
+      return cudaq::measure(*group.basis);
+
+    auto *executionManager = getExecutionManager();
+    auto applyBasisChange = [&](const MeasurementGroup::Gate &gate,
+                                bool isAdjoint) {
+      std::vector<QuditInfo> controls;
+      for (auto control : gate.controls)
+        controls.emplace_back(2, control);
+      executionManager->apply(gate.name, {}, controls,
+                              {QuditInfo(2, gate.target)}, isAdjoint);
+    };
+    for (const auto &gate : group.basisChange)
+      applyBasisChange(gate, false);
+
+    auto zTerm = spin_op::identity();
+    for (auto qubit : group.measuredQubits)
+      zTerm *= cudaq::spin::z(qubit);
+    auto result = cudaq::measure(zTerm);
+
+    for (auto iter = group.basisChange.rbegin();
+         iter != group.basisChange.rend(); ++iter)
+      applyBasisChange(*iter, true);
+    executionManager->flushGateQueue();
+    return result;
+  }
+
   /// @brief Check if the current execution context is a `spin_op`
   /// observation and perform state-preparation circuit measurement
   /// based on the `spin_op` terms.
@@ -84,6 +116,46 @@ protected:
         auto [exp, data] = cudaq::measure(H);
         localContext->expectationValue = exp;
         localContext->result = data;
+      } else if (localContext->shots > 0 &&
+                 getMeasurementGrouping() != MeasurementGrouping::none) {
+        // Measure groups of commuting terms together and compute
+        // coeff * <term> from the group results.
+        for (const auto &term : H)
+          if (term.is_identity())
+            sum += term.evaluate_coefficient().real();
+        for (const auto &group :
+             groupMeasurements(H, getMeasurementGrouping())) {
+          auto [exp, data] = measureGroup(group);
+          auto groupResult = data.to_map();
+          std::vector<std::size_t> bitQubits;
+          if (group.basis) {
+            for (const auto &op : *group.basis)
+              if (op.as_pauli() != cudaq::pauli::I)
+                bitQubits.push_back(op.target());
+          } else {
+            bitQubits = group.measuredQubits;
+          }
+          ExecutionResult groupExecResult(groupResult, group.name, exp);
+          groupExecResult.sequentialData = data.sequential_data();
+          for (const auto &groupTerm : group.terms)
+            if (groupTerm.term.get_term_id() == group.name) {
+              results.push_back(groupExecResult);
+              sum += groupTerm.term.evaluate_coefficient().real() * exp;
+            }
+          for (auto &result :
+               getTermResults(group, groupExecResult, bitQubits)) {
+            auto termIter = std::find_if(
+                group.terms.begin(), group.terms.end(), [&](auto &t) {
+                  return t.term.get_term_id() == result.registerName;
+                });
+            sum += termIter->term.evaluate_coefficient().real() *
+                   result.expectationValue.value();
+            results.push_back(std::move(result));
+          }
+        }
+
+        localContext->expectationValue = sum;
+        localContext->result = cudaq::sample_result(sum, results);
       } else {
 
         // Loop over each term and compute coeff * <term>
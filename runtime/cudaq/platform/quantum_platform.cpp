@@ -90,6 +90,7 @@ void quantum_platform::set_current_qpu(const std::size_t device_id) {
         "QPU device id is not valid (greater than number of available QPUs).");
   }
   platformCurrentQPU = device_id;
+  details::set_trace_qpu_id(device_id);
   auto tid = std::hash<std::thread::id>{}(std::this_thread::get_id());
   auto iter = threadToQpuId.find(tid);
   if (iter != threadToQpuId.end())
@@ -85,6 +85,13 @@ protected:
   /// instruction.
   virtual void executeInstruction(const Instruction &inst) = 0;
 
+  /// @brief Append the instruction to the kernel trace of the tracer mode.
+  void traceInstruction(const Instruction &inst) {
+    auto &&[name, params, controls, targets, op] = inst;
+    executionContext->kernelTrace.appendInstruction(name, params, controls,
+                                                    targets);
+  }
+
   /// @brief Subtype-specific method for performing qudit measurement.
   virtual int measureQudit(const cudaq::QuditInfo &q,
                            const std::string &registerName) = 0;
@@ -162,8 +169,13 @@ public:
                                   : &(adjointQueueStack.back());
 
     std::reverse(adjointQueue.begin(), adjointQueue.end());
-    for (auto &instruction : adjointQueue)
+    for (auto &instruction : adjointQueue) {
+      if (queue == &instructionQueue && isInTracerMode()) {
+        traceInstruction(instruction);
+        continue;
+      }
       queue->push_back(instruction);
+    }
   }
 
   void startCtrlRegion(const std::vector<std::size_t> &controls) override {
@@ -233,6 +245,14 @@ public:
       return;
     }
 
+    // In tracer mode, nothing is executed: append the instruction to the
+    // trace right away instead of holding it until the next synchronization.
+    if (isInTracerMode()) {
+      executionContext->kernelTrace.appendInstruction(
+          mutable_name, mutable_params, mutable_controls, mutable_targets);
+      return;
+    }
+
     // Add to the instruction queue
     instructionQueue.emplace_back(std::move(mutable_name), mutable_params,
                                   mutable_controls, mutable_targets, op);
@@ -249,10 +269,7 @@ public:
         executeInstruction(instruction);
         continue;
       }
-
-      auto &&[name, params, controls, targets, op] = instruction;
-      executionContext->kernelTrace.appendInstruction(name, params, controls,
-                                                      targets);
+      traceInstruction(instruction);
     }
     instructionQueue.clear();
   }
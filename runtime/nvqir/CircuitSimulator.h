@@ -16,8 +16,11 @@
 #include "common/NoiseModel.h"
 #include "common/Timing.h"
 #include "cudaq/host_config.h"
+#include <algorithm>
+#include <cerrno>
 #include <cstdarg>
 #include <cstddef>
+#include <cstdlib>
 #include <queue>
 #include <sstream>
 #include <string>
@@ -131,6 +134,14 @@ public:
     // do nothing
   }
 
+  /// @brief Seed only the random number streams owned by this instance,
+  /// leaving any process-wide generator untouched. Worker threads that
+  /// simulate shots with clones of the backend use this instead of
+  /// `setRandomSeed`.
+  virtual void setInstanceRandomSeed(std::size_t seed) {
+    // do nothing
+  }
+
   /// @brief Perform any flushing or synchronization to force that all
   /// previously applied gates have truly been applied by the underlying
   /// simulator.
@@ -379,6 +390,12 @@ public:
   /// @brief Return a thread_local pointer to this CircuitSimulator
   virtual CircuitSimulator *clone() = 0;
 
+  /// @brief Return true if clones of this CircuitSimulator can simulate shots
+  /// on concurrent threads, i.e., every random draw comes from a random number
+  /// stream owned by the instance and seeded by `setInstanceRandomSeed`, and
+  /// the memory of one clone per thread is affordable.
+  virtual bool canSimulateShotsConcurrently() const { return false; }
+
   /// Determine the (preferred) precision of the simulator.
   virtual bool isSinglePrecision() const = 0;
   bool isDoublePrecision() const { return !isSinglePrecision(); }
@@ -451,6 +468,20 @@ protected:
   static constexpr const char observeSamplingEnvVar[] =
       "CUDAQ_OBSERVE_FROM_SAMPLING";
 
+  /// @brief Environment variable name that enables gate fusion when flushing
+  /// the gate queue. Its value is the maximum number of qubits of a fused gate.
+  /// Gate fusion is disabled by default.
+  static constexpr const char gateFusionEnvVar[] =
+      "CUDAQ_GATE_FUSION_MAX_QUBITS";
+
+  /// @brief Environment variable name that bounds the number of states cached
+  /// at measurement branch points when sampling a kernel with conditional
+  /// feedback. The default of 1 caches the deterministic prefix before the
+  /// first measurement; larger values also cache frequently taken branches.
+  /// Setting it to 0 disables the cache.
+  static constexpr const char branchCacheEnvVar[] =
+      "CUDAQ_MAX_CACHED_BRANCH_STATES";
+
   /// @brief A GateApplicationTask consists of a
   /// matrix describing the quantum operation, a set of
   /// possible control qubit indices, and a set of target indices.
@@ -472,6 +503,27 @@ protected:
   /// @brief The current queue of operations to execute
   std::queue<GateApplicationTask> gateQueue;
 
+  /// @brief States captured right before a measurement when sampling a kernel
+  /// with conditional feedback, keyed by the hash of everything that led to
+  /// that branch point in the shot (allocations, gates, and the results of
+  /// earlier measurements). Later shots reaching the same branch point restore
+  /// the state instead of re-applying the gates.
+  std::unordered_map<std::size_t, std::unique_ptr<cudaq::SimulationState>>
+      branchStates;
+
+  /// @brief Running hash of the current shot up to the last enqueued gate.
+  std::size_t branchKey = 0;
+
+  /// @brief True while the state of the current shot is fully described by
+  /// `branchKey`. Anything else that touches the state (resets, noise, user
+  /// state data, explicit flushes) clears this for the rest of the shot.
+  bool branchKeyValid = false;
+
+  /// @brief The sampling context `branchStates` was populated for, and the
+  /// number of shots executed in that context so far.
+  const cudaq::ExecutionContext *branchCacheContext = nullptr;
+  std::size_t branchCacheShots = 0;
+
   /// @brief Get the name of the current circuit being executed.
   std::string getCircuitName() const { return currentCircuitName; }
 
@@ -807,6 +859,21 @@ protected:
       cudaq::log("{}: matrix={}, controls={}, targets={}, params={}", name,
                  matrix, controls, targets, params);
 
+    if (branchKeyValid) {
+      auto combine = [&](std::size_t value) {
+        branchKey ^= value + 0x9e3779b9 + (branchKey << 6) + (branchKey >> 2);
+      };
+      for (auto &m : matrix) {
+        combine(std::hash<ScalarType>{}(m.real()));
+        combine(std::hash<ScalarType>{}(m.imag()));
+      }
+      combine(controls.size());
+      for (auto c : controls)
+        combine(c);
+      for (auto t : targets)
+        combine(t);
+    }
+
     gateQueue.emplace(name, matrix, controls, targets, params);
   }
 
@@ -826,27 +893,322 @@ protected:
                                  const std::vector<std::size_t> &targets,
                                  const std::vector<double> &params) {}
 
+  /// @brief Return the maximum number of qubits of a fused gate, or 0 if gate
+  /// fusion is disabled. By default, gate fusion is enabled for state vector
+  /// simulators through the `CUDAQ_GATE_FUSION_MAX_QUBITS` environment
+  /// variable. Subtypes that fuse gates themselves can override this.
+  virtual std::size_t getGateFusionMaxQubits() const {
+    // Use a static variable since this is queried on every flush, and we don't
+    // expect it to change in the middle of a run.
+    static const std::size_t maxQubits = []() -> std::size_t {
+      const char *envVal = std::getenv(gateFusionEnvVar);
+      if (!envVal)
+        return 0;
+      const std::string maxQubitsStr(envVal);
+      char *endptr = nullptr;
+      errno = 0;
+      const long value = std::strtol(maxQubitsStr.c_str(), &endptr, 10);
+      if (endptr == maxQubitsStr.c_str() || errno != 0 || value < 0)
+        throw std::runtime_error(
+            std::string("Invalid ") + gateFusionEnvVar +
+            " setting. Expected a non-negative number. Got: " + maxQubitsStr);
+      return static_cast<std::size_t>(value);
+    }();
+    return isStateVectorSimulator() ? maxQubits : 0;
+  }
+
+  /// @brief Return the maximum number of states cached at measurement branch
+  /// points, as set by the `CUDAQ_MAX_CACHED_BRANCH_STATES` environment
+  /// variable (default 1).
+  static std::size_t getMaxCachedBranchStates() {
+    static const std::size_t maxStates = []() -> std::size_t {
+      const char *envVal = std::getenv(branchCacheEnvVar);
+      if (!envVal)
+        return 1;
+      const std::string maxStatesStr(envVal);
+      char *endptr = nullptr;
+      errno = 0;
+      const long value = std::strtol(maxStatesStr.c_str(), &endptr, 10);
+      if (endptr == maxStatesStr.c_str() || errno != 0 || value < 0)
+        throw std::runtime_error(
+            std::string("Invalid ") + branchCacheEnvVar +
+            " setting. Expected a non-negative number. Got: " + maxStatesStr);
+      return static_cast<std::size_t>(value);
+    }();
+    return maxStates;
+  }
+
+  /// @brief Return true if this simulator implements `snapshotState` and
+  /// `restoreState`, which enables branch point caching.
+  virtual bool canSnapshotState() const { return false; }
+
+  /// @brief Return a copy of the current state. The simulator state must be
+  /// left untouched.
+  virtual std::unique_ptr<cudaq::SimulationState> snapshotState() {
+    throw std::runtime_error("State snapshots are not supported by this "
+                             "simulator, override snapshotState.");
+  }
+
+  /// @brief Overwrite the current state with a copy of a state returned by
+  /// `snapshotState`.
+  virtual void restoreState(const cudaq::SimulationState &snapshot) {
+    throw std::runtime_error("State snapshots are not supported by this "
+                             "simulator, override restoreState.");
+  }
+
+  /// @brief Return true if shots of the current execution should cache the
+  /// state at their measurement branch points.
+  bool shouldCacheBranchStates() const {
+    return executionContext && executionContext->name == "sample" &&
+           executionContext->hasConditionalsOnMeasureResults &&
+           !executionContext->noiseModel && canSnapshotState() &&
+           getMaxCachedBranchStates() > 0;
+  }
+
+  /// @brief Flush the gate queue before measuring a qubit. If the state at
+  /// this branch point was cached by an earlier shot, restore it and drop the
+  /// queued gates; otherwise apply them and cache the resulting state while
+  /// there is room in the cache.
+  void flushGateQueueAtBranchPoint() {
+    if (!branchKeyValid) {
+      flushGateQueue();
+      return;
+    }
+
+    // Newly allocated qubits only extend the state with |0>, so the number of
+    // qubits completes the key.
+    branchKey ^= nQubitsAllocated + 0x9e3779b9 + (branchKey << 6) +
+                 (branchKey >> 2);
+    if (auto iter = branchStates.find(branchKey); iter != branchStates.end()) {
+      cudaq::info("Restoring cached state at measurement branch point.");
+      while (!gateQueue.empty())
+        gateQueue.pop();
+      restoreState(*iter->second);
+      return;
+    }
+
+    flushGateQueue();
+    branchKeyValid = true;
+    if (branchStates.size() < getMaxCachedBranchStates())
+      branchStates.emplace(branchKey, snapshotState());
+  }
+
+  /// @brief Apply a single gate application task to the state.
+  void applyGateTask(const GateApplicationTask &task) {
+    if (isStateVectorSimulator() && summaryData.enabled)
+      summaryData.svGateUpdate(
+          task.controls.size(), task.targets.size(), stateDimension,
+          stateDimension * sizeof(std::complex<ScalarType>));
+    try {
+      applyGate(task);
+    } catch (std::exception &e) {
+      while (!gateQueue.empty())
+        gateQueue.pop();
+      throw std::runtime_error(std::string("Exception in applyGate: ") +
+                               e.what());
+    } catch (...) {
+      while (!gateQueue.empty())
+        gateQueue.pop();
+      throw std::runtime_error("Unknown exception in applyGate");
+    }
+  }
+
+  /// @brief A group of queued gates that is fused into a single gate acting
+  /// on `qubits`. The gates are listed in application order.
+  struct FusionBlock {
+    std::vector<std::size_t> qubits;
+    std::vector<std::size_t> taskIndices;
+  };
+
+  /// @brief Compute the unitary of the gates in `block` as a dense matrix on
+  /// `block.qubits`, following the matrix convention of getQubitOrdering().
+  std::vector<std::complex<ScalarType>>
+  fuseGates(const std::vector<GateApplicationTask> &tasks,
+            const FusionBlock &block) const {
+    const std::size_t numQubits = block.qubits.size();
+    const std::size_t dim = 1ULL << numQubits;
+    const bool msb = getQubitOrdering() == QubitOrdering::msb;
+
+    // Bit `j` of a local basis index corresponds to `block.qubits[j]`.
+    auto localMask = [&](std::size_t qubit) -> std::size_t {
+      auto iter = std::find(block.qubits.begin(), block.qubits.end(), qubit);
+      return 1ULL << std::distance(block.qubits.begin(), iter);
+    };
+
+    // Start from the identity and apply each gate to every column.
+    std::vector<std::complex<ScalarType>> unitary(dim * dim, 0.0);
+    for (std::size_t i = 0; i < dim; ++i)
+      unitary[i * dim + i] = 1.0;
+
+    std::vector<std::complex<ScalarType>> in, out;
+    std::vector<std::size_t> offsets;
+    for (auto taskIdx : block.taskIndices) {
+      const auto &task = tasks[taskIdx];
+      const std::size_t numTargets = task.targets.size();
+      const std::size_t gateDim = 1ULL << numTargets;
+
+      std::size_t controlMask = 0;
+      for (auto c : task.controls)
+        controlMask |= localMask(c);
+
+      // Map each row of the gate matrix to the local basis offset it touches.
+      std::size_t targetMask = 0;
+      offsets.assign(gateDim, 0);
+      for (std::size_t i = 0; i < numTargets; ++i) {
+        const std::size_t mask = localMask(task.targets[i]);
+        const std::size_t gateBit = msb ? numTargets - 1 - i : i;
+        targetMask |= mask;
+        for (std::size_t g = 0; g < gateDim; ++g)
+          if (g & (1ULL << gateBit))
+            offsets[g] |= mask;
+      }
+
+      in.resize(gateDim);
+      out.resize(gateDim);
+      for (std::size_t base = 0; base < dim; ++base) {
+        if ((base & controlMask) != controlMask || (base & targetMask))
+          continue;
+        for (std::size_t col = 0; col < dim; ++col) {
+          for (std::size_t g = 0; g < gateDim; ++g)
+            in[g] = unitary[(base | offsets[g]) * dim + col];
+          for (std::size_t r = 0; r < gateDim; ++r) {
+            std::complex<ScalarType> sum = 0.0;
+            for (std::size_t c = 0; c < gateDim; ++c)
+              sum += task.matrix[r * gateDim + c] * in[c];
+            out[r] = sum;
+          }
+          for (std::size_t g = 0; g < gateDim; ++g)
+            unitary[(base | offsets[g]) * dim + col] = out[g];
+        }
+      }
+    }
+
+    if (!msb)
+      return unitary;
+
+    // In MSB ordering, the first qubit is the most significant bit of the
+    // matrix index.
+    auto reverseBits = [&](std::size_t idx) {
+      std::size_t newIdx = 0;
+      for (std::size_t i = 0; i < numQubits; ++i)
+        if (idx & (1ULL << i))
+          newIdx |= (1ULL << (numQubits - 1 - i));
+      return newIdx;
+    };
+    std::vector<std::complex<ScalarType>> reordered(dim * dim);
+    for (std::size_t r = 0; r < dim; ++r)
+      for (std::size_t c = 0; c < dim; ++c)
+        reordered[reverseBits(r) * dim + reverseBits(c)] = unitary[r * dim + c];
+    return reordered;
+  }
+
+  /// @brief Flush the gate queue, fusing runs of gates into dense gates on at
+  /// most `maxQubits` qubits. Open blocks act on disjoint qubits, so gates are
+  /// only ever reordered with gates they commute with. A gate that does not
+  /// fit in a block closes (applies) the blocks it overlaps. Gates acting on
+  /// more than `maxQubits` qubits and gates followed by a noise channel are
+  /// applied on their own, so that channels are applied at the right point.
+  void flushFusedGateQueue(std::size_t maxQubits) {
+    std::vector<GateApplicationTask> tasks;
+    tasks.reserve(gateQueue.size());
+    while (!gateQueue.empty()) {
+      tasks.push_back(gateQueue.front());
+      gateQueue.pop();
+    }
+
+    const cudaq::noise_model *noiseModel =
+        executionContext ? executionContext->noiseModel : nullptr;
+    std::vector<FusionBlock> blocks;
+    auto applyBlock = [&](const FusionBlock &block) {
+      if (block.taskIndices.size() == 1) {
+        applyGateTask(tasks[block.taskIndices.front()]);
+        return;
+      }
+      applyGateTask(GateApplicationTask("fused", fuseGates(tasks, block), {},
+                                        block.qubits, {}));
+    };
+
+    for (std::size_t i = 0; i < tasks.size(); ++i) {
+      const auto &task = tasks[i];
+      std::vector<std::size_t> qubits(task.controls);
+      qubits.insert(qubits.end(), task.targets.begin(), task.targets.end());
+
+      std::vector<double> params(task.parameters.begin(),
+                                 task.parameters.end());
+      const bool hasNoise =
+          noiseModel && !noiseModel
+                             ->lookup_channels(task.operationName, task.targets,
+                                               task.controls, params)
+                             ->empty();
+
+      // Take out the open blocks that share a qubit with this gate.
+      std::vector<FusionBlock> overlapping, disjoint;
+      for (auto &block : blocks) {
+        const bool overlaps = std::any_of(
+            block.qubits.begin(), block.qubits.end(), [&](std::size_t q) {
+              return std::find(qubits.begin(), qubits.end(), q) !=
+                     qubits.end();
+            });
+        (overlaps ? overlapping : disjoint).push_back(std::move(block));
+      }
+      blocks = std::move(disjoint);
+
+      FusionBlock merged;
+      for (auto &block : overlapping) {
+        merged.qubits.insert(merged.qubits.end(), block.qubits.begin(),
+                             block.qubits.end());
+        merged.taskIndices.insert(merged.taskIndices.end(),
+                                  block.taskIndices.begin(),
+                                  block.taskIndices.end());
+      }
+      for (auto q : qubits)
+        if (std::find(merged.qubits.begin(), merged.qubits.end(), q) ==
+            merged.qubits.end())
+          merged.qubits.push_back(q);
+
+      if (merged.qubits.size() <= maxQubits) {
+        merged.taskIndices.push_back(i);
+        if (!hasNoise) {
+          blocks.push_back(std::move(merged));
+          continue;
+        }
+        applyBlock(merged);
+        applyNoiseChannel(task.operationName, task.controls, task.targets,
+                          params);
+        continue;
+      }
+
+      // The gate does not fit: apply the blocks it overlaps first.
+      for (auto &block : overlapping)
+        applyBlock(block);
+      if (hasNoise || qubits.size() > maxQubits) {
+        applyGateTask(task);
+        if (hasNoise)
+          applyNoiseChannel(task.operationName, task.controls, task.targets,
+                            params);
+        continue;
+      }
+      blocks.push_back(FusionBlock{qubits, {i}});
+    }
+
+    for (auto &block : blocks)
+      applyBlock(block);
+  }
+
   /// @brief Flush the gate queue, run all queued gate
   /// application tasks.
   void flushGateQueueImpl() override {
+    branchKeyValid = false;
+    if (auto maxQubits = getGateFusionMaxQubits(); maxQubits > 0) {
+      flushFusedGateQueue(maxQubits);
+      // For CUDA-based simulators, this calls cudaDeviceSynchronize()
+      synchronize();
+      return;
+    }
+
     while (!gateQueue.empty()) {
       auto &next = gateQueue.front();
-      if (isStateVectorSimulator() && summaryData.enabled)
-        summaryData.svGateUpdate(
-            next.controls.size(), next.targets.size(), stateDimension,
-            stateDimension * sizeof(std::complex<ScalarType>));
-      try {
-        applyGate(next);
-      } catch (std::exception &e) {
-        while (!gateQueue.empty())
-          gateQueue.pop();
-        throw std::runtime_error(std::string("Exception in applyGate: ") +
-                                 e.what());
-      } catch (...) {
-        while (!gateQueue.empty())
-          gateQueue.pop();
-        throw std::runtime_error("Unknown exception in applyGate");
-      }
+      applyGateTask(next);
       if (executionContext && executionContext->noiseModel) {
         std::vector<double> params(next.parameters.begin(),
                                    next.parameters.end());
@@ -993,6 +1355,10 @@ public:
       // Tell the subtype to allocate more qubits
       addQubitsToState(count, state);
 
+    // User-provided state data is not part of the branch point key.
+    if (state != nullptr)
+      branchKeyValid = false;
+
     // May be that the state grows enough that we
     // want to handle observation via sampling
     if (executionContext)
@@ -1039,6 +1405,9 @@ public:
       // Tell the subtype to allocate more qubits
       addQubitsToState(*state);
 
+    // User-provided states are not part of the branch point key.
+    branchKeyValid = false;
+
     // May be that the state grows enough that we
     // want to handle observation via sampling
     if (executionContext)
@@ -1184,6 +1553,14 @@ public:
     for (auto &deferred : deferredDeallocation)
       tracker.returnIndex(deferred);
 
+    // Drop the cached branch states once the last shot has run.
+    if (executionContext == branchCacheContext &&
+        ++branchCacheShots >= executionContext->shots) {
+      branchStates.clear();
+      branchCacheContext = nullptr;
+    }
+    branchKeyValid = false;
+
     bool shouldSetToZero = isInBatchMode() && !isLastBatch();
     executionContext = nullptr;
 
@@ -1210,6 +1587,20 @@ public:
     executionContext->canHandleObserve = canHandleObserve();
     currentCircuitName = context->kernelName;
     cudaq::info("Setting current circuit name to {}", currentCircuitName);
+
+    // Kernels with conditional feedback run one shot per execution. Each shot
+    // starts from an empty state, so the state at a measurement is determined
+    // by what was applied since the start of the shot.
+    if (context != branchCacheContext) {
+      branchStates.clear();
+      branchCacheContext = nullptr;
+    }
+    branchKey = 0;
+    branchKeyValid = nQubitsAllocated == 0 && shouldCacheBranchStates();
+    if (branchKeyValid && !branchCacheContext) {
+      branchCacheContext = context;
+      branchCacheShots = 0;
+    }
   }
 
   /// @brief Return the current execution context
@@ -1389,8 +1780,9 @@ public:
   /// context, just measure, collapse, and return the bit.
   bool mz(const std::size_t qubitIdx,
           const std::string &registerName) override {
-    // Flush the Gate Queue
-    flushGateQueue();
+    // Flush the Gate Queue, reusing the state cached at this branch point by
+    // an earlier shot if possible.
+    flushGateQueueAtBranchPoint();
 
     // Apply measurement noise (if any)
     // Note: gate noises are applied during flushGateQueue
@@ -1408,6 +1800,9 @@ public:
     // Get the actual measurement from the subtype measureQubit implementation
     auto measureResult = measureQubit(qubitIdx);
     auto bitResult = measureResult == true ? "1" : "0";
+    if (branchKeyValid)
+      branchKey ^= (qubitIdx << 1 | measureResult) + 0x9e3779b9 +
+                   (branchKey << 6) + (branchKey >> 2);
 
     // If this CUDA-Q kernel has conditional statements on measure results
     // then we want to handle the sampling a bit differently.
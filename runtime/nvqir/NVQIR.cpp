@@ -91,10 +91,25 @@ CircuitSimulator *getCircuitSimulatorInternal() {
   return simulator;
 }
 
+/// @brief Make the calling thread simulate with its own instance of the
+/// backend of `sim`, e.g., for worker threads running shots in parallel with
+/// the thread that owns `sim`.
+void cloneCircuitSimulatorForThread(CircuitSimulator *sim) {
+  simulator = sim->clone();
+}
+
+bool canSimulateShotsConcurrently() {
+  return getCircuitSimulatorInternal()->canSimulateShotsConcurrently();
+}
+
 void setRandomSeed(std::size_t seed) {
   getCircuitSimulatorInternal()->setRandomSeed(seed);
 }
 
+void setInstanceRandomSeed(std::size_t seed) {
+  getCircuitSimulatorInternal()->setInstanceRandomSeed(seed);
+}
+
 /// @brief The QIR spec allows for dynamic qubit management, where the qubit
 /// pointers are true pointers, but the Base Profile and Adaptive profiles
 /// require that qubits are identified by an integer value that is bitcast to a
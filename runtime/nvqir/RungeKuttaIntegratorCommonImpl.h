@@ -0,0 +1,134 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include "common/Logger.h"
+#include "cudaq/algorithms/base_time_stepper.h"
+#include "cudaq/algorithms/integrator.h"
+
+// The parts of `cudaq::integrators::runge_kutta` that do not depend on the
+// dynamics backend. Each backend includes this file in exactly one translation
+// unit, and implements `setState`, `getState` and `integrate` for its own
+// simulation state, the latter by calling `integrateRungeKutta`.
+
+namespace cudaq {
+namespace integrators {
+
+runge_kutta::runge_kutta(int order, const std::optional<double> &max_step_size)
+    : m_t(0.0), m_order(order), m_dt(max_step_size) {
+  if (m_order != 1 && m_order != 2 && m_order != 4)
+    throw std::invalid_argument(
+        "runge_kutta integrator only supports integration order 1, 2, or 4.");
+}
+
+std::shared_ptr<base_integrator> runge_kutta::clone() {
+  auto clone = std::make_shared<cudaq::integrators::runge_kutta>();
+  clone->m_order = this->m_order;
+  clone->m_dt = this->m_dt;
+  clone->m_t = this->m_t;
+  clone->m_state = this->m_state;
+  clone->m_system = this->m_system;
+  clone->m_schedule = this->m_schedule;
+  return clone;
+}
+
+namespace {
+/// @brief Integrate `state` in place from time `t` to `targetTime`, with steps
+/// no larger than `maxStepSize`, and update `t`. `SimState` is the simulation
+/// state of the backend, which must support element-wise addition and scalar
+/// multiplication. `cloneState` returns a new copy of a `SimState`.
+template <typename SimState, typename CloneState>
+void integrateRungeKutta(int order, const std::optional<double> &maxStepSize,
+                         const cudaq::schedule &schedule,
+                         base_time_stepper &stepper, cudaq::state &state,
+                         double &t, double targetTime,
+                         CloneState &&cloneState) {
+  const auto asSimState = [](cudaq::state &cudaqState) -> SimState * {
+    auto *simState = cudaq::state_helper::getSimulationState(&cudaqState);
+    auto *castSimState = dynamic_cast<SimState *>(simState);
+    if (!castSimState)
+      throw std::runtime_error("Invalid state.");
+    return castSimState;
+  };
+  auto &castSimState = *asSimState(state);
+  std::unordered_map<std::string, std::complex<double>> params;
+  const auto setParameters = [&](double time) {
+    for (const auto &param : schedule.get_parameters())
+      params[param] = schedule.get_value_function()(param, time);
+  };
+
+  while (t < targetTime) {
+    const double step_size =
+        std::min(maxStepSize.value_or(targetTime - t), targetTime - t);
+
+    cudaq::debug("Runge-Kutta step at time {} with step size {}", t,
+                 step_size);
+
+    if (order == 1) {
+      // Euler method (1st order)
+      setParameters(t);
+      auto k1State = stepper.compute(state, t, step_size, params);
+      auto &k1 = *asSimState(k1State);
+      k1 *= step_size;
+      castSimState += k1;
+    } else if (order == 2) {
+      // Midpoint method (2nd order)
+      setParameters(t);
+      auto k1State = stepper.compute(state, t, step_size, params);
+      auto &k1 = *asSimState(k1State);
+      k1 *= (step_size / 2.0);
+
+      castSimState += k1;
+      setParameters(t + step_size / 2.0);
+      auto k2State =
+          stepper.compute(state, t + step_size / 2.0, step_size, params);
+      auto &k2 = *asSimState(k2State);
+      k2 *= (step_size / 2.0);
+
+      castSimState += k2;
+    } else if (order == 4) {
+      // Runge-Kutta method (4th order)
+      setParameters(t);
+      auto k1State = stepper.compute(state, t, step_size, params);
+      auto &k1 = *asSimState(k1State);
+      SimState rho_temp = cloneState(castSimState);
+      rho_temp += (k1 * (step_size / 2));
+
+      setParameters(t + step_size / 2.0);
+      auto k2State =
+          stepper.compute(cudaq::state(new SimState(std::move(rho_temp))),
+                          t + step_size / 2.0, step_size, params);
+      auto &k2 = *asSimState(k2State);
+      SimState rho_temp_2 = cloneState(castSimState);
+      rho_temp_2 += (k2 * (step_size / 2));
+
+      auto k3State =
+          stepper.compute(cudaq::state(new SimState(std::move(rho_temp_2))),
+                          t + step_size / 2.0, step_size, params);
+      auto &k3 = *asSimState(k3State);
+      SimState rho_temp_3 = cloneState(castSimState);
+      rho_temp_3 += (k3 * step_size);
+
+      setParameters(t + step_size);
+      auto k4State =
+          stepper.compute(cudaq::state(new SimState(std::move(rho_temp_3))),
+                          t + step_size, step_size, params);
+      auto &k4 = *asSimState(k4State);
+      castSimState += (k1 + k2 * 2.0 + k3 * 2.0 + k4) * (step_size / 6.0);
+    } else {
+      throw std::runtime_error("Invalid integrator order");
+    }
+
+    // Update time
+    t += step_size;
+  }
+}
+} // namespace
+} // namespace integrators
+} // namespace cudaq
@@ -0,0 +1,125 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "CpuDynamicsOperator.h"
+#include "CpuDynamicsState.h"
+#include "cudaq/algorithms/evolve_internal.h"
+#include "cudaq/algorithms/integrator.h"
+#include <stdexcept>
+
+namespace cudaq::__internal__ {
+namespace {
+// Expectation value of `op` in the given state, i.e., <psi|op|psi> for a
+// state vector and Tr(op * rho) for a density matrix.
+std::complex<double>
+computeExpectation(const CpuDynamicsOperator::SparseMatrix &op,
+                   const CpuDynamicsState &state) {
+  const int64_t dim = op.rows();
+  const auto &data = state.get_data();
+  if (!state.is_density_matrix()) {
+    Eigen::VectorXcd opTimesPsi(dim);
+    CpuDynamicsOperator::multiply(op, data.data(), opTimesPsi.data(), 1);
+    return data.dot(opTimesPsi);
+  }
+
+  // Tr(op * rho) = sum_ij op(i, j) * rho(j, i), where rho is column-major.
+  const auto *outerIndices = op.outerIndexPtr();
+  const auto *innerIndices = op.innerIndexPtr();
+  const auto *values = op.valuePtr();
+  double re = 0.0, im = 0.0;
+#if defined(_OPENMP)
+#pragma omp parallel for reduction(+ : re, im)
+#endif
+  for (int64_t row = 0; row < dim; ++row)
+    for (auto k = outerIndices[row]; k < outerIndices[row + 1]; ++k) {
+      const auto v = values[k] * data[row * dim + innerIndices[k]];
+      re += v.real();
+      im += v.imag();
+    }
+  return {re, im};
+}
+} // namespace
+
+/// @brief Evolve the system for a single time step.
+/// @param hamiltonian Hamiltonian operator.
+/// @param dimensionsMap Dimension of the system.
+/// @param schedule Time schedule.
+/// @param initialState Initial state.
+/// @param inIntegrator Integrator.
+/// @param collapseOperators Collapse operators.
+/// @param observables Observables.
+/// @param storeIntermediateResults Store intermediate results.
+/// @param shotsCount Number of shots.
+/// @return evolve_result Result of the evolution.
+evolve_result evolveSingle(
+    const sum_op<cudaq::matrix_handler> &hamiltonian,
+    const cudaq::dimension_map &dimensionsMap, const schedule &schedule,
+    const state &initialState, base_integrator &integrator,
+    const std::vector<sum_op<cudaq::matrix_handler>> &collapseOperators,
+    const std::vector<sum_op<cudaq::matrix_handler>> &observables,
+    bool storeIntermediateResults, std::optional<int> shotsCount) {
+  std::map<std::size_t, int64_t> dimensions(dimensionsMap.begin(),
+                                            dimensionsMap.end());
+  std::vector<int64_t> dims;
+  for (const auto &[id, dim] : dimensions)
+    dims.emplace_back(dim);
+  const auto asCpuState = [](cudaq::state &cudaqState) -> CpuDynamicsState * {
+    auto *simState = cudaq::state_helper::getSimulationState(&cudaqState);
+    auto *castSimState = dynamic_cast<CpuDynamicsState *>(simState);
+    if (!castSimState)
+      throw std::runtime_error("Invalid state.");
+    return castSimState;
+  };
+
+  auto *cpuState = asCpuState(const_cast<state &>(initialState));
+  cpuState->initialize(dims);
+
+  state initial_State = [&]() {
+    if (!collapseOperators.empty() && !cpuState->is_density_matrix())
+      return state(new CpuDynamicsState(cpuState->to_density_matrix()));
+    return initialState;
+  }();
+
+  SystemDynamics system(dims, hamiltonian, collapseOperators);
+  cudaq::integrator_helper::init_system_dynamics(integrator, system, schedule);
+  integrator.setState(initial_State, 0.0);
+  std::vector<CpuDynamicsOperator> expectations;
+  for (auto &obs : observables)
+    expectations.emplace_back(obs, dims);
+
+  const auto computeExpectations = [&](state &currentState, double t) {
+    std::unordered_map<std::string, std::complex<double>> params;
+    for (const auto &param : schedule.get_parameters())
+      params[param] = schedule.get_value_function()(param, t);
+    auto *cpuState = asCpuState(currentState);
+    std::vector<double> expVals;
+    for (auto &expectation : expectations)
+      expVals.emplace_back(
+          computeExpectation(expectation.evaluate(params), *cpuState).real());
+    return expVals;
+  };
+
+  std::vector<std::vector<double>> expectationVals;
+  std::vector<cudaq::state> intermediateStates;
+  for (const auto &step : schedule) {
+    integrator.integrate(step.real());
+    if (storeIntermediateResults) {
+      auto [t, currentState] = integrator.getState();
+      expectationVals.emplace_back(computeExpectations(currentState, t));
+      intermediateStates.emplace_back(currentState);
+    }
+  }
+
+  if (storeIntermediateResults)
+    return evolve_result(intermediateStates, expectationVals);
+
+  // Only final state is needed
+  auto [finalTime, finalState] = integrator.getState();
+  return evolve_result(finalState, computeExpectations(finalState, finalTime));
+}
+} // namespace cudaq::__internal__
@@ -0,0 +1,214 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "CpuDynamicsOperator.h"
+#include "common/FmtCore.h"
+#include <algorithm>
+#include <tuple>
+
+namespace cudaq {
+
+// Return true if the matrix of the elementary operator does not depend on
+// any parameters, as declared in its definition. Custom operators defined
+// without declaring their parameters may depend on arbitrary parameters.
+static bool isParameterFree(const matrix_handler &op) {
+  const auto parameters = op.get_parameter_descriptions();
+  return parameters.has_value() && parameters->empty();
+}
+
+CpuDynamicsOperator::CpuDynamicsOperator(
+    const sum_op<matrix_handler> &op, const std::vector<int64_t> &modeExtents)
+    : m_modeExtents(modeExtents) {
+  m_strides.reserve(modeExtents.size());
+  for (auto extent : modeExtents) {
+    m_strides.push_back(m_dimension);
+    m_dimension *= extent;
+  }
+
+  std::vector<Entry> entries;
+  for (const auto &term : op) {
+    const auto degrees = term.degrees();
+    for (auto degree : degrees)
+      if (degree >= m_modeExtents.size())
+        throw std::runtime_error(fmt::format(
+            "[dynamics-cpu] Operator acts on degree {}, but the system only "
+            "has {} degrees of freedom.",
+            degree, m_modeExtents.size()));
+
+    // The matrix of the term without its coefficient.
+    product_op<matrix_handler> unitTerm;
+    bool fixedMatrix = true;
+    for (const auto &elementaryOp : term) {
+      fixedMatrix = fixedMatrix && isParameterFree(elementaryOp);
+      unitTerm *= product_op<matrix_handler>(matrix_handler(elementaryOp));
+    }
+
+    const auto termIdx = m_terms.size();
+    auto coefficient = term.get_coefficient();
+    m_isConstant = m_isConstant && fixedMatrix && coefficient.is_constant();
+    if (fixedMatrix) {
+      std::unordered_map<std::size_t, int64_t> dimensions;
+      for (auto degree : degrees)
+        dimensions[degree] = m_modeExtents[degree];
+      embed(unitTerm.to_matrix(dimensions), degrees, termIdx, entries);
+      m_terms.push_back({std::move(coefficient), std::nullopt});
+    } else {
+      m_parametricTerms.push_back(termIdx);
+      m_terms.push_back({std::move(coefficient), std::move(unitTerm)});
+    }
+  }
+
+  // Merge the entries of all terms into a single sparsity pattern.
+  std::sort(entries.begin(), entries.end(),
+            [](const Entry &a, const Entry &b) {
+              return std::tie(a.row, a.col, a.term) <
+                     std::tie(b.row, b.col, b.term);
+            });
+  std::vector<Eigen::Triplet<std::complex<double>, int64_t>> positions;
+  m_contribTerms.reserve(entries.size());
+  m_contribValues.reserve(entries.size());
+  for (std::size_t i = 0; i < entries.size(); ++i) {
+    const auto &entry = entries[i];
+    if (i == 0 || entry.row != entries[i - 1].row ||
+        entry.col != entries[i - 1].col) {
+      positions.emplace_back(entry.row, entry.col, 1.0);
+      m_contribOffsets.push_back(m_contribTerms.size());
+    }
+    m_contribTerms.push_back(entry.term);
+    m_contribValues.push_back(entry.value);
+  }
+  m_contribOffsets.push_back(m_contribTerms.size());
+
+  m_pattern.resize(m_dimension, m_dimension);
+  m_pattern.setFromTriplets(positions.begin(), positions.end());
+  m_pattern.makeCompressed();
+  if (static_cast<std::size_t>(m_pattern.nonZeros()) != positions.size())
+    throw std::runtime_error(
+        "[dynamics-cpu] Failed to construct the operator sparsity pattern.");
+}
+
+void CpuDynamicsOperator::embed(const complex_matrix &termMatrix,
+                                const std::vector<std::size_t> &degrees,
+                                std::size_t termIdx,
+                                std::vector<Entry> &entries) const {
+  // Offset in the full space for each index of the term matrix, where the
+  // first (smallest) degree is the least significant one.
+  std::vector<int64_t> offsets{0};
+  for (auto degree : degrees) {
+    const auto size = offsets.size();
+    for (int64_t digit = 1; digit < m_modeExtents[degree]; ++digit)
+      for (std::size_t i = 0; i < size; ++i)
+        offsets.push_back(offsets[i] + digit * m_strides[degree]);
+  }
+  if (offsets.size() != termMatrix.rows() ||
+      offsets.size() != termMatrix.cols())
+    throw std::runtime_error(
+        "[dynamics-cpu] Unexpected dimension of operator matrix.");
+
+  // Indices in the full space where the degrees of the term are all zero.
+  std::vector<int64_t> bases;
+  bases.reserve(m_dimension / offsets.size());
+  for (int64_t idx = 0; idx < m_dimension; ++idx)
+    if (std::all_of(degrees.begin(), degrees.end(), [&](std::size_t degree) {
+          return (idx / m_strides[degree]) % m_modeExtents[degree] == 0;
+        }))
+      bases.push_back(idx);
+
+  for (std::size_t i = 0; i < termMatrix.rows(); ++i)
+    for (std::size_t j = 0; j < termMatrix.cols(); ++j) {
+      const auto value = termMatrix(i, j);
+      if (value == std::complex<double>(0.0))
+        continue;
+      for (auto base : bases)
+        entries.push_back(
+            {base + offsets[i], base + offsets[j], termIdx, value});
+    }
+}
+
+const CpuDynamicsOperator::SparseMatrix &CpuDynamicsOperator::evaluate(
+    const std::unordered_map<std::string, std::complex<double>> &parameters) {
+  if (m_isConstant && m_evaluated)
+    return m_pattern;
+
+  std::vector<std::complex<double>> coefficients;
+  coefficients.reserve(m_terms.size());
+  for (const auto &term : m_terms)
+    coefficients.push_back(term.coefficient.evaluate(parameters));
+
+  auto *values = m_pattern.valuePtr();
+  const int64_t numEntries = m_pattern.nonZeros();
+#if defined(_OPENMP)
+#pragma omp parallel for
+#endif
+  for (int64_t i = 0; i < numEntries; ++i) {
+    std::complex<double> value = 0.0;
+    for (auto k = m_contribOffsets[i]; k < m_contribOffsets[i + 1]; ++k)
+      value += coefficients[m_contribTerms[k]] * m_contribValues[k];
+    values[i] = value;
+  }
+  m_evaluated = true;
+  if (m_parametricTerms.empty())
+    return m_pattern;
+
+  std::vector<Entry> entries;
+  for (auto termIdx : m_parametricTerms) {
+    const auto &op = *m_terms[termIdx].op;
+    const auto degrees = op.degrees();
+    std::unordered_map<std::size_t, int64_t> dimensions;
+    for (auto degree : degrees)
+      dimensions[degree] = m_modeExtents[degree];
+    embed(op.to_matrix(dimensions, parameters), degrees, termIdx, entries);
+  }
+
+  std::vector<Eigen::Triplet<std::complex<double>, int64_t>> triplets;
+  triplets.reserve(m_pattern.nonZeros() + entries.size());
+  for (int64_t row = 0; row < m_pattern.outerSize(); ++row)
+    for (SparseMatrix::InnerIterator it(m_pattern, row); it; ++it)
+      triplets.emplace_back(it.row(), it.col(), it.value());
+  for (const auto &entry : entries)
+    triplets.emplace_back(entry.row, entry.col,
+                          coefficients[entry.term] * entry.value);
+  m_matrix.resize(m_dimension, m_dimension);
+  m_matrix.setFromTriplets(triplets.begin(), triplets.end());
+  return m_matrix;
+}
+
+void CpuDynamicsOperator::multiply(const SparseMatrix &matrix,
+                                   const std::complex<double> *in,
+                                   std::complex<double> *out, int64_t numCols) {
+  const int64_t dim = matrix.rows();
+  const auto *outerIndices = matrix.outerIndexPtr();
+  const auto *innerIndices = matrix.innerIndexPtr();
+  const auto *values = matrix.valuePtr();
+  const auto rowTimesColumn = [&](int64_t row, int64_t col) {
+    const auto *column = in + col * dim;
+    std::complex<double> sum = 0.0;
+    for (auto k = outerIndices[row]; k < outerIndices[row + 1]; ++k)
+      sum += values[k] * column[innerIndices[k]];
+    out[col * dim + row] = sum;
+  };
+
+  // For a single vector, the rows are distributed among the threads, and for
+  // a matrix, each thread computes whole columns.
+  if (numCols == 1) {
+#if defined(_OPENMP)
+#pragma omp parallel for
+#endif
+    for (int64_t row = 0; row < dim; ++row)
+      rowTimesColumn(row, 0);
+    return;
+  }
+#if defined(_OPENMP)
+#pragma omp parallel for
+#endif
+  for (int64_t col = 0; col < numCols; ++col)
+    for (int64_t row = 0; row < dim; ++row)
+      rowTimesColumn(row, col);
+}
+
+} // namespace cudaq
@@ -0,0 +1,91 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include "common/EigenDense.h"
+#include "common/EigenSparse.h"
+#include "cudaq/operators.h"
+
+namespace cudaq {
+/// @cond
+// This is an internal class, no API documentation.
+// Sparse matrix representation of a `matrix_handler` operator on the full
+// Hilbert space of a dynamics problem. Degree `k` of the operator is mapped to
+// the mode with extent `modeExtents[k]`, with degree 0 the least significant
+// index.
+//
+// The matrix of each product term is computed once, with a unit coefficient,
+// and embedded into the full space. Terms whose elementary operators do not
+// depend on parameters share a cached sparsity pattern; evaluating the
+// operator at given parameter values only recomputes the coefficients and
+// refills the values of that pattern. Terms with parametrized elementary
+// operators (e.g., `squeeze`) are re-assembled on every evaluation.
+class CpuDynamicsOperator {
+public:
+  using SparseMatrix =
+      Eigen::SparseMatrix<std::complex<double>, Eigen::RowMajor, int64_t>;
+
+  CpuDynamicsOperator(const sum_op<matrix_handler> &op,
+                      const std::vector<int64_t> &modeExtents);
+
+  /// @brief True if the operator does not depend on any parameters.
+  bool is_constant() const { return m_isConstant; }
+
+  /// @brief Dimension of the full Hilbert space.
+  int64_t dimension() const { return m_dimension; }
+
+  /// @brief Return the matrix of the operator for the given parameter values.
+  /// The returned reference is valid until the next call to `evaluate`.
+  const SparseMatrix &
+  evaluate(const std::unordered_map<std::string, std::complex<double>>
+               &parameters);
+
+  /// @brief Compute `out = matrix * in`, where `in` and `out` are column-major
+  /// dense matrices with `numCols` columns.
+  static void multiply(const SparseMatrix &matrix,
+                       const std::complex<double> *in,
+                       std::complex<double> *out, int64_t numCols);
+
+private:
+  struct Term {
+    scalar_operator coefficient;
+    // Set for terms that are re-assembled on every evaluation.
+    std::optional<product_op<matrix_handler>> op;
+  };
+
+  struct Entry {
+    int64_t row;
+    int64_t col;
+    std::size_t term;
+    std::complex<double> value;
+  };
+
+  // Embed the matrix of a term acting on `degrees` into the full space.
+  void embed(const complex_matrix &termMatrix,
+             const std::vector<std::size_t> &degrees, std::size_t termIdx,
+             std::vector<Entry> &entries) const;
+
+  std::vector<int64_t> m_modeExtents;
+  std::vector<int64_t> m_strides;
+  int64_t m_dimension = 1;
+  bool m_isConstant = true;
+  bool m_evaluated = false;
+  std::vector<Term> m_terms;
+  std::vector<std::size_t> m_parametricTerms;
+  // Union sparsity pattern of the terms with fixed matrices. For each stored
+  // entry `i`, the contributions of those terms are listed in
+  // `[m_contribOffsets[i], m_contribOffsets[i + 1])`.
+  SparseMatrix m_pattern;
+  std::vector<int64_t> m_contribOffsets;
+  std::vector<std::size_t> m_contribTerms;
+  std::vector<std::complex<double>> m_contribValues;
+  SparseMatrix m_matrix;
+};
+/// @endcond
+} // namespace cudaq
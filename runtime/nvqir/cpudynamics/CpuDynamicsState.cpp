@@ -0,0 +1,214 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+#include "CpuDynamicsState.h"
+#include "common/FmtCore.h"
+#include "cudaq/utils/cudaq_utils.h"
+#include <numeric>
+
+namespace cudaq {
+
+static std::size_t
+calculate_state_vector_size(const std::vector<int64_t> &hilbertSpaceDims) {
+  return std::accumulate(hilbertSpaceDims.begin(), hilbertSpaceDims.end(),
+                         std::size_t{1}, std::multiplies<>());
+}
+
+CpuDynamicsState::CpuDynamicsState(Eigen::VectorXcd &&stateData,
+                                   const std::vector<int64_t> &dims)
+    : data(std::move(stateData)) {
+  initialize(dims);
+}
+
+std::size_t CpuDynamicsState::get_dimension() const {
+  return isDensityMatrix ? std::llround(std::sqrt(data.size())) : data.size();
+}
+
+void CpuDynamicsState::initialize(const std::vector<int64_t> &dims) {
+  const std::size_t vectorSize = calculate_state_vector_size(dims);
+  const std::size_t size = data.size();
+  if (size != vectorSize && size != vectorSize * vectorSize)
+    throw std::invalid_argument(
+        fmt::format("Invalid hilbertSpaceDims for the state data: expected {} "
+                    "(state vector) or {} (density matrix) elements, got {}.",
+                    vectorSize, vectorSize * vectorSize, size));
+  // A single one-dimensional degree of freedom cannot be told apart, keep the
+  // current interpretation in that case.
+  if (vectorSize != 1)
+    isDensityMatrix = size == vectorSize * vectorSize;
+  hilbertSpaceDims = dims;
+}
+
+std::complex<double>
+CpuDynamicsState::overlap(const cudaq::SimulationState &other) {
+  if (getTensor().extents != other.getTensor().extents)
+    throw std::runtime_error("[CpuDynamicsState] overlap error - other state "
+                             "dimension not equal to this state dimension.");
+
+  if (other.getPrecision() != getPrecision())
+    throw std::runtime_error(
+        "[CpuDynamicsState] overlap error - precision mismatch.");
+
+  Eigen::Map<const Eigen::VectorXcd> otherData(
+      reinterpret_cast<const std::complex<double> *>(other.getTensor().data),
+      data.size());
+  if (!isDensityMatrix)
+    return std::abs(otherData.dot(data));
+
+  const auto dim = get_dimension();
+  Eigen::Map<const Eigen::MatrixXcd> rho(data.data(), dim, dim);
+  Eigen::Map<const Eigen::MatrixXcd> otherRho(otherData.data(), dim, dim);
+  return (rho.adjoint() * otherRho).trace();
+}
+
+std::complex<double>
+CpuDynamicsState::getAmplitude(const std::vector<int> &basisState) {
+  throw std::runtime_error(
+      "[CpuDynamicsState] getAmplitude by basis states is not supported. "
+      "Please use direct indexing access instead.");
+}
+
+void CpuDynamicsState::dump(std::ostream &os) const {
+  const auto dim = get_dimension();
+  os << Eigen::Map<const Eigen::MatrixXcd>(data.data(), dim,
+                                           isDensityMatrix ? dim : 1)
+     << std::endl;
+}
+
+std::unique_ptr<SimulationState>
+CpuDynamicsState::createFromSizeAndPtr(std::size_t size, void *dataPtr,
+                                       std::size_t type) {
+  bool isDm = false;
+  if (type == cudaq::detail::variant_index<cudaq::state_data,
+                                           cudaq::TensorStateData>()) {
+    if (size != 1)
+      throw std::runtime_error("[CpuDynamicsState]: createFromSizeAndPtr "
+                               "expects a single tensor");
+    auto *casted =
+        reinterpret_cast<cudaq::TensorStateData::value_type *>(dataPtr);
+
+    auto [ptr, extents] = casted[0];
+    if (extents.size() > 2)
+      throw std::runtime_error("[CpuDynamicsState]: createFromSizeAndPtr only "
+                               "accept 1D or 2D arrays");
+
+    isDm = extents.size() == 2;
+    size = std::reduce(extents.begin(), extents.end(), 1, std::multiplies());
+    dataPtr = const_cast<void *>(ptr);
+  }
+
+  Eigen::VectorXcd stateData = Eigen::Map<Eigen::VectorXcd>(
+      reinterpret_cast<std::complex<double> *>(dataPtr), size);
+  return std::make_unique<CpuDynamicsState>(std::move(stateData), isDm);
+}
+
+cudaq::SimulationState::Tensor
+CpuDynamicsState::getTensor(std::size_t tensorIdx) const {
+  if (tensorIdx != 0)
+    throw std::runtime_error(
+        "CpuDynamicsState state only supports a single tensor");
+
+  const auto dim = get_dimension();
+  const std::vector<std::size_t> extents =
+      isDensityMatrix ? std::vector<std::size_t>{dim, dim}
+                      : std::vector<std::size_t>{dim};
+  return Tensor{const_cast<std::complex<double> *>(data.data()), extents,
+                precision::fp64};
+}
+
+std::complex<double>
+CpuDynamicsState::operator()(std::size_t tensorIdx,
+                             const std::vector<std::size_t> &indices) {
+  if (tensorIdx != 0)
+    throw std::runtime_error(
+        "CpuDynamicsState state only supports a single tensor");
+  const auto dim = get_dimension();
+  if (isDensityMatrix) {
+    if (indices.size() != 2)
+      throw std::runtime_error("CpuDynamicsState holding a density matrix "
+                               "supports only 2-dimensional indices");
+    if (indices[0] >= dim || indices[1] >= dim)
+      throw std::runtime_error("CpuDynamicsState indices out of range");
+    return data[indices[1] * dim + indices[0]];
+  }
+  if (indices.size() != 1)
+    throw std::runtime_error("CpuDynamicsState holding a state vector supports "
+                             "only 1-dimensional indices");
+  if (indices[0] >= dim)
+    throw std::runtime_error("Index out of bounds");
+  return data[indices[0]];
+}
+
+void CpuDynamicsState::toHost(std::complex<double> *userData,
+                              std::size_t numElements) const {
+  if (numElements != static_cast<std::size_t>(data.size()))
+    throw std::runtime_error("Number of elements in user data does not match "
+                             "the size of the state");
+  std::copy(data.begin(), data.end(), userData);
+}
+
+void CpuDynamicsState::toHost(std::complex<float> *userData,
+                              std::size_t numElements) const {
+  throw std::runtime_error(
+      "CpuDynamicsState: Data type mismatches - expecting "
+      "double-precision array.");
+}
+
+void CpuDynamicsState::destroyState() {
+  data = Eigen::VectorXcd();
+  isDensityMatrix = false;
+}
+
+CpuDynamicsState CpuDynamicsState::zero_like(const CpuDynamicsState &other) {
+  CpuDynamicsState state(Eigen::VectorXcd::Zero(other.data.size()),
+                         other.isDensityMatrix);
+  state.hilbertSpaceDims = other.hilbertSpaceDims;
+  return state;
+}
+
+CpuDynamicsState CpuDynamicsState::to_density_matrix() const {
+  if (isDensityMatrix)
+    throw std::runtime_error("CpuDynamicsState is already a density matrix.");
+
+  Eigen::VectorXcd rho(data.size() * data.size());
+  Eigen::Map<Eigen::MatrixXcd>(rho.data(), data.size(), data.size()) =
+      data * data.adjoint();
+  CpuDynamicsState state(std::move(rho), true);
+  state.hilbertSpaceDims = hilbertSpaceDims;
+  return state;
+}
+
+CpuDynamicsState
+CpuDynamicsState::operator+(const CpuDynamicsState &other) const {
+  CpuDynamicsState result(Eigen::VectorXcd(data), isDensityMatrix);
+  result.hilbertSpaceDims = hilbertSpaceDims;
+  result += other;
+  return result;
+}
+
+CpuDynamicsState &CpuDynamicsState::operator+=(const CpuDynamicsState &other) {
+  if (data.size() != other.data.size())
+    throw std::invalid_argument(
+        fmt::format("State size mismatch for addition ({} vs {}).",
+                    data.size(), other.data.size()));
+  data += other.data;
+  return *this;
+}
+
+CpuDynamicsState &
+CpuDynamicsState::operator*=(const std::complex<double> &scalar) {
+  data *= scalar;
+  return *this;
+}
+
+CpuDynamicsState CpuDynamicsState::operator*(double scalar) const {
+  CpuDynamicsState result(data * scalar, isDensityMatrix);
+  result.hilbertSpaceDims = hilbertSpaceDims;
+  return result;
+}
+
+} // namespace cudaq
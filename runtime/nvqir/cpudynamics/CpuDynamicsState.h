@@ -0,0 +1,111 @@
+/*************************************************************** -*- C++ -*- ***
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+#pragma once
+
+#include "common/EigenDense.h"
+#include "common/SimulationState.h"
+
+namespace cudaq {
+/// @cond
+// This is an internal class, no API documentation.
+// Simulation state implementation of the CPU dynamics backend. The state is
+// kept in host memory, either as a state vector or as a density matrix stored
+// in column-major order.
+class CpuDynamicsState : public cudaq::SimulationState {
+private:
+  bool isDensityMatrix = false;
+  // Flat state data.
+  Eigen::VectorXcd data;
+  std::vector<int64_t> hilbertSpaceDims;
+
+public:
+  CpuDynamicsState() = default;
+
+  CpuDynamicsState(Eigen::VectorXcd &&data, bool isDm)
+      : isDensityMatrix(isDm), data(std::move(data)) {}
+
+  CpuDynamicsState(Eigen::VectorXcd &&data,
+                   const std::vector<int64_t> &hilbertSpaceDims);
+
+  /// @brief Return the dimension of the Hilbert space of the state.
+  std::size_t get_dimension() const;
+
+  std::size_t getNumQubits() const override {
+    return std::log2(get_dimension());
+  }
+
+  std::complex<double> overlap(const cudaq::SimulationState &other) override;
+
+  std::complex<double>
+  getAmplitude(const std::vector<int> &basisState) override;
+
+  void dump(std::ostream &os) const override;
+
+  bool isArrayLike() const override { return false; }
+
+  precision getPrecision() const override {
+    return cudaq::SimulationState::precision::fp64;
+  }
+
+  std::unique_ptr<SimulationState>
+  createFromSizeAndPtr(std::size_t size, void *dataPtr,
+                       std::size_t type) override;
+
+  Tensor getTensor(std::size_t tensorIdx = 0) const override;
+
+  std::vector<Tensor> getTensors() const override { return {getTensor()}; }
+
+  std::size_t getNumTensors() const override { return 1; }
+
+  std::complex<double>
+  operator()(std::size_t tensorIdx,
+             const std::vector<std::size_t> &indices) override;
+
+  void toHost(std::complex<double> *userData,
+              std::size_t numElements) const override;
+
+  void toHost(std::complex<float> *userData,
+              std::size_t numElements) const override;
+
+  void destroyState() override;
+
+  /// @brief Set the Hilbert space dimensions of the state. Whether the state
+  /// is a state vector or a density matrix is deduced from its size.
+  void initialize(const std::vector<int64_t> &hilbertSpaceDims);
+
+  /// @brief Create a zero state of the same shape as \p other.
+  static CpuDynamicsState zero_like(const CpuDynamicsState &other);
+
+  /// @brief Check if the state is a density matrix.
+  bool is_density_matrix() const { return isDensityMatrix; }
+
+  /// @brief Convert the state vector to a density matrix.
+  CpuDynamicsState to_density_matrix() const;
+
+  /// @brief Get a copy of the `hilbert` space dimensions of the state.
+  std::vector<int64_t> get_hilbert_space_dims() const {
+    return hilbertSpaceDims;
+  }
+
+  /// @brief The flat state data.
+  Eigen::VectorXcd &get_data() { return data; }
+  const Eigen::VectorXcd &get_data() const { return data; }
+
+  /// @brief Element-wise addition.
+  CpuDynamicsState operator+(const CpuDynamicsState &other) const;
+
+  /// @brief Element-wise accumulation.
+  CpuDynamicsState &operator+=(const CpuDynamicsState &other);
+
+  /// @brief Scalar multiplication.
+  CpuDynamicsState &operator*=(const std::complex<double> &scalar);
+
+  CpuDynamicsState operator*(double scalar) const;
+};
+/// @endcond
+} // namespace cudaq
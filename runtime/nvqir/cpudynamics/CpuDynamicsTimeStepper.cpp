@@ -0,0 +1,97 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "CpuDynamicsTimeStepper.h"
+
+namespace cudaq {
+CpuDynamicsTimeStepper::CpuDynamicsTimeStepper(
+    const sum_op<matrix_handler> &hamiltonian,
+    const std::vector<sum_op<matrix_handler>> &collapseOps,
+    const std::vector<int64_t> &modeExtents)
+    : m_hamiltonian(hamiltonian, modeExtents) {
+  m_isConstant = m_hamiltonian.is_constant();
+  m_collapseOps.reserve(collapseOps.size());
+  for (const auto &collapseOp : collapseOps) {
+    m_collapseOps.emplace_back(collapseOp, modeExtents);
+    m_isConstant = m_isConstant && m_collapseOps.back().is_constant();
+  }
+}
+
+const CpuDynamicsOperator::SparseMatrix &
+CpuDynamicsTimeStepper::effectiveHamiltonian(
+    const std::unordered_map<std::string, std::complex<double>> &parameters) {
+  if (m_isConstant && m_hasEffectiveHamiltonian)
+    return m_effectiveHamiltonian;
+
+  m_effectiveHamiltonian = m_hamiltonian.evaluate(parameters);
+  for (auto &collapseOp : m_collapseOps) {
+    const auto &L = collapseOp.evaluate(parameters);
+    CpuDynamicsOperator::SparseMatrix LdagL = L.adjoint() * L;
+    m_effectiveHamiltonian -= std::complex<double>(0.0, 0.5) * LdagL;
+  }
+  m_effectiveHamiltonian.makeCompressed();
+  m_hasEffectiveHamiltonian = true;
+  return m_effectiveHamiltonian;
+}
+
+state CpuDynamicsTimeStepper::compute(
+    const state &inputState, double t, double step_size,
+    const std::unordered_map<std::string, std::complex<double>> &parameters) {
+  if (step_size == 0.0)
+    throw std::runtime_error("Step size cannot be zero.");
+
+  auto *simState =
+      cudaq::state_helper::getSimulationState(const_cast<state *>(&inputState));
+  auto *castSimState = dynamic_cast<CpuDynamicsState *>(simState);
+  if (!castSimState)
+    throw std::runtime_error("Invalid state.");
+  const CpuDynamicsState &state = *castSimState;
+  const int64_t dim = m_hamiltonian.dimension();
+  if (static_cast<int64_t>(state.get_dimension()) != dim)
+    throw std::runtime_error("As the dimensions of the state and the system "
+                             "do not match, the operator cannot act on the "
+                             "state.");
+
+  auto nextState = CpuDynamicsState::zero_like(state);
+  const auto *in = state.get_data().data();
+  auto *out = nextState.get_data().data();
+  const std::complex<double> minusI(0.0, -1.0);
+
+  if (!state.is_density_matrix()) {
+    if (!m_collapseOps.empty())
+      throw std::runtime_error("Collapse operators require the state to be a "
+                               "density matrix.");
+    // d/dt |psi> = -i H |psi>
+    CpuDynamicsOperator::multiply(m_hamiltonian.evaluate(parameters), in, out,
+                                  1);
+    nextState *= minusI;
+    return cudaq::state(new CpuDynamicsState(std::move(nextState)));
+  }
+
+  // d/dt rho = -i (Heff rho - rho Heff^dag) + sum_k L_k rho L_k^dag, where
+  // rho Heff^dag is computed as (Heff rho^dag)^dag.
+  const auto &Heff = effectiveHamiltonian(parameters);
+  Eigen::Map<const Eigen::MatrixXcd> rho(in, dim, dim);
+  Eigen::Map<Eigen::MatrixXcd> drho(out, dim, dim);
+  const Eigen::MatrixXcd rhoAdj = rho.adjoint();
+  Eigen::MatrixXcd tmp(dim, dim);
+  CpuDynamicsOperator::multiply(Heff, in, out, dim);
+  CpuDynamicsOperator::multiply(Heff, rhoAdj.data(), tmp.data(), dim);
+  drho = minusI * (drho - tmp.adjoint());
+
+  Eigen::MatrixXcd tmpAdj(dim, dim);
+  for (auto &collapseOp : m_collapseOps) {
+    const auto &L = collapseOp.evaluate(parameters);
+    CpuDynamicsOperator::multiply(L, rhoAdj.data(), tmp.data(), dim);
+    tmpAdj = tmp.adjoint();
+    CpuDynamicsOperator::multiply(L, tmpAdj.data(), tmp.data(), dim);
+    drho += tmp;
+  }
+  return cudaq::state(new CpuDynamicsState(std::move(nextState)));
+}
+} // namespace cudaq
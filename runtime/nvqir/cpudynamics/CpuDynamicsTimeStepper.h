@@ -0,0 +1,42 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include "CpuDynamicsOperator.h"
+#include "CpuDynamicsState.h"
+#include "cudaq/algorithms/base_time_stepper.h"
+
+namespace cudaq {
+// Computes the time derivative of a state vector (Schrodinger equation) or of
+// a density matrix (Lindblad master equation) on the host.
+class CpuDynamicsTimeStepper : public base_time_stepper {
+public:
+  CpuDynamicsTimeStepper(
+      const sum_op<matrix_handler> &hamiltonian,
+      const std::vector<sum_op<matrix_handler>> &collapseOps,
+      const std::vector<int64_t> &modeExtents);
+
+  state compute(const state &inputState, double t, double step_size,
+                const std::unordered_map<std::string, std::complex<double>>
+                    &parameters) override;
+
+private:
+  // Effective Hamiltonian `H - i/2 * sum_k L_k^dag L_k` of the master
+  // equation. It is cached if neither operator depends on parameters.
+  const CpuDynamicsOperator::SparseMatrix &effectiveHamiltonian(
+      const std::unordered_map<std::string, std::complex<double>>
+          &parameters);
+
+  CpuDynamicsOperator m_hamiltonian;
+  std::vector<CpuDynamicsOperator> m_collapseOps;
+  bool m_isConstant;
+  bool m_hasEffectiveHamiltonian = false;
+  CpuDynamicsOperator::SparseMatrix m_effectiveHamiltonian;
+};
+} // namespace cudaq
@@ -0,0 +1,50 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "CpuDynamicsState.h"
+#include "CpuDynamicsTimeStepper.h"
+#include "RungeKuttaIntegratorCommonImpl.h"
+
+namespace cudaq {
+namespace integrators {
+
+void runge_kutta::setState(const cudaq::state &initial_state, double t0) {
+  auto *simState = cudaq::state_helper::getSimulationState(
+      const_cast<cudaq::state *>(&initial_state));
+  auto *castSimState = dynamic_cast<CpuDynamicsState *>(simState);
+  if (!castSimState)
+    throw std::runtime_error("Invalid state.");
+  // The state is updated in place during the integration, hence copy it to
+  // leave the initial state untouched.
+  m_state =
+      std::make_shared<cudaq::state>(new CpuDynamicsState(*castSimState));
+  m_t = t0;
+}
+
+std::pair<double, cudaq::state> runge_kutta::getState() {
+  auto *simState = cudaq::state_helper::getSimulationState(m_state.get());
+  auto *castSimState = dynamic_cast<CpuDynamicsState *>(simState);
+  if (!castSimState)
+    throw std::runtime_error("Invalid state.");
+
+  // Return a copy, since the integrator keeps updating its state in place.
+  return std::make_pair(m_t,
+                        cudaq::state(new CpuDynamicsState(*castSimState)));
+}
+
+void runge_kutta::integrate(double targetTime) {
+  if (!m_stepper)
+    m_stepper = std::make_unique<CpuDynamicsTimeStepper>(
+        m_system.hamiltonian, m_system.collapseOps, m_system.modeExtents);
+
+  integrateRungeKutta<CpuDynamicsState>(
+      m_order, m_dt, m_schedule, *m_stepper, *m_state, m_t, targetTime,
+      [](const CpuDynamicsState &state) { return CpuDynamicsState(state); });
+}
+} // namespace integrators
+} // namespace cudaq
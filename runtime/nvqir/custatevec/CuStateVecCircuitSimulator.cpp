@@ -697,10 +697,8 @@ public:
       extraWorkspace = nullptr;
     }
 
-    std::vector<std::string> sequentialData;
-    sequentialData.reserve(shots);
-
     cudaq::ExecutionResult counts;
+    counts.sequentialData.reserve(shots, measuredBits.size());
 
     // We've sampled, convert the results to our ExecutionResult counts
     for (int i = 0; i < shots; ++i) {
@@ -708,8 +706,7 @@ public:
                            .to_string()
                            .erase(0, 64 - measuredBits.size());
       std::reverse(bitstring.begin(), bitstring.end());
-      counts.appendResult(bitstring, 1);
-      sequentialData.push_back(std::move(bitstring));
+      counts.appendResult(std::move(bitstring), 1);
     }
 
     // Compute the expectation value from the counts
@@ -239,18 +239,18 @@ void SimulatorTensorNetBase::applyNoiseChannel(
   qubits.insert(qubits.end(), targets.begin(), targets.end());
 
   // Get the Kraus channels specified for this gate and qubits
-  auto krausChannels = executionContext->noiseModel->get_channels(
+  const auto krausChannels = executionContext->noiseModel->lookup_channels(
       gName, targets, controls, params);
 
   // If none, do nothing
-  if (krausChannels.empty())
+  if (krausChannels->empty())
     return;
 
   cudaq::info(
       "[SimulatorTensorNetBase] Applying {} kraus channels on qubits: {}",
-      krausChannels.size(), qubits);
+      krausChannels->size(), qubits);
 
-  for (const auto &krausChannel : krausChannels)
+  for (const auto &krausChannel : *krausChannels)
     applyKrausChannel(qubits, krausChannel);
 }
 
@@ -369,11 +369,9 @@ SimulatorTensorNetBase::sample(const std::vector<std::size_t> &measuredBits,
   }
 
   counts.expectationValue = expVal;
-  counts.sequentialData.resize(sum_counts);
-  std::size_t s = 0;
+  counts.sequentialData.clear();
   for (auto &kv : counts.counts)
-    for (std::size_t c = 0; c < kv.second; c++)
-      counts.sequentialData[s++] = kv.first;
+    counts.sequentialData.append(kv.first, kv.second);
 
   return counts;
 }
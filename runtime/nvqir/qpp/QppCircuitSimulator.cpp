@@ -10,10 +10,19 @@
 #include "nvqir/Gates.h"
 
 #include <bit>
+#include <cerrno>
+#include <cstdlib>
 #include <iostream>
+#include <map>
+#include <optional>
 #include <qpp.h>
+#include <random>
 #include <set>
 #include <span>
+#include <unistd.h>
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
 
 using namespace cudaq;
 
@@ -128,6 +137,12 @@ protected:
   /// The QPP state representation (qpp::ket or qpp::cmat)
   StateType state;
 
+  /// @brief The random number stream of this simulator instance, used for
+  /// every random draw on state vectors (measurements, sampling, noise and
+  /// resets). Unlike the Q++ generator, it is not shared with the simulators
+  /// of other threads.
+  std::mt19937 randomEngine{std::random_device{}()};
+
   /// @brief Convert internal qubit index to Q++ qubit index.
   ///
   /// In Q++, qubits are indexed from left to right, and thus q0 is the leftmost
@@ -144,7 +159,8 @@ protected:
   }
 
   /// @brief Compute the expectation value <Z...Z> over the given qubit indices.
-  double calculateExpectationValue(const std::vector<std::size_t> &qubits) {
+  double calculateExpectationValue(const StateType &psi,
+                                   const std::vector<std::size_t> &qubits) {
     std::size_t bitmask = 0;
     for (auto q : qubits)
       bitmask |= (1ULL << q);
@@ -154,19 +170,20 @@ protected:
 
     std::vector<double> result;
     if constexpr (std::is_same_v<StateType, qpp::ket>) {
-      result.resize(stateDimension);
+      const auto dim = static_cast<std::size_t>(psi.size());
+      result.resize(dim);
 #if defined(_OPENMP)
 #pragma omp parallel for
 #endif
-      for (std::size_t i = 0; i < stateDimension; ++i)
-        result[i] = (hasEvenParity(i) ? 1.0 : -1.0) * std::norm(state[i]);
+      for (std::size_t i = 0; i < dim; ++i)
+        result[i] = (hasEvenParity(i) ? 1.0 : -1.0) * std::norm(psi[i]);
     } else if constexpr (std::is_same_v<StateType, qpp::cmat>) {
-      Eigen::VectorXcd diag = state.diagonal();
-      result.resize(state.rows());
+      Eigen::VectorXcd diag = psi.diagonal();
+      result.resize(psi.rows());
 #if defined(_OPENMP)
 #pragma omp parallel for
 #endif
-      for (Eigen::Index i = 0; i < state.rows(); ++i)
+      for (Eigen::Index i = 0; i < psi.rows(); ++i)
         result[i] = hasEvenParity(i) ? diag(i).real() : -diag(i).real();
     }
 
@@ -174,6 +191,50 @@ protected:
     return std::accumulate(result.begin(), result.end(), 0.0);
   }
 
+  /// @brief Compute the expectation value of a single Pauli string without
+  /// materializing its matrix.
+  ///
+  /// The Pauli string is described by `xMask` (qubits with an X or Y, i.e.,
+  /// bit flips), `zMask` (qubits with a Z or Y, i.e., sign flips) and the
+  /// number of Y operators, using Y = iXZ. Bit `q` of each mask refers to
+  /// CUDA-Q qubit `q`, which matches the bit ordering of the state indices.
+  std::complex<double> calculatePauliExpectationValue(const StateType &psi,
+                                                      std::size_t xMask,
+                                                      std::size_t zMask,
+                                                      std::size_t numY) {
+    double re = 0.0, im = 0.0;
+    if constexpr (std::is_same_v<StateType, qpp::ket>) {
+      // <psi|P|psi> = sum_i conj(psi[i ^ x]) * (-1)^|i & z| * psi[i]
+      const auto dim = static_cast<std::size_t>(psi.size());
+#if defined(_OPENMP)
+#pragma omp parallel for reduction(+ : re, im)
+#endif
+      for (std::size_t i = 0; i < dim; ++i) {
+        const std::complex<double> v = std::conj(psi[i ^ xMask]) * psi[i];
+        const bool odd = std::popcount(i & zMask) & 1;
+        re += odd ? -v.real() : v.real();
+        im += odd ? -v.imag() : v.imag();
+      }
+    } else if constexpr (std::is_same_v<StateType, qpp::cmat>) {
+      // Tr(P rho) = sum_i (-1)^|i & z| * rho[i, i ^ x]
+      const auto dim = static_cast<std::size_t>(psi.rows());
+#if defined(_OPENMP)
+#pragma omp parallel for reduction(+ : re, im)
+#endif
+      for (std::size_t i = 0; i < dim; ++i) {
+        const std::complex<double> v = psi(i, i ^ xMask);
+        const bool odd = std::popcount(i & zMask) & 1;
+        re += odd ? -v.real() : v.real();
+        im += odd ? -v.imag() : v.imag();
+      }
+    }
+
+    // Apply the global phase i^numY picked up from Y = iXZ.
+    static constexpr std::complex<double> phases[] = {
+        {1.0, 0.0}, {0.0, 1.0}, {-1.0, 0.0}, {0.0, -1.0}};
+    return phases[numY % 4] * std::complex<double>(re, im);
+  }
+
   qpp::cmat toQppMatrix(const std::vector<std::complex<double>> &data,
                         std::size_t nTargets) {
     auto nRows = (1UL << nTargets);
@@ -186,6 +247,496 @@ protected:
         const_cast<std::complex<double> *>(data.data()), nRows, nRows);
   }
 
+  /// @brief An operation of a noisy circuit, recorded to be replayed once per
+  /// trajectory. Qubit indices are CUDA-Q indices, they are converted to Q++
+  /// indices on replay, once the number of qubits is known.
+  struct TrajectoryOp {
+    enum class Kind { Gate, Noise, Reset };
+    Kind kind;
+    std::vector<std::size_t> controls;
+    std::vector<std::size_t> targets;
+    /// The gate matrix, or the Kraus operators of a noise channel. For a
+    /// channel that is a unitary mixture, these are the unitaries, drawn with
+    /// `probabilities`.
+    std::vector<qpp::cmat> matrices;
+    std::vector<double> probabilities;
+
+    /// @brief Return true if this operation is not deterministic.
+    bool isStochastic() const { return kind != Kind::Gate; }
+
+    /// @brief Return true if the Kraus operator to apply depends on the state,
+    /// i.e., this is a reset or a channel that is not a unitary mixture.
+    bool isStateDependent() const {
+      return kind == Kind::Reset ||
+             (kind == Kind::Noise && probabilities.empty());
+    }
+  };
+
+  /// @brief A set of trajectories that sampled the same errors, and that thus
+  /// end in the same state.
+  struct TrajectoryGroup {
+    std::size_t firstTrajectory = 0;
+    std::size_t numTrajectories = 0;
+    std::size_t numShots = 0;
+  };
+
+  /// @brief Default number of trajectories used to estimate an expectation
+  /// value of a noisy circuit.
+  static constexpr std::size_t defaultNumTrajectories = 1000;
+
+  /// @brief Environment variable name that caps the number of threads running
+  /// trajectories in parallel. Each thread holds copies of the state vector.
+  static constexpr const char maxTrajectoryThreadsEnvVar[] =
+      "CUDAQ_MAX_TRAJECTORY_THREADS";
+
+  /// @brief Number of state vectors a thread running trajectories may hold at
+  /// once: its copy of the initial state, and the temporaries of applying an
+  /// operation to it.
+  static constexpr std::size_t statesPerTrajectoryThread = 3;
+
+  /// @brief The operations of the noisy circuit recorded since the start of
+  /// the execution context. While recording, `state` holds the initial state,
+  /// and each trajectory replays the operations on a copy of it.
+  std::vector<TrajectoryOp> trajectoryOps;
+
+  /// @brief Whether the operations are recorded for trajectory simulation.
+  bool recordTrajectories = false;
+
+  /// @brief Return true if the current execution context should simulate
+  /// noise with trajectories. This needs all the shots to run the same
+  /// circuit, so kernels with conditional feedback (one shot per kernel
+  /// invocation) apply noise in place instead.
+  bool shouldRecordTrajectories() const {
+    if constexpr (!std::is_same_v<StateType, qpp::ket>)
+      return false;
+    return executionContext && executionContext->noiseModel &&
+           (executionContext->name == "sample" ||
+            executionContext->name == "observe") &&
+           !executionContext->hasConditionalsOnMeasureResults &&
+           !executionContext->explicitMeasurements;
+  }
+
+  /// @brief Return true if the recorded operations contain noise or resets.
+  bool hasStochasticTrajectoryOps() const {
+    return std::any_of(
+        trajectoryOps.begin(), trajectoryOps.end(),
+        [](const TrajectoryOp &op) { return op.isStochastic(); });
+  }
+
+  /// @brief Return the number of trajectories to run for the given number of
+  /// shots, or for an expectation value if `shots` is 0.
+  std::size_t getNumTrajectories(std::size_t shots) const {
+    std::size_t numTrajectories = shots > 0 ? shots : defaultNumTrajectories;
+    if (executionContext && executionContext->numberTrajectories.has_value())
+      numTrajectories =
+          std::max<std::size_t>(1, *executionContext->numberTrajectories);
+    // Trajectories without any shot would be wasted.
+    return shots > 0 ? std::min(numTrajectories, shots) : numTrajectories;
+  }
+
+  /// @brief Return the number of threads to run `numGroups` groups of
+  /// trajectories on. This is at most the `CUDAQ_MAX_TRAJECTORY_THREADS`
+  /// setting (all the OpenMP threads by default), and at most as many threads
+  /// as the available memory holds the state vectors of.
+  std::size_t getNumTrajectoryThreads(std::size_t numGroups) const {
+#if defined(_OPENMP)
+    std::size_t numThreads = omp_get_max_threads();
+#else
+    std::size_t numThreads = 1;
+#endif
+    if (const char *envVal = std::getenv(maxTrajectoryThreadsEnvVar)) {
+      const std::string maxThreadsStr(envVal);
+      char *endptr = nullptr;
+      errno = 0;
+      const long value = std::strtol(maxThreadsStr.c_str(), &endptr, 10);
+      if (endptr == maxThreadsStr.c_str() || errno != 0 || value <= 0)
+        throw std::runtime_error(
+            std::string("Invalid ") + maxTrajectoryThreadsEnvVar +
+            " setting. Expected a positive number. Got: " + maxThreadsStr);
+      numThreads = std::min<std::size_t>(numThreads, value);
+    }
+#if defined(_SC_AVPHYS_PAGES)
+    const long pages = sysconf(_SC_AVPHYS_PAGES);
+    const long pageSize = sysconf(_SC_PAGESIZE);
+    if (pages > 0 && pageSize > 0) {
+      const std::size_t threadBytes =
+          statesPerTrajectoryThread * state.size() * sizeof(qpp::cplx);
+      const std::size_t availableBytes =
+          static_cast<std::size_t>(pages) * static_cast<std::size_t>(pageSize);
+      numThreads = std::min(numThreads, availableBytes / threadBytes);
+    }
+#endif
+    return std::max<std::size_t>(1, std::min(numThreads, numGroups));
+  }
+
+  /// @brief Draw an index with the given probabilities.
+  template <typename RandomEngine>
+  static std::size_t sampleIndex(const std::vector<double> &probabilities,
+                                 RandomEngine &rng) {
+    const double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+    double cumulative = 0.0;
+    for (std::size_t i = 0; i + 1 < probabilities.size(); ++i) {
+      cumulative += probabilities[i];
+      if (u < cumulative)
+        return i;
+    }
+    return probabilities.size() - 1;
+  }
+
+  /// @brief Convert a Kraus channel acting on `qubits` to a recorded
+  /// operation.
+  TrajectoryOp toTrajectoryOp(const cudaq::kraus_channel &channel,
+                              const std::vector<std::size_t> &qubits) {
+    TrajectoryOp op{TrajectoryOp::Kind::Noise, {}, qubits, {}, {}};
+    if (channel.is_unitary_mixture()) {
+      for (auto &unitary : channel.unitary_ops)
+        op.matrices.push_back(toQppMatrix(unitary, qubits.size()));
+      op.probabilities = channel.probabilities;
+      return op;
+    }
+    for (auto &kraus : channel.get_ops())
+      // Note: Kraus channel flattened matrix data is **row-major**.
+      op.matrices.push_back(
+          Eigen::Map<Eigen::Matrix<std::complex<double>, Eigen::Dynamic,
+                                   Eigen::Dynamic, Eigen::RowMajor>>(
+              kraus.data.data(), kraus.nRows, kraus.nCols));
+    return op;
+  }
+
+  /// @brief Apply a recorded operation to the state `psi` of `numQubits`
+  /// qubits, drawing the Kraus operator of a noise channel with `rng` unless
+  /// it was drawn beforehand (`choice`).
+  template <typename RandomEngine>
+  static void applyTrajectoryOp(qpp::ket &psi, std::size_t numQubits,
+                                const TrajectoryOp &op, RandomEngine &rng,
+                                std::optional<std::size_t> choice = {}) {
+    auto toQpp = [numQubits](const std::vector<std::size_t> &qubits) {
+      std::vector<std::size_t> converted;
+      for (auto q : qubits)
+        converted.push_back(numQubits - q - 1);
+      return converted;
+    };
+
+    switch (op.kind) {
+    case TrajectoryOp::Kind::Gate:
+      if (op.controls.empty())
+        psi = qpp::apply(psi, op.matrices[0], toQpp(op.targets));
+      else
+        psi = qpp::applyCTRL(psi, op.matrices[0], toQpp(op.controls),
+                             toQpp(op.targets));
+      return;
+    case TrajectoryOp::Kind::Noise: {
+      if (!op.probabilities.empty()) {
+        const auto k = choice ? *choice : sampleIndex(op.probabilities, rng);
+        if (!op.matrices[k].isIdentity())
+          psi = qpp::apply(psi, op.matrices[k], toQpp(op.targets));
+        return;
+      }
+      // Draw K_k with probability ||K_k psi||^2, one Kraus operator at a time
+      // to only hold a single candidate state.
+      const auto targets = toQpp(op.targets);
+      const double u =
+          std::uniform_real_distribution<double>(0.0, psi.squaredNorm())(rng);
+      double cumulative = 0.0;
+      qpp::ket fallback;
+      for (auto &kraus : op.matrices) {
+        qpp::ket candidate = qpp::apply(psi, kraus, targets);
+        const double p = candidate.squaredNorm();
+        if (p <= 0.0)
+          continue;
+        cumulative += p;
+        if (u < cumulative) {
+          psi = candidate / std::sqrt(p);
+          return;
+        }
+        fallback = std::move(candidate);
+      }
+      // Rounding errors: keep the last operator with a non-zero probability.
+      psi = fallback / fallback.norm();
+      return;
+    }
+    case TrajectoryOp::Kind::Reset: {
+      // The CUDA-Q qubit index is the bit position in the state index.
+      const std::size_t mask = 1ULL << op.targets[0];
+      const auto dim = static_cast<std::size_t>(psi.size());
+      double p1 = 0.0;
+      for (std::size_t i = 0; i < dim; ++i)
+        if (i & mask)
+          p1 += std::norm(psi[i]);
+      const bool one =
+          std::uniform_real_distribution<double>(0.0, psi.squaredNorm())(
+              rng) < p1;
+      const double scale = 1.0 / std::sqrt(one ? p1 : 1.0 - p1);
+      for (std::size_t i = 0; i < dim; ++i) {
+        if (!(i & mask))
+          continue;
+        // Project on the outcome, then flip |1> back to |0>.
+        psi[i ^ mask] = one ? psi[i] * scale : psi[i ^ mask] * scale;
+        psi[i] = 0.0;
+      }
+      return;
+    }
+    }
+  }
+
+  /// @brief Apply the recorded operations to `state` in place. If some are
+  /// stochastic, this draws a single trajectory and the remaining operations
+  /// of the circuit are applied in place too.
+  void flushTrajectoryOps() {
+    if constexpr (std::is_same_v<StateType, qpp::ket>) {
+      if (trajectoryOps.empty())
+        return;
+      if (hasStochasticTrajectoryOps()) {
+        cudaq::info("[qpp] Collapsing the noisy circuit to a single "
+                    "trajectory.");
+        recordTrajectories = false;
+      }
+      const auto numQubits = static_cast<std::size_t>(std::log2(state.size()));
+      for (auto &op : trajectoryOps)
+        applyTrajectoryOp(state, numQubits, op, randomEngine);
+      trajectoryOps.clear();
+    }
+  }
+
+  /// @brief Run `numTrajectories` trajectories of the recorded circuit,
+  /// splitting `shots` among them, and return `process(psi, group, rng)` for
+  /// each group of trajectories ending in the same state `psi`.
+  ///
+  /// Trajectories draw the errors of unitary mixture channels up front, and
+  /// the trajectories that draw the same errors are simulated once. Groups
+  /// run in parallel, and every trajectory has its own random number streams
+  /// derived from the simulator seed, such that the results do not depend on
+  /// the number of threads. Each thread holds a copy of the state vector, so
+  /// the number of threads is bounded by the available memory.
+  template <typename Result, typename Function>
+  std::vector<Result> runTrajectories(std::size_t numTrajectories,
+                                      std::size_t shots, Function &&process) {
+    const auto numQubits = static_cast<std::size_t>(std::log2(state.size()));
+    const std::uint32_t seed = randomEngine();
+    // Stream 0 draws the errors of a trajectory, stream 1 its shots.
+    auto makeRng = [seed](std::size_t trajectory, std::uint32_t stream) {
+      std::seed_seq seq{seed, static_cast<std::uint32_t>(trajectory),
+                        static_cast<std::uint32_t>(trajectory >> 32), stream};
+      return std::mt19937(seq);
+    };
+
+    const bool stateDependent = std::any_of(
+        trajectoryOps.begin(), trajectoryOps.end(),
+        [](const TrajectoryOp &op) { return op.isStateDependent(); });
+    // An error pattern lists the (operation, Kraus operator) pairs where a
+    // trajectory did not draw the most likely Kraus operator.
+    using ErrorPattern = std::vector<std::pair<std::size_t, std::size_t>>;
+    std::vector<std::size_t> mostLikely(trajectoryOps.size(), 0);
+    for (std::size_t i = 0; i < trajectoryOps.size(); ++i) {
+      const auto &probabilities = trajectoryOps[i].probabilities;
+      if (!probabilities.empty())
+        mostLikely[i] = std::distance(
+            probabilities.begin(),
+            std::max_element(probabilities.begin(), probabilities.end()));
+    }
+
+    std::vector<TrajectoryGroup> groups;
+    std::vector<ErrorPattern> patterns;
+    std::map<ErrorPattern, std::size_t> groupIndex;
+    for (std::size_t t = 0; t < numTrajectories; ++t) {
+      const std::size_t numShots =
+          shots / numTrajectories + (t < shots % numTrajectories ? 1 : 0);
+      // Errors drawn from the state cannot be drawn up front.
+      if (stateDependent) {
+        groups.push_back({t, 1, numShots});
+        continue;
+      }
+      auto rng = makeRng(t, 0);
+      ErrorPattern pattern;
+      for (std::size_t i = 0; i < trajectoryOps.size(); ++i) {
+        if (!trajectoryOps[i].isStochastic())
+          continue;
+        const auto k = sampleIndex(trajectoryOps[i].probabilities, rng);
+        if (k != mostLikely[i])
+          pattern.emplace_back(i, k);
+      }
+      auto [iter, inserted] = groupIndex.try_emplace(pattern, groups.size());
+      if (inserted) {
+        groups.push_back({t, 0, 0});
+        patterns.push_back(std::move(pattern));
+      }
+      groups[iter->second].numTrajectories++;
+      groups[iter->second].numShots += numShots;
+    }
+    cudaq::info("[qpp] Running {} trajectories as {} distinct trajectories.",
+                numTrajectories, groups.size());
+
+    std::vector<Result> results(groups.size());
+    [[maybe_unused]] const int numThreads =
+        getNumTrajectoryThreads(groups.size());
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic) num_threads(numThreads)             \
+    if (numThreads > 1)
+#endif
+    for (std::size_t g = 0; g < groups.size(); ++g) {
+      auto rng = makeRng(groups[g].firstTrajectory, 0);
+      qpp::ket psi = state;
+      std::size_t next = 0;
+      for (std::size_t i = 0; i < trajectoryOps.size(); ++i) {
+        const auto &op = trajectoryOps[i];
+        std::optional<std::size_t> choice;
+        if (!stateDependent && op.isStochastic()) {
+          const auto &pattern = patterns[g];
+          choice = next < pattern.size() && pattern[next].first == i
+                       ? pattern[next++].second
+                       : mostLikely[i];
+        }
+        applyTrajectoryOp(psi, numQubits, op, rng, choice);
+      }
+      auto shotsRng = makeRng(groups[g].firstTrajectory, 1);
+      results[g] = process(psi, groups[g], shotsRng);
+    }
+    return results;
+  }
+
+  /// @brief Average `evaluate(psi)` over trajectories of the recorded circuit.
+  template <typename Function>
+  double averageOverTrajectories(Function &&evaluate) {
+    const auto numTrajectories = getNumTrajectories(0);
+    const auto values = runTrajectories<double>(
+        numTrajectories, 0,
+        [&](const qpp::ket &psi, const TrajectoryGroup &group, auto &) {
+          return group.numTrajectories * evaluate(psi);
+        });
+    // Accumulate in group order to ensure repeatability
+    return std::accumulate(values.begin(), values.end(), 0.0) /
+           numTrajectories;
+  }
+
+  /// @brief Sample `shots` bit strings of `qubits` from the state `psi`.
+  template <typename RandomEngine>
+  static std::map<std::string, std::size_t>
+  sampleShots(const qpp::ket &psi, const std::vector<std::size_t> &qubits,
+              std::size_t shots, RandomEngine &rng) {
+    std::map<std::string, std::size_t> counts;
+    if (shots == 0)
+      return counts;
+
+    // Walk the state once with sorted uniform draws, instead of building a
+    // cumulative distribution as large as the state.
+    std::uniform_real_distribution<double> uniform(0.0, psi.squaredNorm());
+    std::vector<double> draws(shots);
+    for (auto &draw : draws)
+      draw = uniform(rng);
+    std::sort(draws.begin(), draws.end());
+
+    auto toBitString = [&](std::size_t index) {
+      std::string bits(qubits.size(), '0');
+      for (std::size_t j = 0; j < qubits.size(); ++j)
+        if ((index >> qubits[j]) & 1)
+          bits[j] = '1';
+      return bits;
+    };
+
+    double cumulative = 0.0;
+    std::size_t next = 0, lastNonZero = 0;
+    const auto dim = static_cast<std::size_t>(psi.size());
+    for (std::size_t i = 0; i < dim && next < shots; ++i) {
+      const double p = std::norm(psi[i]);
+      if (p == 0.0)
+        continue;
+      lastNonZero = i;
+      cumulative += p;
+      std::size_t count = 0;
+      for (; next < shots && draws[next] < cumulative; ++next)
+        ++count;
+      if (count > 0)
+        counts[toBitString(i)] += count;
+    }
+    // Rounding errors: give the remaining draws to the last basis state.
+    if (next < shots)
+      counts[toBitString(lastNonZero)] += shots - next;
+    return counts;
+  }
+
+  /// @brief Sample the recorded noisy circuit with trajectories.
+  cudaq::ExecutionResult
+  sampleTrajectories(const std::vector<std::size_t> &qubits, const int shots) {
+    if (shots < 1) {
+      double expectationValue = averageOverTrajectories(
+          [&](const qpp::ket &psi) {
+            return calculateExpectationValue(psi, qubits);
+          });
+      cudaq::info("Computed expectation value over trajectories = {}",
+                  expectationValue);
+      return cudaq::ExecutionResult{{}, expectationValue};
+    }
+
+    using Counts = std::map<std::string, std::size_t>;
+    const auto groupCounts = runTrajectories<Counts>(
+        getNumTrajectories(shots), shots,
+        [&](const qpp::ket &psi, const TrajectoryGroup &group, auto &rng) {
+          return sampleShots(psi, qubits, group.numShots, rng);
+        });
+
+    cudaq::ExecutionResult counts;
+    // Expectation value from the counts
+    double expVal = 0.0;
+    for (auto &groupCount : groupCounts)
+      for (auto &[bitstring, count] : groupCount) {
+        counts.appendResult(bitstring, count);
+        auto p = count / (double)shots;
+        expVal += cudaq::sample_result::has_even_parity(bitstring) ? p : -p;
+      }
+    counts.expectationValue = expVal;
+    return counts;
+  }
+
+  /// @brief Apply a Kraus channel on `qubits`: record it for trajectory
+  /// simulation, or draw one of its Kraus operators and apply it in place.
+  void applyKrausChannel(const cudaq::kraus_channel &channel,
+                         const std::vector<std::size_t> &qubits) {
+    auto op = toTrajectoryOp(channel, qubits);
+    if (recordTrajectories) {
+      trajectoryOps.push_back(std::move(op));
+      return;
+    }
+    if constexpr (std::is_same_v<StateType, qpp::ket>)
+      applyTrajectoryOp(state,
+                        static_cast<std::size_t>(std::log2(stateDimension)), op,
+                        randomEngine);
+  }
+
+  /// @brief Apply the Kraus channels of the noise model for the given gate.
+  void applyNoiseChannel(const std::string_view gateName,
+                         const std::vector<std::size_t> &controls,
+                         const std::vector<std::size_t> &targets,
+                         const std::vector<double> &params) override {
+    // Do nothing if no execution context or no noise model
+    if (!executionContext || !executionContext->noiseModel)
+      return;
+
+    const auto krausChannels = executionContext->noiseModel->lookup_channels(
+        std::string(gateName), targets, controls, params);
+    if (krausChannels->empty())
+      return;
+
+    std::vector<std::size_t> qubits{controls.begin(), controls.end()};
+    qubits.insert(qubits.end(), targets.begin(), targets.end());
+    cudaq::info("Applying {} kraus channels to qubits {}",
+                krausChannels->size(), qubits);
+    for (auto &channel : *krausChannels)
+      applyKrausChannel(channel, qubits);
+  }
+
+  /// @brief This simulator supports all noise channels
+  bool isValidNoiseChannel(const cudaq::noise_model_type &type) const override {
+    return true;
+  }
+
+  /// @brief Apply the given noise channel
+  void applyNoise(const cudaq::kraus_channel &channel,
+                  const std::vector<std::size_t> &qubits) override {
+    flushGateQueue();
+    cudaq::info("[qpp] apply kraus channel {}", channel.get_type_name());
+    applyKrausChannel(channel, qubits);
+  }
+
   /// @brief Grow the state vector by one qubit.
   void addQubitToState() override { addQubitsToState(1); }
 
@@ -238,10 +789,19 @@ protected:
   void deallocateStateImpl() override {
     StateType tmp;
     state = tmp;
+    trajectoryOps.clear();
   }
 
   void applyGate(const GateApplicationTask &task) override {
     auto matrix = toQppMatrix(task.matrix, task.targets.size());
+    if (recordTrajectories) {
+      trajectoryOps.push_back({TrajectoryOp::Kind::Gate,
+                               task.controls,
+                               task.targets,
+                               {std::move(matrix)},
+                               {}});
+      return;
+    }
     // First, convert all of the qubit indices to big endian.
     std::vector<std::size_t> controls;
     for (auto index : task.controls) {
@@ -265,9 +825,47 @@ protected:
     state(0) = 1.0;
   }
 
+  /// @brief Stop recording the noisy circuit at a measurement. The result of
+  /// the measurement depends on the errors of a trajectory, so the recorded
+  /// circuit collapses to a single trajectory. Sampled kernels never get here:
+  /// without conditional feedback, their measurements are deferred to the end
+  /// of the kernel, and with it, they do not record trajectories.
+  void stopRecordingAtMeasurement() {
+    recordTrajectories = false;
+    if (!hasStochasticTrajectoryOps())
+      return;
+    cudaq::warn("Measurement in a noisy circuit: the results are computed "
+                "from a single noise trajectory.");
+  }
+
   /// @brief Measure the qubit and return the result. Collapse the
   /// state vector.
   bool measureQubit(const std::size_t index) override {
+    if (recordTrajectories)
+      stopRecordingAtMeasurement();
+    flushTrajectoryOps();
+    if constexpr (std::is_same_v<StateType, qpp::ket>) {
+      // Bit `index` of the state indices refers to CUDA-Q qubit `index`.
+      const auto dim = static_cast<std::size_t>(state.size());
+      const std::size_t mask = 1ULL << index;
+      double probabilityOne = 0.0;
+      for (std::size_t i = 0; i < dim; ++i)
+        if (i & mask)
+          probabilityOne += std::norm(state[i]);
+      const double total = state.squaredNorm();
+      std::uniform_real_distribution<double> uniform(0.0, total);
+      const bool result = uniform(randomEngine) < probabilityOne;
+      const double norm =
+          std::sqrt(result ? probabilityOne : total - probabilityOne);
+#if defined(_OPENMP)
+#pragma omp parallel for
+#endif
+      for (std::size_t i = 0; i < dim; ++i)
+        state[i] = static_cast<bool>(i & mask) == result ? state[i] / norm
+                                                          : 0.0;
+      cudaq::info("Measured qubit {} -> {}", index, result);
+      return result;
+    }
     const auto qubitIdx = convertQubitIndex(index);
     // If here, then we care about the result bit, so compute it.
     const auto measurement_tuple =
@@ -300,6 +898,28 @@ public:
 
   void setRandomSeed(std::size_t seed) override {
     qpp::RandomDevices::get_instance().get_prng().seed(seed);
+    randomEngine.seed(seed);
+  }
+
+  void setInstanceRandomSeed(std::size_t seed) override {
+    randomEngine.seed(seed);
+  }
+
+  /// @brief Density matrices are measured, sampled and reset with the Q++
+  /// generator, which is shared by all threads.
+  bool canSimulateShotsConcurrently() const override {
+    return std::is_same_v<StateType, qpp::ket>;
+  }
+
+  void setExecutionContext(cudaq::ExecutionContext *context) override {
+    CircuitSimulatorBase<double>::setExecutionContext(context);
+    recordTrajectories = shouldRecordTrajectories();
+  }
+
+  void resetExecutionContext() override {
+    CircuitSimulatorBase<double>::resetExecutionContext();
+    trajectoryOps.clear();
+    recordTrajectories = false;
   }
 
   bool canHandleObserve() override {
@@ -316,20 +936,66 @@ public:
     assert(cudaq::spin_op::canonicalize(op) == op);
     flushGateQueue();
 
-    // The op is on the following target bits.
-    auto targets = op.degrees();
+    // Evaluate the operator term by term directly on the state, using the
+    // bit-flip and phase masks of each Pauli string. This avoids forming the
+    // dense matrix of the full operator, which is O(4^n) in memory.
+    struct PauliMasks {
+      std::complex<double> coeff;
+      std::size_t xMask, zMask, numY;
+    };
+    std::vector<PauliMasks> paulis;
+    std::complex<double> identitySum = 0.0;
+    for (const auto &term : op) {
+      const auto coeff = term.evaluate_coefficient();
+      if (term.is_identity()) {
+        identitySum += coeff;
+        continue;
+      }
+
+      std::size_t xMask = 0, zMask = 0, numY = 0;
+      for (const auto &p : term) {
+        const auto target = p.target();
+        if (target >= nQubitsAllocated)
+          throw std::runtime_error(fmt::format(
+              "[qpp] observe: spin operator acts on qubit {} but only {} "
+              "qubits are allocated.",
+              target, nQubitsAllocated));
+        switch (p.as_pauli()) {
+        case cudaq::pauli::X:
+          xMask |= (1ULL << target);
+          break;
+        case cudaq::pauli::Y:
+          xMask |= (1ULL << target);
+          zMask |= (1ULL << target);
+          ++numY;
+          break;
+        case cudaq::pauli::Z:
+          zMask |= (1ULL << target);
+          break;
+        case cudaq::pauli::I:
+          break;
+        }
+      }
+      paulis.push_back({coeff, xMask, zMask, numY});
+    }
 
-    // Get the matrix as an Eigen matrix
-    auto matrix = op.to_matrix();
-    qpp::cmat asEigen = matrix.as_eigen();
+    auto evaluate = [&](const StateType &psi) {
+      std::complex<double> sum = identitySum;
+      for (const auto &[coeff, xMask, zMask, numY] : paulis)
+        sum += coeff * calculatePauliExpectationValue(psi, xMask, zMask, numY);
+      return sum.real();
+    };
 
-    // Compute the expected value
     double ee = 0.0;
     if constexpr (std::is_same_v<StateType, qpp::ket>) {
-      qpp::ket k = qpp::apply(state, asEigen, targets, 2);
-      ee = state.dot(k).real();
+      if (hasStochasticTrajectoryOps())
+        ee = averageOverTrajectories(evaluate);
+      else {
+        flushTrajectoryOps();
+        ee = evaluate(state);
+      }
     } else {
-      ee = qpp::apply(asEigen, state, targets).trace().real();
+      ee = evaluate(state);
     }
 
     return cudaq::observe_result(
@@ -342,6 +1008,17 @@ public:
   void resetQubit(const std::size_t index) override {
     flushGateQueue();
     flushAnySamplingTasks();
+    if (recordTrajectories) {
+      trajectoryOps.push_back({TrajectoryOp::Kind::Reset, {}, {index}, {}, {}});
+      return;
+    }
+    if constexpr (std::is_same_v<StateType, qpp::ket>) {
+      applyTrajectoryOp(state,
+                        static_cast<std::size_t>(std::log2(stateDimension)),
+                        {TrajectoryOp::Kind::Reset, {}, {index}, {}, {}},
+                        randomEngine);
+      return;
+    }
     const auto qubitIdx = convertQubitIndex(index);
     state = qpp::reset(state, {qubitIdx});
   }
@@ -349,33 +1026,48 @@ public:
   /// @brief Sample the multi-qubit state.
   cudaq::ExecutionResult sample(const std::vector<std::size_t> &qubits,
                                 const int shots) override {
+    if constexpr (std::is_same_v<StateType, qpp::ket>) {
+      if (hasStochasticTrajectoryOps())
+        return sampleTrajectories(qubits, shots);
+      flushTrajectoryOps();
+    }
+
     if (shots < 1) {
-      double expectationValue = calculateExpectationValue(qubits);
+      double expectationValue = calculateExpectationValue(state, qubits);
       cudaq::info("Computed expectation value = {}", expectationValue);
       return cudaq::ExecutionResult{{}, expectationValue};
     }
 
-    std::vector<std::size_t> measuredBits;
-    for (auto index : qubits) {
-      measuredBits.push_back(convertQubitIndex(index));
+    // Sample state vectors with the random number stream of this simulator.
+    std::map<std::string, std::size_t> sampleResult;
+    if constexpr (std::is_same_v<StateType, qpp::ket>) {
+      sampleResult = sampleShots(state, qubits, shots, randomEngine);
+    } else {
+      std::vector<std::size_t> measuredBits;
+      for (auto index : qubits) {
+        measuredBits.push_back(convertQubitIndex(index));
+      }
+      std::stringstream bitstream;
+      for (auto [result, count] : qpp::sample(shots, state, measuredBits, 2)) {
+        // Push back each term in the vector of bits to the bitstring.
+        for (const auto &bit : result) {
+          bitstream << bit;
+        }
+        sampleResult[bitstream.str()] += count;
+        // Reset the state.
+        bitstream.str("");
+        bitstream.clear();
+      }
     }
 
-    auto sampleResult = qpp::sample(shots, state, measuredBits, 2);
     // Convert to what we expect
-    std::stringstream bitstream;
     cudaq::ExecutionResult counts;
 
     // Expectation value from the counts
     double expVal = 0.0;
-    for (auto [result, count] : sampleResult) {
-      // Push back each term in the vector of bits to the bitstring.
-      for (const auto &bit : result) {
-        bitstream << bit;
-      }
-
+    for (auto &[bitstring, count] : sampleResult) {
       // Add to the sample result
       // in mid-circ sampling mode this will append 1 bitstring
-      auto bitstring = bitstream.str();
       counts.appendResult(bitstring, count);
       auto par = cudaq::sample_result::has_even_parity(bitstring);
       auto p = count / (double)shots;
@@ -383,9 +1075,6 @@ public:
         p = -p;
       }
       expVal += p;
-      // Reset the state.
-      bitstream.str("");
-      bitstream.clear();
     }
 
     counts.expectationValue = expVal;
@@ -394,9 +1083,33 @@ public:
 
   std::unique_ptr<cudaq::SimulationState> getSimulationState() override {
     flushGateQueue();
+    flushTrajectoryOps();
     return std::make_unique<QppState>(std::move(state));
   }
 
+  bool canSnapshotState() const override {
+    return std::is_same_v<StateType, qpp::ket>;
+  }
+
+  std::unique_ptr<cudaq::SimulationState> snapshotState() override {
+    if constexpr (std::is_same_v<StateType, qpp::ket>)
+      return std::make_unique<QppState>(qpp::ket(state));
+    else
+      return CircuitSimulatorBase<double>::snapshotState();
+  }
+
+  void restoreState(const cudaq::SimulationState &snapshot) override {
+    if constexpr (std::is_same_v<StateType, qpp::ket>) {
+      const auto *casted = dynamic_cast<const QppState *>(&snapshot);
+      if (!casted)
+        throw std::invalid_argument(
+            "[QppCircuitSimulator] Incompatible state snapshot");
+      state = casted->state;
+    } else {
+      CircuitSimulatorBase<double>::restoreState(snapshot);
+    }
+  }
+
   bool isStateVectorSimulator() const override {
     return std::is_same_v<StateType, qpp::ket>;
   }
@@ -404,6 +1117,7 @@ public:
   /// @brief Primarily used for testing.
   auto getStateVector() {
     flushGateQueue();
+    flushTrajectoryOps();
     return state;
   }
   std::string name() const override { return "qpp"; }
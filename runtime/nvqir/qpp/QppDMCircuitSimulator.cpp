@@ -159,17 +159,17 @@ protected:
     }
 
     // Get the Kraus channels specified for this gate and qubits
-    auto krausChannels = executionContext->noiseModel->get_channels(
+    const auto krausChannels = executionContext->noiseModel->lookup_channels(
         gName, targets, controls, params);
 
     // If none, do nothing
-    if (krausChannels.empty())
+    if (krausChannels->empty())
       return;
 
-    cudaq::info("Applying {} kraus channels to qubits {}", krausChannels.size(),
-                qubits);
+    cudaq::info("Applying {} kraus channels to qubits {}",
+                krausChannels->size(), qubits);
 
-    for (auto &channel : krausChannels) {
+    for (auto &channel : *krausChannels) {
       // Map our kraus ops to the qpp::cmat
       std::vector<qpp::cmat> K;
       auto ops = channel.get_ops();
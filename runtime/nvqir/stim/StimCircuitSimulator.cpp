@@ -10,10 +10,16 @@
 #include "nvqir/Gates.h"
 #include "stim.h"
 
+#include <atomic>
 #include <bit>
+#include <cstdlib>
+#include <exception>
 #include <iostream>
+#include <map>
+#include <mutex>
 #include <set>
 #include <span>
+#include <thread>
 
 using namespace cudaq;
 
@@ -40,6 +46,22 @@ protected:
   /// @brief Stim Frame/Flip simulator (used to generate multiple shots)
   std::unique_ptr<stim::FrameSimulator<W>> sampleSim;
 
+  /// @brief Environment variable that sets the maximum number of shots that
+  /// are simulated at once by a frame simulator.
+  static constexpr const char batchSizeEnvVar[] = "CUDAQ_STIM_MAX_BATCH_SIZE";
+
+  /// @brief Default maximum number of shots simulated at once.
+  static constexpr std::size_t defaultMaxBatchSize = 1 << 16;
+
+  /// @brief True if the shots do not fit in a single batch. In that case,
+  /// `sampleSim` only simulates a single shot, and all the operations applied
+  /// to it are recorded into `sampleCircuit`, which is replayed in batches of
+  /// shots when sampling.
+  bool streamSampling = false;
+
+  /// @brief The circuit applied to `sampleSim`, if `streamSampling` is set.
+  stim::Circuit sampleCircuit;
+
   std::optional<std::string>
   isValidStimNoiseChannel(const kraus_channel &channel) const {
 
@@ -75,6 +97,22 @@ protected:
   /// @brief Grow the state vector by one qubit.
   void addQubitToState() override { addQubitsToState(1); }
 
+  /// @brief Get the maximum number of shots simulated at once by a frame
+  /// simulator. This bounds the memory used by the frame simulators.
+  std::size_t getMaxBatchSize() const {
+    const char *envVal = std::getenv(batchSizeEnvVar);
+    if (!envVal)
+      return defaultMaxBatchSize;
+    const std::string batchSizeStr(envVal);
+    char *endptr = nullptr;
+    const long long value = std::strtoll(batchSizeStr.c_str(), &endptr, 10);
+    if (endptr == batchSizeStr.c_str() || *endptr != '\0' || value <= 0)
+      throw std::runtime_error(
+          std::string("Invalid ") + batchSizeEnvVar +
+          " setting. Expected a positive number. Got: " + batchSizeStr);
+    return static_cast<std::size_t>(value);
+  }
+
   /// @brief Get the batch size to use for the Stim sample simulator.
   std::size_t getBatchSize() {
     // Default to single shot
@@ -82,7 +120,10 @@ protected:
     if (getExecutionContext() && getExecutionContext()->name == "sample" &&
         !getExecutionContext()->hasConditionalsOnMeasureResults)
       batch_size = getExecutionContext()->shots;
-    return batch_size;
+    // Shots that do not fit in a single batch are sampled in batches from a
+    // recording of the circuit.
+    streamSampling = batch_size > getMaxBatchSize();
+    return streamSampling ? 1 : batch_size;
   }
 
   /// @brief Override the default sized allocation of qubits
@@ -126,9 +167,19 @@ protected:
     if (sampleSim)
       randomEngine = std::move(sampleSim->rng);
     sampleSim.reset();
+    streamSampling = false;
+    sampleCircuit.clear();
     num_measurements = 0;
   }
 
+  /// @brief Apply \p circuit to the sample simulator, recording it if the
+  /// shots are sampled in batches.
+  void applyToSampleSim(const stim::Circuit &circuit) {
+    sampleSim->safe_do_circuit(circuit);
+    if (streamSampling)
+      sampleCircuit += circuit;
+  }
+
   /// @brief Apply operation to all Stim simulators.
   void applyOpToSims(const std::string &gate_name,
                      const std::vector<uint32_t> &targets) {
@@ -138,7 +189,7 @@ protected:
     cudaq::info("Calling applyOpToSims {} - {}", gate_name, targets);
     tempCircuit.safe_append_u(gate_name, targets);
     tableau->safe_do_circuit(tempCircuit);
-    sampleSim->safe_do_circuit(tempCircuit);
+    applyToSampleSim(tempCircuit);
   }
 
   /// @brief Apply the noise channel on \p qubits
@@ -166,25 +217,25 @@ protected:
       stimTargets.push_back(static_cast<std::uint32_t>(q));
 
     // Get the Kraus channels specified for this gate and qubits
-    auto krausChannels = executionContext->noiseModel->get_channels(
+    const auto krausChannels = executionContext->noiseModel->lookup_channels(
         gName, targets, controls, params);
 
     // If none, do nothing
-    if (krausChannels.empty())
+    if (krausChannels->empty())
       return;
 
-    cudaq::info("Applying {} kraus channels to qubits {}", krausChannels.size(),
-                stimTargets);
+    cudaq::info("Applying {} kraus channels to qubits {}",
+                krausChannels->size(), stimTargets);
 
     stim::Circuit noiseOps;
-    for (auto &channel : krausChannels) {
+    for (auto &channel : *krausChannels) {
       if (auto stimName = isValidStimNoiseChannel(channel))
         noiseOps.safe_append_u(stimName.value(), stimTargets,
                                channel.parameters);
     }
     // Only apply the noise operations to the sample simulator (not the Tableau
     // simulator).
-    sampleSim->safe_do_circuit(noiseOps);
+    applyToSampleSim(noiseOps);
   }
 
   bool isValidNoiseChannel(const cudaq::noise_model_type &type) const override {
@@ -206,7 +257,7 @@ protected:
     // If we have a valid operation, apply it
     if (auto stimName = isValidStimNoiseChannel(channel)) {
       noiseOps.safe_append_u(stimName.value(), stimTargets, channel.parameters);
-      sampleSim->safe_do_circuit(noiseOps);
+      applyToSampleSim(noiseOps);
     }
   }
 
@@ -279,6 +330,112 @@ protected:
 
   QubitOrdering getQubitOrdering() const override { return QubitOrdering::msb; }
 
+  /// @brief Append the first \p nShots shots of a frame simulator measurement
+  /// \p record to \p shots, keeping measurements \p firstBit to \p numBits - 1.
+  /// The frame simulator only tracks flips, so each shot is XOR-ed with the
+  /// reference sample \p ref.
+  void appendShots(const stim::simd_bit_table<W> &record,
+                   const stim::simd_bits<W> &ref, std::size_t nShots,
+                   std::size_t firstBit, std::size_t numBits,
+                   PackedShotData &shots) const {
+    // This is a slightly modified version of `sample_batch_measurements`, where
+    // we already have the `sample` from the frame simulator. It also places the
+    // `sample` in a layout amenable to the order of the loops below (shot
+    // major).
+    stim::simd_bit_table<W> sample = record.transposed();
+    if (ref.not_zero())
+      for (size_t s = 0; s < nShots; s++)
+        sample[s].word_range_ref(0, ref.num_simd_words) ^= ref;
+
+    shots.reserve(nShots, numBits - firstBit);
+    std::string aShot(numBits - firstBit, '0');
+    for (std::size_t shot = 0; shot < nShots; shot++) {
+      for (std::size_t b = firstBit; b < numBits; b++)
+        aShot[b - firstBit] = sample[shot][b] ? '1' : '0';
+      shots.append(aShot);
+    }
+  }
+
+  /// @brief Sample \p shots shots of the recorded `sampleCircuit` in batches of
+  /// at most getMaxBatchSize() shots. Batches are simulated in parallel, and
+  /// each one is folded into the result as soon as it is done (in batch order,
+  /// so the shot order does not depend on the threads) and freed, so the
+  /// memory used besides the result does not grow with the number of shots.
+  ExecutionResult sampleInBatches(const stim::simd_bits<W> &ref,
+                                  std::size_t shots, std::size_t firstBit,
+                                  std::size_t numBits) {
+    const std::size_t maxBatchSize = getMaxBatchSize();
+    const std::size_t numBatches = (shots + maxBatchSize - 1) / maxBatchSize;
+    cudaq::info("Sampling {} shots in {} batches", shots, numBatches);
+
+    // Seed the batches up front, so that the results do not depend on the
+    // number of threads. Draw from the sample simulator RNG, which carries
+    // over to the next execution.
+    std::vector<std::uint64_t> seeds(numBatches);
+    for (auto &seed : seeds)
+      seed = sampleSim->rng();
+
+    const stim::CircuitStats stats = sampleCircuit.compute_stats();
+    ExecutionResult result;
+    result.sequentialData.reserve(shots, numBits - firstBit);
+    // Batches done before all the previous ones, waiting to be folded.
+    std::map<std::size_t, PackedShotData> pendingBatches;
+    std::size_t nextBatchToFold = 0;
+    std::mutex resultMutex;
+    std::atomic<std::size_t> nextBatch = 0;
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    auto worker = [&]() {
+      try {
+        for (std::size_t b = nextBatch++; b < numBatches; b = nextBatch++) {
+          const std::size_t batchSize =
+              std::min(maxBatchSize, shots - b * maxBatchSize);
+          PackedShotData batchShots;
+          {
+            // Free the frame simulator before waiting for the result.
+            stim::FrameSimulator<W> batchSim(
+                stats, stim::FrameSimulatorMode::STORE_MEASUREMENTS_TO_MEMORY,
+                batchSize, std::mt19937_64(seeds[b]));
+            batchSim.reset_all();
+            batchSim.safe_do_circuit(sampleCircuit);
+            appendShots(batchSim.m_record.storage, ref, batchSize, firstBit,
+                        numBits, batchShots);
+          }
+          const auto batchCounts = batchShots.toCounts();
+
+          std::lock_guard<std::mutex> lock(resultMutex);
+          for (auto &[bits, count] : batchCounts)
+            result.counts[bits] += count;
+          pendingBatches.emplace(b, std::move(batchShots));
+          auto iter = pendingBatches.begin();
+          while (iter != pendingBatches.end() &&
+                 iter->first == nextBatchToFold) {
+            result.sequentialData.append(iter->second);
+            iter = pendingBatches.erase(iter);
+            nextBatchToFold++;
+          }
+        }
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if (!error)
+          error = std::current_exception();
+        nextBatch = numBatches;
+      }
+    };
+
+    const std::size_t numThreads = std::min<std::size_t>(
+        numBatches, std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < numThreads; i++)
+      threads.emplace_back(worker);
+    worker();
+    for (auto &thread : threads)
+      thread.join();
+    if (error)
+      std::rethrow_exception(error);
+    return result;
+  }
+
 public:
   StimCircuitSimulator() : randomEngine(std::random_device{}()) {
     // Populate the correct name so it is printed correctly during
@@ -295,6 +452,13 @@ public:
     randomEngine = std::mt19937_64(seed);
   }
 
+  void setInstanceRandomSeed(std::size_t seed) override {
+    randomEngine = std::mt19937_64(seed);
+  }
+
+  /// @brief All random draws come from `randomEngine`, owned by the instance.
+  bool canSimulateShotsConcurrently() const override { return true; }
+
   bool canHandleObserve() override { return false; }
 
   /// @brief Reset the qubit
@@ -322,7 +486,6 @@ public:
         return qubits.empty();
       return true;
     }();
-    assert(shots <= sampleSim->batch_size);
     std::vector<std::uint32_t> stimTargetQubits(qubits.begin(), qubits.end());
     applyOpToSims("M", stimTargetQubits);
     num_measurements += stimTargetQubits.size();
@@ -336,21 +499,7 @@ public:
     for (size_t k = 0; k < v.size(); k++)
       ref[k] ^= v[k];
 
-    // Now XOR results on a per-shot basis
-    stim::simd_bit_table<W> sample = sampleSim->m_record.storage;
-    auto nShots = sampleSim->batch_size;
-
-    // This is a slightly modified version of `sample_batch_measurements`, where
-    // we already have the `sample` from the frame simulator. It also places the
-    // `sample` in a layout amenable to the order of the loops below (shot
-    // major).
-    sample = sample.transposed();
-    if (ref.not_zero())
-      for (size_t s = 0; s < nShots; s++)
-        sample[s].word_range_ref(0, ref.num_simd_words) ^= ref;
-
     size_t bits_per_sample = num_measurements;
-    std::vector<std::string> sequentialData;
     // Only retain the final "qubits.size()" measurements. All other
     // measurements were mid-circuit measurements that have been previously
     // accounted for and saved.
@@ -358,17 +507,15 @@ public:
     std::size_t first_bit_to_save = executionContext->explicitMeasurements
                                         ? 0
                                         : bits_per_sample - qubits.size();
-    CountsDictionary counts;
-    sequentialData.reserve(shots);
-    for (std::size_t shot = 0; shot < shots; shot++) {
-      std::string aShot(bits_per_sample - first_bit_to_save, '0');
-      for (std::size_t b = first_bit_to_save; b < bits_per_sample; b++)
-        aShot[b - first_bit_to_save] = sample[shot][b] ? '1' : '0';
-      counts[aShot]++;
-      sequentialData.push_back(std::move(aShot));
-    }
-    ExecutionResult result(counts);
-    result.sequentialData = std::move(sequentialData);
+    if (streamSampling)
+      return sampleInBatches(ref, shots, first_bit_to_save, bits_per_sample);
+
+    assert(shots <= sampleSim->batch_size);
+    ExecutionResult result;
+    appendShots(sampleSim->m_record.storage, ref, shots, first_bit_to_save,
+                bits_per_sample, result.sequentialData);
+    // Collate the packed shots, only unique outcomes become strings.
+    result.counts = result.sequentialData.toCounts();
     return result;
   }
 
@@ -0,0 +1,370 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+// clang-format off
+// RUN: nvq++ %cpp_std --enable-mlir %s -o %t && %t | FileCheck %s
+// RUN: nvq++ %cpp_std --target ionq       --emulate %s -o %t && %t | FileCheck %s
+// RUN: nvq++ %cpp_std --target quantinuum --emulate %s -o %t && %t | FileCheck %s
+// clang-format on
+
+// Numeric checks of the quantum Shannon decomposition of custom operations on
+// 3 and 4 qubits. Each custom operation is the unitary of a generic circuit.
+// Applying it to a generic input state, then applying the inverse circuit and
+// undoing the input preparation, must give back |0...0> in every shot. The
+// controlled checks also catch a wrong global phase of the decomposition: the
+// control is prepared in |+> and measured in the X basis.
+
+#include <cudaq.h>
+
+// clang-format off
+CUDAQ_REGISTER_OPERATION(
+    random_3q, 3, 0,
+    {std::complex<double>{-0.013879228495, -0.149817571845}, std::complex<double>{0.00216803363721, 0.359232809878},
+     std::complex<double>{-0.126218297426, -0.0472825446713}, std::complex<double>{-0.157623766549, 0.200957794592},
+     std::complex<double>{-0.231515780309, 0.120687755137}, std::complex<double>{-0.498865131214, 0.288603087028},
+     std::complex<double>{-0.451482223215, -0.252747397834}, std::complex<double>{0.293632476363, -0.103210646614},
+     std::complex<double>{0.144952142816, -0.0435214898761}, std::complex<double>{0.184145352035, -0.397377318554},
+     std::complex<double>{0.586993914043, 0.440710564475}, std::complex<double>{0.0245363985191, 0.182331746996},
+     std::complex<double>{0.0151357869059, -0.246026285854}, std::complex<double>{-0.264595507632, 0.120252423505},
+     std::complex<double>{-0.0622484131323, 0.0283526741934}, std::complex<double>{0.205477953219, 0.143222110481},
+     std::complex<double>{0.164969418277, 0.152681157621}, std::complex<double>{0.0905729899972, -0.0700198490649},
+     std::complex<double>{-0.272886884176, -0.0991291348133}, std::complex<double>{0.325624296483, 0.322012504496},
+     std::complex<double>{-0.51090176811, -0.107390485583}, std::complex<double>{-0.356752493451, -0.00363218089145},
+     std::complex<double>{0.294523014639, 0.323982230592}, std::complex<double>{-0.203827153074, 0.0962162633345},
+     std::complex<double>{0.245120572194, -0.438988940381}, std::complex<double>{0.219901457876, -0.104149619401},
+     std::complex<double>{-0.156648366631, -0.185930641379}, std::complex<double>{0.505031293152, 0.0145318156255},
+     std::complex<double>{0.166016802456, 0.0115892360054}, std::complex<double>{0.0475674914285, -0.414437065338},
+     std::complex<double>{-0.286131159717, 0.034997327834}, std::complex<double>{0.29545064761, 0.0389942414703},
+     std::complex<double>{-0.0317183000105, -0.248942431299}, std::complex<double>{-0.371434639337, 0.132244557718},
+     std::complex<double>{-0.0779687630431, 0.321391688816}, std::complex<double>{0.25229060555, -0.0070881078877},
+     std::complex<double>{-0.21436937089, -0.419661701847}, std::complex<double>{0.2595264099, 0.122790158349},
+     std::complex<double>{-0.349161362959, -0.107788324766}, std::complex<double>{-0.372102461323, 0.178893797454},
+     std::complex<double>{-0.248372464238, 0.146060364687}, std::complex<double>{0.247412615192, -0.5210639176},
+     std::complex<double>{-0.21905794307, -0.305662103454}, std::complex<double>{-0.142202994701, -0.139907231285},
+     std::complex<double>{-0.121298915576, -0.0221452248354}, std::complex<double>{0.0424168382171, 0.163675565973},
+     std::complex<double>{-0.320794728321, -0.161247080767}, std::complex<double>{-0.0658189384536, 0.475405850952},
+     std::complex<double>{0.261933848636, -0.0966050505994}, std::complex<double>{-0.255999142382, -0.0951615906382},
+     std::complex<double>{0.176846368949, -0.0713860442555}, std::complex<double>{-0.112273139622, -0.0424600281569},
+     std::complex<double>{0.208055286106, 0.441839499157}, std::complex<double>{-0.324014904521, -0.108130491031},
+     std::complex<double>{-0.288762274061, 0.252655668991}, std::complex<double>{-0.52324469597, 0.143169689944},
+     std::complex<double>{0.557731454886, -0.340775351858}, std::complex<double>{0.209181201671, -0.017257366262},
+     std::complex<double>{-0.103413961621, -0.0423130235321}, std::complex<double>{-0.484026549277, -0.289389819603},
+     std::complex<double>{-0.254772064609, -0.173596378529}, std::complex<double>{0.175499575329, 0.153511913034},
+     std::complex<double>{0.0506133941071, 0.201438719613}, std::complex<double>{0.00147837254275, -0.0754202196067}})
+
+CUDAQ_REGISTER_OPERATION(
+    random_4q, 4, 0,
+    {std::complex<double>{-0.00628341815809, -0.0237576223586}, std::complex<double>{0.175300306589, -0.0482723947236},
+     std::complex<double>{0.0576767677212, -0.172394655447}, std::complex<double>{0.0332157543347, 0.0263767298172},
+     std::complex<double>{0.174507365504, -0.131519561652}, std::complex<double>{-0.0807885285098, -0.0700549785618},
+     std::complex<double>{-0.374492995963, -0.0798709968441}, std::complex<double>{0.240308310445, 0.200022629574},
+     std::complex<double>{-0.368816941618, -0.32739956985}, std::complex<double>{0.108357361661, -0.0689534064401},
+     std::complex<double>{-0.0119386072045, -0.0651472165563}, std::complex<double>{-0.0420713402112, -0.134809863239},
+     std::complex<double>{0.0873436896345, 0.1023473635}, std::complex<double>{0.0440804720703, -0.139813870445},
+     std::complex<double>{-0.265590738729, -0.355994384813}, std::complex<double>{-0.305763136098, -0.116296043314},
+     std::complex<double>{0.277788791802, -0.0845747515577}, std::complex<double>{-0.132212065271, 0.212044948372},
+     std::complex<double>{0.204907907575, 0.0477513617297}, std::complex<double>{-0.148246135899, -0.165239795649},
+     std::complex<double>{0.0689820906822, 0.273215911795}, std::complex<double>{0.0880054319911, -0.0690603276448},
+     std::complex<double>{0.0835475953182, -0.255695231899}, std::complex<double>{-0.0797930716738, -0.0208610782261},
+     std::complex<double>{-0.113650401271, -0.0592100326536}, std::complex<double>{-0.0238964568466, -0.159212264842},
+     std::complex<double>{0.00410812419431, 0.116939430188}, std::complex<double>{0.0899579730436, 0.167845923118},
+     std::complex<double>{-0.0363598244659, -0.205945758945}, std::complex<double>{0.0686050938359, 0.0335480936556},
+     std::complex<double>{-0.24878442594, 0.376738619554}, std::complex<double>{-0.487322623936, -0.0736998614809},
+     std::complex<double>{0.383381642923, -0.0338780517613}, std::complex<double>{-0.255345308807, 0.127218699495},
+     std::complex<double>{0.118883703338, 0.150486787501}, std::complex<double>{-0.11131335544, 0.0791427473936},
+     std::complex<double>{0.0260403255036, 0.100330004039}, std::complex<double>{-0.0234861272228, 0.0122767235099},
+     std::complex<double>{-0.215434335787, 0.150243350849}, std::complex<double>{0.232345470044, 0.141606632678},
+     std::complex<double>{0.0491588655714, 0.0876237008977}, std::complex<double>{0.474970522179, 0.240270148171},
+     std::complex<double>{0.124923491949, 0.155231427144}, std::complex<double>{0.0532962052829, 0.199972269052},
+     std::complex<double>{0.196516451021, -0.129596143947}, std::complex<double>{-0.0876844885324, -0.0434167080215},
+     std::complex<double>{0.0888911624301, -0.176208565329}, std::complex<double>{0.111679516096, 0.261186793982},
+     std::complex<double>{-0.19432369272, -0.333868305009}, std::complex<double>{-0.406616150394, -0.0393884003605},
+     std::complex<double>{0.157412412992, -0.0822001904922}, std::complex<double>{-0.19241570581, -0.242447919913},
+     std::complex<double>{0.00580442781666, 0.0122920399716}, std::complex<double>{0.02292943211, -0.255648385613},
+     std::complex<double>{-0.05857179818, -0.0578721271588}, std::complex<double>{-0.0696536566126, 0.194897910246},
+     std::complex<double>{-0.111331840158, 0.359243766052}, std::complex<double>{-0.0502025446928, -0.0877587046016},
+     std::complex<double>{-0.287254781797, 0.0318283977664}, std::complex<double>{0.0109474993138, -0.19514345352},
+     std::complex<double>{0.0825669660374, 0.0575841942474}, std::complex<double>{-0.0989973690419, 0.287840522332},
+     std::complex<double>{0.0200011850364, -0.227810445428}, std::complex<double>{0.0666880429869, -0.0890265322714},
+     std::complex<double>{-0.164858554815, -0.0372518297689}, std::complex<double>{-0.0937091759733, 0.20616549739},
+     std::complex<double>{-0.0443703866681, 0.118429648758}, std::complex<double>{0.0439410844408, -0.231424905753},
+     std::complex<double>{0.268598106391, 0.238364617191}, std::complex<double>{0.134796867451, -0.218627598611},
+     std::complex<double>{-0.0120318181963, 0.16847600973}, std::complex<double>{0.163976533117, -0.40960955335},
+     std::complex<double>{0.00487552140733, -0.210403231275}, std::complex<double>{-0.0036799242833, 0.348360928438},
+     std::complex<double>{-0.0341691800842, -0.124496379649}, std::complex<double>{-0.323383236688, -0.166125951319},
+     std::complex<double>{-0.222987957588, -0.0485394300678}, std::complex<double>{-0.214800336728, 0.000390792333458},
+     std::complex<double>{0.0489218057968, -0.0583434330131}, std::complex<double>{-0.0948521281355, 0.0549615625749},
+     std::complex<double>{-0.0477336941785, 0.187066639877}, std::complex<double>{0.0474987811933, 0.140838856502},
+     std::complex<double>{-0.0211172385495, 0.114951001533}, std::complex<double>{-0.251334561645, -0.113164961006},
+     std::complex<double>{-0.0600378125594, 0.0985254949465}, std::complex<double>{0.120223202299, 0.138375104453},
+     std::complex<double>{0.0153464274722, 0.15606165491}, std::complex<double>{0.156895221852, 0.215922910973},
+     std::complex<double>{0.108230736324, -0.134959634648}, std::complex<double>{-0.161862970814, -0.165557216808},
+     std::complex<double>{0.204378165974, -0.12178755995}, std::complex<double>{0.195604491685, 0.0620516375118},
+     std::complex<double>{0.00199995512273, 0.462118681012}, std::complex<double>{-0.434360427369, 0.293749008267},
+     std::complex<double>{-0.104489891869, -0.00784255210719}, std::complex<double>{-0.0862288608058, 0.138119403578},
+     std::complex<double>{-0.11150843643, -0.253190611977}, std::complex<double>{0.0541638463644, 0.103983690484},
+     std::complex<double>{-0.0458917720892, 0.300210301486}, std::complex<double>{0.248129476217, 0.0118047306599},
+     std::complex<double>{-0.147687523476, 0.00908062216998}, std::complex<double>{-0.0517476402587, -0.271894361993},
+     std::complex<double>{0.0180190574373, 0.341535179759}, std::complex<double>{-0.148646702207, 0.149107394913},
+     std::complex<double>{-0.20546735119, -0.0849897426589}, std::complex<double>{-0.201147139612, -0.0708442426239},
+     std::complex<double>{0.385382291972, 0.142415882527}, std::complex<double>{-0.150872087916, 0.204414483767},
+     std::complex<double>{0.208657901082, -0.0196741128214}, std::complex<double>{0.158009931891, 0.139446703791},
+     std::complex<double>{0.213596913752, -0.0668816755621}, std::complex<double>{-0.158347828825, -0.0647978358909},
+     std::complex<double>{-0.0582093814566, -0.0186487858455}, std::complex<double>{0.243617448855, 0.185503165822},
+     std::complex<double>{0.218569909211, 0.351158753434}, std::complex<double>{0.111633284211, -0.245449986984},
+     std::complex<double>{-0.125516253959, -0.209818758569}, std::complex<double>{0.194981444618, 0.230057833185},
+     std::complex<double>{-0.215841865445, -0.197834960488}, std::complex<double>{0.00902911529349, -0.117993574759},
+     std::complex<double>{0.261734911019, 0.115605388407}, std::complex<double>{0.0275181571867, -0.24134311658},
+     std::complex<double>{-0.188459422604, -0.0833081533364}, std::complex<double>{-0.225251071849, -0.0734874228937},
+     std::complex<double>{0.22682450726, -0.0635198760432}, std::complex<double>{0.0823254970882, 0.000961527383866},
+     std::complex<double>{0.0991229016985, -0.127962294049}, std::complex<double>{-0.15231995953, 0.239006821463},
+     std::complex<double>{-0.337615609399, -0.0382498259233}, std::complex<double>{-0.0301276800165, -0.0997197489399},
+     std::complex<double>{-0.134509499913, 0.160787525394}, std::complex<double>{-0.0748427953898, 0.194291920594},
+     std::complex<double>{-0.195827414749, 0.168482078364}, std::complex<double>{-0.0480982343493, -0.182487744173},
+     std::complex<double>{-0.334768001324, -0.387628117866}, std::complex<double>{0.00854324866782, 0.00827428443074},
+     std::complex<double>{-0.0364591333019, -0.0459403063756}, std::complex<double>{0.196405103727, -0.0427575937796},
+     std::complex<double>{0.15091082596, -0.366705340145}, std::complex<double>{-0.129795099338, 0.217699846319},
+     std::complex<double>{0.039557343097, -0.143501517475}, std::complex<double>{-0.123989632173, 0.115428643604},
+     std::complex<double>{-0.117469682706, 0.230397759891}, std::complex<double>{0.1952379018, -0.0200921994513},
+     std::complex<double>{-0.114433754829, 0.100767814694}, std::complex<double>{-0.112030065679, -0.0368114147187},
+     std::complex<double>{0.467995024324, 0.103184506693}, std::complex<double>{0.198766608696, 0.241318039397},
+     std::complex<double>{0.0747649059611, 0.16924079652}, std::complex<double>{-0.0621461738973, -0.00780277714647},
+     std::complex<double>{-0.118358410238, -0.158081363792}, std::complex<double>{-0.131010759332, -0.336771053515},
+     std::complex<double>{-0.0527283760479, 0.180631715396}, std::complex<double>{-0.11890342417, 0.0222603389944},
+     std::complex<double>{0.281776426498, 0.250350746551}, std::complex<double>{0.0761066331389, -0.146063751115},
+     std::complex<double>{0.130882007189, 0.33004872208}, std::complex<double>{-0.110057293257, -0.176071693533},
+     std::complex<double>{-0.173704259845, -0.0413672478018}, std::complex<double>{0.0858672536126, -0.00530029351326},
+     std::complex<double>{0.062529781321, -0.076405284327}, std::complex<double>{0.289013449046, -0.0386179197474},
+     std::complex<double>{0.042366893991, 0.0522630999796}, std::complex<double>{0.250984774932, -0.0308868067795},
+     std::complex<double>{0.29048669651, 0.0466841873112}, std::complex<double>{0.217373990874, -0.330344501269},
+     std::complex<double>{0.0781000649564, -0.00214889033127}, std::complex<double>{0.277793419475, 0.299292423084},
+     std::complex<double>{0.185279202067, 0.289241543355}, std::complex<double>{0.0208622304301, 0.0171976686603},
+     std::complex<double>{-0.146478429981, 0.0321573092972}, std::complex<double>{-0.152830377485, 0.236827987995},
+     std::complex<double>{-0.00449767054212, 0.256681459181}, std::complex<double>{-0.0141842905268, -0.160740908207},
+     std::complex<double>{-0.154343827818, 0.215258899791}, std::complex<double>{0.139836282777, -0.136588550532},
+     std::complex<double>{0.0583330448405, 0.0737447568893}, std::complex<double>{0.0154290822194, -0.0623617333574},
+     std::complex<double>{-0.192482185634, 0.263176079833}, std::complex<double>{-0.249444796003, -0.221031403882},
+     std::complex<double>{0.267988783201, 0.232326466313}, std::complex<double>{-0.276212993285, -0.0848069087104},
+     std::complex<double>{0.0336069087018, 0.0868003764913}, std::complex<double>{-0.14379155814, 0.124799415074},
+     std::complex<double>{0.0166616925253, -0.116510218894}, std::complex<double>{-0.0091219874557, -0.317754524661},
+     std::complex<double>{0.0279360919388, 0.0166876111013}, std::complex<double>{-0.0796369900021, -0.341490945758},
+     std::complex<double>{0.26187879232, -0.0416775354231}, std::complex<double>{0.0455977536015, -0.338071835873},
+     std::complex<double>{-0.0469702437568, 0.112648074695}, std::complex<double>{0.258795937701, 0.0892663209932},
+     std::complex<double>{-0.141420886028, 0.000526319079217}, std::complex<double>{0.209911696012, 0.41059426021},
+     std::complex<double>{-0.130536022673, 0.0580900507556}, std::complex<double>{-0.155364497247, 0.041460311957},
+     std::complex<double>{-0.118203460652, -0.0875919455355}, std::complex<double>{0.169570443672, -0.0956380924499},
+     std::complex<double>{-0.0505173387656, 0.058760948241}, std::complex<double>{-0.139314194823, -0.0753458413861},
+     std::complex<double>{-0.164480919689, 0.0796654563447}, std::complex<double>{-0.0586817157994, 0.224762744156},
+     std::complex<double>{-0.211366500831, 0.00192954063365}, std::complex<double>{0.396132972087, 0.0479491493447},
+     std::complex<double>{0.307808633931, -0.112469607332}, std::complex<double>{-0.253446782498, -0.32799378816},
+     std::complex<double>{0.00552275842617, 0.00567043752885}, std::complex<double>{0.0407078731039, -0.241349752847},
+     std::complex<double>{0.276524969185, -0.238293501468}, std::complex<double>{0.256808495413, 0.230604939305},
+     std::complex<double>{0.068693418476, -0.0523278250759}, std::complex<double>{0.102099137217, -0.214076983659},
+     std::complex<double>{-0.351772415849, 0.17700259315}, std::complex<double>{-0.510677881452, 0.118310719984},
+     std::complex<double>{-0.115060043731, -0.0844318692216}, std::complex<double>{0.0833674712715, -0.0149190071712},
+     std::complex<double>{-0.0957453067083, -0.0374409370495}, std::complex<double>{-0.121962794204, 0.184123852031},
+     std::complex<double>{-0.146792422834, 0.0493997164136}, std::complex<double>{-0.117246921135, -0.0461133178559},
+     std::complex<double>{-0.0896105277266, 0.165626064679}, std::complex<double>{-0.0701275327109, 0.109580853867},
+     std::complex<double>{-0.0464692560866, 0.0973236438102}, std::complex<double>{0.238272124717, -0.0806690576591},
+     std::complex<double>{-0.270773739728, -0.177206702449}, std::complex<double>{-0.129822623012, 0.0261454437812},
+     std::complex<double>{0.0994359777786, -0.112457019447}, std::complex<double>{0.268785714397, 0.268621977253},
+     std::complex<double>{-0.0230272554758, 0.173271201182}, std::complex<double>{-0.115181817634, 0.122633088967},
+     std::complex<double>{0.273236726789, 0.0333386744746}, std::complex<double>{-0.0705330934559, 0.18319663534},
+     std::complex<double>{0.0569404567285, -0.338298650892}, std::complex<double>{0.0991599831082, -0.0259004184901},
+     std::complex<double>{-0.412375772402, 0.0698578444188}, std::complex<double>{-0.0657611623804, 0.0696914421679},
+     std::complex<double>{0.233976658917, 0.0345264745051}, std::complex<double>{-0.214616544345, -0.0830960151258},
+     std::complex<double>{-0.00869789578442, 0.0953337844739}, std::complex<double>{-0.110202552307, 0.308417666724},
+     std::complex<double>{-0.0455533673652, -0.23296425333}, std::complex<double>{-0.0477132554833, -0.0991938845204},
+     std::complex<double>{-0.0988900695026, 0.341709912176}, std::complex<double>{0.148187069315, -0.0631695002756},
+     std::complex<double>{0.264252819808, -0.218049006538}, std::complex<double>{-0.0435633430365, 0.14160579102},
+     std::complex<double>{-0.174451694353, 0.0276827495706}, std::complex<double>{-0.200356492345, 0.0983576821808},
+     std::complex<double>{0.176326986524, -0.140878357112}, std::complex<double>{-0.147687647014, 0.304471653112},
+     std::complex<double>{-0.0418932587501, 0.0770453106169}, std::complex<double>{0.299526979913, 0.00529899976231},
+     std::complex<double>{-0.107810609718, -0.112720210349}, std::complex<double>{0.0742417603014, 0.191633032809},
+     std::complex<double>{-0.45778678833, 0.018274367541}, std::complex<double>{0.0946316405731, 0.101933077568}})
+// clang-format on
+
+// The inverse of the circuit whose unitary is `random_3q`.
+struct random_3q_inverse {
+  void operator()(cudaq::qview<> q) __qpu__ {
+    ry(-1.6022, q[2]);
+    ry(0.083, q[1]);
+    ry(-2.1987, q[0]);
+    x<cudaq::ctrl>(q[1], q[2]);
+    x<cudaq::ctrl>(q[0], q[1]);
+    rz(1.5286, q[2]);
+    ry(-1.8458, q[2]);
+    rz(-2.8232, q[2]);
+    rz(-1.5378, q[1]);
+    ry(-2.0506, q[1]);
+    rz(-1.9229, q[1]);
+    rz(-1.9462, q[0]);
+    ry(-2.3329, q[0]);
+    rz(2.2198, q[0]);
+    x<cudaq::ctrl>(q[2], q[1]);
+    x<cudaq::ctrl>(q[1], q[0]);
+    rz(1.4085, q[2]);
+    ry(3.0509, q[2]);
+    rz(-0.6811, q[2]);
+    rz(-2.1216, q[1]);
+    ry(0.4299, q[1]);
+    rz(1.2902, q[1]);
+    rz(1.7976, q[0]);
+    ry(-0.1968, q[0]);
+    rz(2.3234, q[0]);
+    x<cudaq::ctrl>(q[1], q[2]);
+    x<cudaq::ctrl>(q[0], q[1]);
+    rz(-1.4704, q[2]);
+    ry(1.7269, q[2]);
+    rz(2.217, q[2]);
+    rz(1.693, q[1]);
+    ry(1.9747, q[1]);
+    rz(-2.1949, q[1]);
+    rz(-1.1566, q[0]);
+    ry(-1.164, q[0]);
+    rz(1.5142, q[0]);
+  }
+};
+
+// The inverse of the circuit whose unitary is `random_4q`.
+struct random_4q_inverse {
+  void operator()(cudaq::qview<> q) __qpu__ {
+    ry(0.803, q[3]);
+    ry(3.0295, q[2]);
+    ry(-2.6388, q[1]);
+    ry(-1.969, q[0]);
+    x<cudaq::ctrl>(q[2], q[3]);
+    x<cudaq::ctrl>(q[1], q[2]);
+    x<cudaq::ctrl>(q[0], q[1]);
+    rz(-1.9616, q[3]);
+    ry(2.2518, q[3]);
+    rz(-3.1185, q[3]);
+    rz(0.1627, q[2]);
+    ry(-2.7632, q[2]);
+    rz(2.6272, q[2]);
+    rz(1.1988, q[1]);
+    ry(-0.8719, q[1]);
+    rz(-2.403, q[1]);
+    rz(-0.2511, q[0]);
+    ry(1.8221, q[0]);
+    rz(-2.86, q[0]);
+    x<cudaq::ctrl>(q[3], q[2]);
+    x<cudaq::ctrl>(q[2], q[1]);
+    x<cudaq::ctrl>(q[1], q[0]);
+    rz(-0.37, q[3]);
+    ry(-1.2916, q[3]);
+    rz(2.1934, q[3]);
+    rz(-2.3582, q[2]);
+    ry(-1.9642, q[2]);
+    rz(2.7508, q[2]);
+    rz(-3.1318, q[1]);
+    ry(0.6183, q[1]);
+    rz(-2.7972, q[1]);
+    rz(-2.176, q[0]);
+    ry(1.1471, q[0]);
+    rz(-0.0101, q[0]);
+    x<cudaq::ctrl>(q[2], q[3]);
+    x<cudaq::ctrl>(q[1], q[2]);
+    x<cudaq::ctrl>(q[0], q[1]);
+    rz(1.5558, q[3]);
+    ry(-1.5481, q[3]);
+    rz(0.7278, q[3]);
+    rz(2.9723, q[2]);
+    ry(2.4494, q[2]);
+    rz(-1.014, q[2]);
+    rz(-1.2832, q[1]);
+    ry(-1.672, q[1]);
+    rz(1.3218, q[1]);
+    rz(-2.8934, q[0]);
+    ry(-1.927, q[0]);
+    rz(-0.1381, q[0]);
+  }
+};
+
+// Prepares a generic, entangled input state from |0...0>.
+struct prepare_input {
+  void operator()(cudaq::qview<> q) __qpu__ {
+    for (std::size_t i = 0; i < q.size(); i++) {
+      ry(0.4 + 0.3 * i, q[i]);
+      rz(1.3 - 0.5 * i, q[i]);
+    }
+    for (std::size_t i = 0; i + 1 < q.size(); i++)
+      x<cudaq::ctrl>(q[i], q[i + 1]);
+  }
+};
+
+struct check_3q {
+  void operator()() __qpu__ {
+    cudaq::qvector q(3);
+    prepare_input{}(q);
+    random_3q(q[0], q[1], q[2]);
+    random_3q_inverse{}(q);
+    cudaq::adjoint(prepare_input{}, q);
+    mz(q);
+  }
+};
+
+struct check_ctrl_3q {
+  void operator()() __qpu__ {
+    cudaq::qubit c;
+    cudaq::qvector q(3);
+    h(c);
+    prepare_input{}(q);
+    random_3q<cudaq::ctrl>(c, q[0], q[1], q[2]);
+    cudaq::control(random_3q_inverse{}, c, q);
+    cudaq::adjoint(prepare_input{}, q);
+    h(c);
+    mz(c);
+    mz(q);
+  }
+};
+
+struct check_4q {
+  void operator()() __qpu__ {
+    cudaq::qvector q(4);
+    prepare_input{}(q);
+    random_4q(q[0], q[1], q[2], q[3]);
+    random_4q_inverse{}(q);
+    cudaq::adjoint(prepare_input{}, q);
+    mz(q);
+  }
+};
+
+struct check_ctrl_4q {
+  void operator()() __qpu__ {
+    cudaq::qubit c;
+    cudaq::qvector q(4);
+    h(c);
+    prepare_input{}(q);
+    random_4q<cudaq::ctrl>(c, q[0], q[1], q[2], q[3]);
+    cudaq::control(random_4q_inverse{}, c, q);
+    cudaq::adjoint(prepare_input{}, q);
+    h(c);
+    mz(c);
+    mz(q);
+  }
+};
+
+template <typename Kernel>
+void check(const char *name, Kernel &&kernel) {
+  auto counts = cudaq::sample(kernel);
+  printf("%s: %s (%zu outcomes)\n", name, counts.most_probable().c_str(),
+         counts.size());
+}
+
+int main() {
+  check("3 qubits", check_3q{});
+  check("controlled 3 qubits", check_ctrl_3q{});
+  check("4 qubits", check_4q{});
+  check("controlled 4 qubits", check_ctrl_4q{});
+}
+
+// CHECK: 3 qubits: 000 (1 outcomes)
+// CHECK: controlled 3 qubits: 0000 (1 outcomes)
+// CHECK: 4 qubits: 0000 (1 outcomes)
+// CHECK: controlled 4 qubits: 00000 (1 outcomes)
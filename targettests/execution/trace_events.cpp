@@ -0,0 +1,35 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+// clang-format off
+// RUN: nvq++ %cpp_std --target qpp-cpu %s -o %t && rm -f %t.json && CUDAQ_TRACE_EVENTS_FILE=%t.json %t && FileCheck %s < %t.json
+// clang-format on
+
+#include <cudaq.h>
+#include <iostream>
+
+struct ghz {
+  void operator()(int n) __qpu__ {
+    cudaq::qvector q(n);
+    h(q[0]);
+    for (int i = 0; i < n - 1; i++)
+      x<cudaq::ctrl>(q[i], q[i + 1]);
+    mz(q);
+  }
+};
+
+int main() {
+  auto counts = cudaq::sample(ghz{}, 3);
+  std::cout << counts.size() << '\n';
+  return 0;
+}
+
+// CHECK: {"displayTimeUnit":"ms","traceEvents":[
+// CHECK-DAG: {"name":"thread_name","ph":"M",{{.*}}"args":{"name":"thread 0"}}
+// CHECK-DAG: "cat":"cudaq","ph":"X","ts":{{[0-9.]+}},"dur":{{[0-9.]+}},"pid":{{[0-9]+}},"tid":0,
+// CHECK: ]}
@@ -1236,3 +1236,92 @@ CUDAQ_TEST(QPPTester, checkReset) {
     EXPECT_EQ(1, qppBackend.mz(q1));
   }
 }
+
+CUDAQ_TEST(QPPTester, checkObserve) {
+  using cudaq::spin_op;
+
+  // Testing `::observe()` on a product state.
+  {
+    const double theta = 0.37;
+    QppCircuitSimulator<qpp::ket> qppBackend;
+    auto q0 = qppBackend.allocateQubit();
+    auto q1 = qppBackend.allocateQubit();
+    auto q2 = qppBackend.allocateQubit();
+
+    // |+> (x) |1> (x) rx(theta)|0>
+    qppBackend.h(q0);
+    qppBackend.x(q1);
+    qppBackend.rx(theta, q2);
+
+    auto h = 2.0 * spin_op::x(0) + 3.0 * spin_op::z(1) +
+             0.5 * spin_op::z(2) - 1.5 * spin_op::y(2) +
+             0.7 * spin_op::x(0) * spin_op::z(1) * spin_op::y(2) +
+             1.2 * spin_op::identity();
+    h = spin_op::canonicalize(h);
+    const double want = 2.0 - 3.0 + 0.5 * std::cos(theta) +
+                        1.5 * std::sin(theta) + 0.7 * std::sin(theta) + 1.2;
+    EXPECT_NEAR(want, qppBackend.observe(h).expectation(), 1e-9);
+  }
+
+  // Testing `::observe()` on an entangled state.
+  {
+    QppCircuitSimulator<qpp::ket> qppBackend;
+    auto q0 = qppBackend.allocateQubit();
+    auto q1 = qppBackend.allocateQubit();
+
+    // (|00> + |11>) / sqrt(2)
+    qppBackend.h(q0);
+    qppBackend.x({q0}, q1);
+
+    auto h = spin_op::x(0) * spin_op::x(1) +
+             2.0 * spin_op::y(0) * spin_op::y(1) +
+             4.0 * spin_op::z(0) * spin_op::z(1) + 8.0 * spin_op::x(0) +
+             16.0 * spin_op::z(1);
+    EXPECT_NEAR(1.0 - 2.0 + 4.0, qppBackend.observe(h).expectation(), 1e-9);
+  }
+}
+
+// A state vector simulator that always fuses gates on up to `maxQubits`
+// qubits, regardless of the environment.
+class FusingQppCircuitSimulator : public QppCircuitSimulator<qpp::ket> {
+  std::size_t maxQubits;
+
+public:
+  FusingQppCircuitSimulator(std::size_t maxQubits) : maxQubits(maxQubits) {}
+
+protected:
+  std::size_t getGateFusionMaxQubits() const override { return maxQubits; }
+};
+
+// Checks that fusing queued gates does not change the final state.
+CUDAQ_TEST(QPPTester, checkGateFusion) {
+  // CNOT with `targets[0]` as the control, in MSB matrix ordering.
+  const std::vector<std::complex<double>> cnot{1, 0, 0, 0, 0, 1, 0, 0,
+                                               0, 0, 0, 1, 0, 0, 1, 0};
+  auto runCircuit = [&](QppCircuitSimulator<qpp::ket> &qppBackend) {
+    auto q0 = qppBackend.allocateQubit();
+    auto q1 = qppBackend.allocateQubit();
+    auto q2 = qppBackend.allocateQubit();
+    auto q3 = qppBackend.allocateQubit();
+    qppBackend.h(q0);
+    qppBackend.rx(0.3, q1);
+    qppBackend.x({q0}, q1);
+    qppBackend.ry(0.7, q2);
+    qppBackend.h(q3);
+    qppBackend.t(q1);
+    qppBackend.x({q1, q2}, q3);
+    qppBackend.applyCustomOperation(cnot, {}, {q3, q0}, "cnot");
+    qppBackend.rz(0.5, q0);
+    qppBackend.swap(q1, q2);
+    qppBackend.u3(0.1, 0.2, 0.3, {q2}, q3);
+    qppBackend.ry(1.1, {q0, q1, q3}, q2);
+    return qppBackend.getStateVector();
+  };
+
+  QppCircuitSimulator<qpp::ket> qppBackend;
+  const qpp::ket want_state = runCircuit(qppBackend);
+  for (std::size_t maxQubits = 1; maxQubits <= 4; ++maxQubits) {
+    FusingQppCircuitSimulator fusingBackend(maxQubits);
+    EXPECT_EQ_KETS(want_state, runCircuit(fusingBackend));
+  }
+}
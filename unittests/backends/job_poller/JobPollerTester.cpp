@@ -0,0 +1,160 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "common/JobPoller.h"
+#include "common/ServerHelper.h"
+#include <gtest/gtest.h>
+
+using namespace cudaq;
+using namespace std::chrono_literals;
+
+namespace {
+/// Server helper of a fake server, whose job responses carry a status that is
+/// "running", "done" or "failed".
+class FakeServerHelper : public ServerHelper {
+public:
+  const std::string name() const override { return "fake"; }
+  void initialize(BackendConfig config) override { backendConfig = config; }
+  RestHeaders getHeaders() override { return {}; }
+  ServerJobPayload createJob(std::vector<KernelExecution> &) override {
+    return {};
+  }
+  std::string extractJobId(ServerMessage &postResponse) override {
+    return postResponse.at("job");
+  }
+  std::string constructGetJobPath(std::string &jobId) override {
+    return jobId;
+  }
+  std::string constructGetJobPath(ServerMessage &postResponse) override {
+    return postResponse.at("job");
+  }
+  std::chrono::microseconds
+  nextResultPollingInterval(ServerMessage &) override {
+    return 1ms;
+  }
+  bool jobIsDone(ServerMessage &response) override {
+    if (response.at("status") == "failed")
+      throw std::runtime_error("Job " +
+                               response.at("job").get<std::string>() +
+                               " failed.");
+    return response.at("status") == "done";
+  }
+  sample_result processResults(ServerMessage &, std::string &) override {
+    return {};
+  }
+};
+
+/// Fake server: a job reports "running" for a given number of polls, then its
+/// final status. The time of every poll is recorded.
+struct FakeServer {
+  struct Job {
+    std::size_t runningPolls = 0;
+    std::string finalStatus = "done";
+    std::vector<std::chrono::steady_clock::time_point> polls;
+  };
+  std::mutex mutex;
+  std::map<std::string, Job> jobs;
+
+  JobPoller::StatusQuery statusQuery() {
+    return [this](const std::string &path,
+                  std::map<std::string, std::string> &) {
+      std::scoped_lock lock(mutex);
+      auto iter = jobs.find(path);
+      if (iter == jobs.end())
+        throw std::runtime_error("Unknown job " + path + ".");
+      auto &job = iter->second;
+      job.polls.push_back(std::chrono::steady_clock::now());
+      const bool running = job.polls.size() <= job.runningPolls;
+      return nlohmann::json{{"job", path},
+                            {"status", running ? "running" : job.finalStatus}};
+    };
+  }
+
+  std::size_t numPolls(const std::string &jobId) {
+    std::scoped_lock lock(mutex);
+    return jobs.at(jobId).polls.size();
+  }
+};
+
+std::unique_ptr<JobPoller> makePoller(FakeServer &server) {
+  return std::make_unique<JobPoller>(std::make_unique<FakeServerHelper>(),
+                                     server.statusQuery());
+}
+} // namespace
+
+TEST(JobPollerTester, checkSuccessWithBackoff) {
+  setenv("CUDAQ_JOB_POLL_MAX_INTERVAL_MS", "8", /*overwrite=*/1);
+  FakeServer server;
+  server.jobs["a"].runningPolls = 5;
+  server.jobs["b"].runningPolls = 0;
+  auto poller = makePoller(server);
+  unsetenv("CUDAQ_JOB_POLL_MAX_INTERVAL_MS");
+
+  auto a = poller->watch("a");
+  auto b = poller->watch("b");
+  EXPECT_EQ("done", b.get().at("status"));
+  auto response = a.get();
+  EXPECT_EQ("a", response.at("job"));
+  EXPECT_EQ("done", response.at("status"));
+  EXPECT_EQ(0, poller->numPending());
+  EXPECT_EQ(1, server.numPolls("b"));
+
+  // The interval starts at the 1 ms requested by the server helper, and
+  // doubles up to the 8 ms maximum.
+  const auto &polls = server.jobs["a"].polls;
+  ASSERT_EQ(6, polls.size());
+  const std::vector<std::chrono::milliseconds> minIntervals{1ms, 2ms, 4ms, 8ms,
+                                                            8ms};
+  for (std::size_t i = 0; i < minIntervals.size(); ++i)
+    EXPECT_GE(polls[i + 1] - polls[i], minIntervals[i]);
+}
+
+TEST(JobPollerTester, checkErrorsAreDelivered) {
+  FakeServer server;
+  server.jobs["failed"].runningPolls = 1;
+  server.jobs["failed"].finalStatus = "failed";
+  server.jobs["running"].runningPolls = 2;
+  auto poller = makePoller(server);
+
+  // A job the server helper reports as failed.
+  auto failed = poller->watch("failed");
+  EXPECT_THROW(failed.get(), std::runtime_error);
+  EXPECT_EQ(2, server.numPolls("failed"));
+
+  // A status query that throws, delivered through the callback.
+  std::promise<std::string> unknownError;
+  poller->watch("unknown", [&](nlohmann::json &&, std::exception_ptr error) {
+    try {
+      std::rethrow_exception(error);
+    } catch (std::exception &e) {
+      unknownError.set_value(e.what());
+    }
+  });
+  EXPECT_EQ("Unknown job unknown.", unknownError.get_future().get());
+
+  // The failures do not affect the other jobs.
+  EXPECT_EQ("done", poller->watch("running").get().at("status"));
+}
+
+TEST(JobPollerTester, checkStopFailsPendingJobs) {
+  FakeServer server;
+  server.jobs["forever"].runningPolls = std::numeric_limits<std::size_t>::max();
+  auto poller = makePoller(server);
+  auto forever = poller->watch("forever");
+  while (server.numPolls("forever") == 0)
+    std::this_thread::sleep_for(1ms);
+  EXPECT_EQ(1, poller->numPending());
+
+  // Destroying the poller joins its thread and fails the jobs it still
+  // tracks, instead of leaving the futures unresolved.
+  poller.reset();
+  EXPECT_THROW(forever.get(), std::runtime_error);
+
+  // Stopping the pollers of a server without any is a no-op.
+  JobPoller::shutdown("fake");
+}
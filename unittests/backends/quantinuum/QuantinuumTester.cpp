@@ -7,6 +7,7 @@
  ******************************************************************************/
 
 #include "CUDAQTestUtils.h"
+#include "common/CompiledJobCache.h"
 #include "common/FmtCore.h"
 #include "cudaq/algorithm.h"
 #include <fstream>
@@ -194,6 +195,91 @@ CUDAQ_TEST(QuantinuumTester, checkObserveSyncEmulate) {
   EXPECT_TRUE(isValidExpVal(result.expectation()));
 }
 
+CUDAQ_TEST(QuantinuumTester, checkObserveTermsLoweredConcurrentlyEmulate) {
+  std::string home = std::getenv("HOME");
+  std::string fileName = home + "/FakeCppQuantinuum.config";
+  auto backendString =
+      fmt::format(fmt::runtime(backendStringTemplate), mockPort, fileName);
+  backendString =
+      std::regex_replace(backendString, std::regex("false"), "true");
+
+  auto [kernel, theta] = cudaq::make_kernel<double>();
+  auto qubit = kernel.qalloc(3);
+  kernel.x(qubit[0]);
+  kernel.ry(theta, qubit[1]);
+  kernel.x<cudaq::ctrl>(qubit[1], qubit[0]);
+  kernel.h(qubit[2]);
+
+  cudaq::spin_op h =
+      5.907 - 2.1433 * cudaq::spin_op::x(0) * cudaq::spin_op::x(1) -
+      2.1433 * cudaq::spin_op::y(0) * cudaq::spin_op::y(1) +
+      .21829 * cudaq::spin_op::z(0) - 6.125 * cudaq::spin_op::z(1) +
+      .5 * cudaq::spin_op::x(2) +
+      .25 * cudaq::spin_op::z(1) * cudaq::spin_op::y(2);
+
+  auto &platform = cudaq::get_platform();
+  auto observeWith = [&](bool serial) {
+    // Printing the IR lowers the terms sequentially, and bypasses the
+    // compiled job cache.
+    if (serial)
+      setenv("CUDAQ_DUMP_JIT_IR", "1", /*overwrite=*/1);
+    platform.setTargetBackend(backendString);
+    unsetenv("CUDAQ_DUMP_JIT_IR");
+    cudaq::set_random_seed(13);
+    return cudaq::observe(1000, kernel, h, .59);
+  };
+  auto concurrent = observeWith(/*serial=*/false);
+  auto serial = observeWith(/*serial=*/true);
+
+  // The terms lowered concurrently produce the same circuits, so the same
+  // seed yields the same results.
+  EXPECT_EQ(concurrent.expectation(), serial.expectation());
+  for (const auto &term : h) {
+    if (term.is_identity())
+      continue;
+    EXPECT_EQ(concurrent.counts(term).to_map(), serial.counts(term).to_map());
+  }
+}
+
+CUDAQ_TEST(QuantinuumTester, checkResubmittedKernelReusesCompiledJob) {
+  std::string home = std::getenv("HOME");
+  std::string fileName = home + "/FakeCppQuantinuum.config";
+  auto backendString =
+      fmt::format(fmt::runtime(backendStringTemplate), mockPort, fileName);
+
+  auto &platform = cudaq::get_platform();
+  platform.setTargetBackend(backendString);
+
+  auto [kernel, theta] = cudaq::make_kernel<double>();
+  auto qubit = kernel.qalloc(2);
+  kernel.ry(theta, qubit[0]);
+  kernel.x<cudaq::ctrl>(qubit[0], qubit[1]);
+  kernel.mz(qubit);
+
+  // The first submission lowers the kernel and caches the compiled job.
+  const auto initial = cudaq::getCompiledJobCacheStatistics();
+  auto counts = cudaq::sample(kernel, M_PI_2);
+  EXPECT_EQ(counts.size(), 2);
+  auto statistics = cudaq::getCompiledJobCacheStatistics();
+  EXPECT_EQ(statistics.hits, initial.hits);
+  EXPECT_EQ(statistics.misses, initial.misses + 1);
+
+  // Resubmitting the same kernel with the same arguments finds the compiled
+  // job, and returns it before running the lowering pipeline.
+  counts = cudaq::sample(kernel, M_PI_2);
+  EXPECT_EQ(counts.size(), 2);
+  statistics = cudaq::getCompiledJobCacheStatistics();
+  EXPECT_EQ(statistics.hits, initial.hits + 1);
+  EXPECT_EQ(statistics.misses, initial.misses + 1);
+
+  // The arguments are synthesized into the kernel, so new arguments require
+  // lowering it again.
+  counts = cudaq::sample(kernel, M_PI);
+  statistics = cudaq::getCompiledJobCacheStatistics();
+  EXPECT_EQ(statistics.hits, initial.hits + 1);
+  EXPECT_EQ(statistics.misses, initial.misses + 2);
+}
+
 CUDAQ_TEST(QuantinuumTester, checkObserveAsync) {
   std::string home = std::getenv("HOME");
   std::string fileName = home + "/FakeCppQuantinuum.config";
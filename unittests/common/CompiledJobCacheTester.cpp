@@ -0,0 +1,59 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "CUDAQTestUtils.h"
+#include "common/CompiledJobCache.h"
+
+using namespace cudaq;
+
+CUDAQ_TEST(CompiledJobCacheTester, checkHitsAndMisses) {
+  CompiledJobCache<std::string> cache(4);
+  EXPECT_TRUE(cache.enabled());
+  EXPECT_FALSE(cache.get("a").has_value());
+  cache.put("a", "qir-a");
+  cache.put("b", "qir-b");
+  auto entry = cache.get("a");
+  ASSERT_TRUE(entry.has_value());
+  EXPECT_EQ("qir-a", *entry);
+  cache.put("a", "qir-a2");
+  EXPECT_EQ("qir-a2", *cache.get("a"));
+  EXPECT_EQ(2, cache.size());
+  EXPECT_EQ(2, cache.hits());
+  EXPECT_EQ(1, cache.misses());
+  const auto statistics = cache.statistics();
+  EXPECT_EQ(2, statistics.hits);
+  EXPECT_EQ(1, statistics.misses);
+
+  cache.clear();
+  EXPECT_EQ(0, cache.size());
+  EXPECT_EQ(0, cache.hits());
+  EXPECT_EQ(0, cache.misses());
+}
+
+CUDAQ_TEST(CompiledJobCacheTester, checkLeastRecentlyUsedEviction) {
+  CompiledJobCache<int> cache(2);
+  cache.put("a", 1);
+  cache.put("b", 2);
+  // Using `a` makes `b` the least recently used entry.
+  EXPECT_TRUE(cache.get("a").has_value());
+  cache.put("c", 3);
+  EXPECT_EQ(2, cache.size());
+  EXPECT_TRUE(cache.get("a").has_value());
+  EXPECT_FALSE(cache.get("b").has_value());
+  EXPECT_TRUE(cache.get("c").has_value());
+
+  cache.setCapacity(1);
+  EXPECT_EQ(1, cache.size());
+  EXPECT_TRUE(cache.get("c").has_value());
+
+  cache.setCapacity(0);
+  EXPECT_FALSE(cache.enabled());
+  cache.put("d", 4);
+  EXPECT_EQ(0, cache.size());
+  EXPECT_FALSE(cache.get("d").has_value());
+}
@@ -64,3 +64,85 @@ CUDAQ_TEST(MeasureCountsTester, checkMeasureCountsSerialize) {
 
   EXPECT_TRUE(mm == mc);
 }
+
+CUDAQ_TEST(MeasureCountsTester, checkPackedSequentialData) {
+  // Use bit strings that straddle a 64-bit word boundary.
+  const std::string a = std::string(63, '0') + "11" + std::string(5, '0');
+  const std::string b = std::string(70, '1');
+  ExecutionResult r;
+  r.appendResult(a, 2);
+  r.appendResult(b, 1);
+  r.appendResult(a, 1);
+  EXPECT_EQ(4, r.sequentialData.size());
+  EXPECT_EQ(70, r.sequentialData.getNumBits());
+  EXPECT_EQ((std::vector<std::string>{a, a, b, a}), r.getSequentialData());
+
+  cudaq::sample_result mc(r);
+  EXPECT_EQ(3, mc.count(a));
+  EXPECT_EQ(1, mc.count(b));
+  // All shots have even parity.
+  EXPECT_NEAR(1.0, mc.expectation(), 1e-9);
+
+  auto marginal = mc.get_marginal({0, 63, 69});
+  EXPECT_EQ(3, marginal.count("010"));
+  EXPECT_EQ(1, marginal.count("111"));
+  EXPECT_EQ((std::vector<std::string>{"010", "010", "111", "010"}),
+            marginal.sequential_data());
+  EXPECT_NEAR(-1.0, marginal.expectation(), 1e-9);
+
+  // Concatenate shot-wise.
+  ExecutionResult other;
+  other.sequentialData = std::vector<std::string>{"1", "0", "1", "0"};
+  auto cat = r.sequentialData;
+  cat.concatenate(other.sequentialData);
+  EXPECT_EQ((std::vector<std::string>{a + "1", a + "0", b + "1", a + "0"}),
+            cat.toBitStrings());
+  EXPECT_EQ(3, cat.toCounts().size());
+
+  // Reorder the bits of each shot.
+  PackedShotData small(std::vector<std::string>{"100", "011"});
+  small.reorder({2, 0, 1});
+  EXPECT_EQ((std::vector<std::string>{"010", "101"}), small.toBitStrings());
+
+  // Mixed bit string lengths fall back to storing bit strings.
+  small.append("1");
+  EXPECT_TRUE(small.isUnpacked());
+  EXPECT_EQ((std::vector<std::string>{"010", "101", "1"}),
+            small.toBitStrings());
+  EXPECT_EQ(2, small.popcount(1));
+  small.append(PackedShotData(std::vector<std::string>{"11"}));
+  EXPECT_EQ(4, small.size());
+  EXPECT_EQ("11", small[3]);
+  EXPECT_EQ(4, small.toCounts().size());
+}
+
+CUDAQ_TEST(MeasureCountsTester, checkMixedLengthSequentialData) {
+  // Results of kernels measuring different numbers of qubits are merged.
+  ExecutionResult r;
+  r.appendResult("01", 2);
+  ExecutionResult other;
+  other.appendResult("110", 1);
+  other.appendResult("000", 1);
+  r.sequentialData.append(other.sequentialData);
+  EXPECT_TRUE(r.sequentialData.isUnpacked());
+  EXPECT_EQ((std::vector<std::string>{"01", "01", "110", "000"}),
+            r.getSequentialData());
+
+  auto counts = r.sequentialData.toCounts();
+  EXPECT_EQ(3, counts.size());
+  EXPECT_EQ(2, counts["01"]);
+  EXPECT_EQ((std::vector<std::string>{"0", "0", "1", "0"}),
+            r.sequentialData.marginal({0}).toBitStrings());
+
+  ExecutionResult extra;
+  extra.sequentialData = std::vector<std::string>{"1", "0", "1", "1"};
+  r.sequentialData.concatenate(extra.sequentialData);
+  EXPECT_EQ((std::vector<std::string>{"011", "010", "1101", "0001"}),
+            r.getSequentialData());
+
+  // Clearing restores the packed form.
+  r.sequentialData.clear();
+  r.sequentialData.append("11");
+  EXPECT_FALSE(r.sequentialData.isUnpacked());
+  EXPECT_EQ(2, r.sequentialData.getNumBits());
+}
@@ -0,0 +1,108 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "CUDAQTestUtils.h"
+#include "common/MeasurementGrouping.h"
+
+using namespace cudaq;
+
+CUDAQ_TEST(MeasurementGroupingTester, checkQubitWiseGroups) {
+  auto H = 0.5 * spin_op::identity() + 2.0 * spin::x(0) * spin::x(1) +
+           spin::x(0) + spin::z(0) + spin::z(1) + spin::z(0) * spin::z(1);
+
+  auto ungrouped = groupMeasurements(H, MeasurementGrouping::none);
+  EXPECT_EQ(5, ungrouped.size());
+
+  auto groups = groupMeasurements(H, MeasurementGrouping::qubit_wise);
+  ASSERT_EQ(2, groups.size());
+  std::size_t numTerms = 0;
+  for (const auto &group : groups) {
+    ASSERT_TRUE(group.basis.has_value());
+    EXPECT_TRUE(group.basisChange.empty());
+    EXPECT_EQ(group.basis->get_term_id(), group.name);
+    EXPECT_EQ((std::vector<std::size_t>{0, 1}), group.measuredQubits);
+    numTerms += group.terms.size();
+  }
+  EXPECT_EQ(5, numTerms);
+
+  std::vector<std::string> names{groups[0].name, groups[1].name};
+  std::sort(names.begin(), names.end());
+  EXPECT_EQ((std::vector<std::string>{"X0X1", "Z0Z1"}), names);
+}
+
+CUDAQ_TEST(MeasurementGroupingTester, checkGeneralGroups) {
+  // The terms commute, but not qubit-wise.
+  auto H = spin::x(0) * spin::x(1) + spin::y(0) * spin::y(1) +
+           spin::z(0) * spin::z(1);
+
+  EXPECT_EQ(3, groupMeasurements(H, MeasurementGrouping::qubit_wise).size());
+
+  auto groups = groupMeasurements(H, MeasurementGrouping::general);
+  ASSERT_EQ(1, groups.size());
+  const auto &group = groups[0];
+  EXPECT_FALSE(group.basis.has_value());
+  EXPECT_FALSE(group.basisChange.empty());
+  EXPECT_EQ(3, group.terms.size());
+  for (const auto &term : group.terms)
+    EXPECT_FALSE(term.qubits.empty());
+
+  // Qubit-wise commuting groups keep the single-qubit basis changes.
+  auto qwc = groupMeasurements(spin::z(0) + spin::z(0) * spin::z(1),
+                               MeasurementGrouping::general);
+  ASSERT_EQ(1, qwc.size());
+  EXPECT_TRUE(qwc[0].basis.has_value());
+}
+
+CUDAQ_TEST(MeasurementGroupingTester, checkTermResults) {
+  MeasurementGroup group;
+  group.name = "group0";
+  group.measuredQubits = {0, 1};
+  group.terms.push_back({spin::z(0), {0}, false});
+  group.terms.push_back({spin::z(1), {1}, true});
+  group.terms.push_back({spin::z(0) * spin::z(1), {0, 1}, false});
+
+  ExecutionResult groupResult(
+      CountsDictionary{{"00", 30}, {"01", 10}, {"10", 20}, {"11", 40}},
+      group.name);
+  auto results = getTermResults(group, groupResult, {0, 1});
+  ASSERT_EQ(3, results.size());
+
+  EXPECT_EQ("Z0", results[0].registerName);
+  EXPECT_EQ(40, results[0].counts["0"]);
+  EXPECT_EQ(60, results[0].counts["1"]);
+  EXPECT_NEAR(-0.2, results[0].expectationValue.value(), 1e-12);
+
+  // The negated term has its outcomes flipped.
+  EXPECT_EQ("Z1", results[1].registerName);
+  EXPECT_EQ(50, results[1].counts["0"]);
+  EXPECT_EQ(50, results[1].counts["1"]);
+  EXPECT_NEAR(0.0, results[1].expectationValue.value(), 1e-12);
+
+  EXPECT_EQ("Z0Z1", results[2].registerName);
+  EXPECT_NEAR(0.4, results[2].expectationValue.value(), 1e-12);
+
+  // The bits may be in any qubit order.
+  auto swapped = getTermResults(group, groupResult, {1, 0});
+  EXPECT_NEAR(0.0, swapped[0].expectationValue.value(), 1e-12);
+  EXPECT_NEAR(0.2, swapped[1].expectationValue.value(), 1e-12);
+}
+
+CUDAQ_TEST(MeasurementGroupingTester, checkAddGroupedTermResults) {
+  auto H = spin::z(0) + 2.0 * spin::z(1) + spin::z(0) * spin::z(1);
+  ExecutionResult groupResult(
+      CountsDictionary{{"00", 30}, {"01", 10}, {"10", 20}, {"11", 40}},
+      "Z0Z1");
+  sample_result data(groupResult);
+  addGroupedTermResults(data, H);
+
+  EXPECT_EQ((std::vector<std::string>{"Z0", "Z0Z1", "Z1"}),
+            data.register_names());
+  EXPECT_NEAR(-0.2, data.expectation("Z0"), 1e-12);
+  EXPECT_NEAR(0.0, data.expectation("Z1"), 1e-12);
+  EXPECT_NEAR(0.4, data.expectation("Z0Z1"), 1e-12);
+}
@@ -74,3 +74,35 @@ CUDAQ_TEST(NoiseModelTester, checkConstruction) {
   // Can only add channels for ops we know about.
   EXPECT_ANY_THROW({ noise.add_channel("invalid_op", {0}, simpleChannel); });
 }
+
+CUDAQ_TEST(NoiseModelTester, checkLookupChannels) {
+  cudaq::noise_model noise;
+  cudaq::bit_flip_channel bitFlip(0.1);
+  noise.add_channel("x", {0}, bitFlip);
+
+  // Lookups are memoized, and agree with get_channels.
+  auto channels = noise.lookup_channels("x", {0});
+  EXPECT_EQ(channels.get(), noise.lookup_channels("x", {0}).get());
+  EXPECT_EQ(1, channels->size());
+  EXPECT_EQ(noise.get_channels("x", {0}).size(), channels->size());
+  EXPECT_TRUE(noise.lookup_channels("x", {1})->empty());
+
+  // Callback channels are memoized per gate parameters.
+  int numCalls = 0;
+  noise.add_channel("rx",
+                    [&](const std::vector<std::size_t> &qubits,
+                        const std::vector<double> &params) {
+                      ++numCalls;
+                      return cudaq::bit_flip_channel(params[0] / 10.);
+                    });
+  noise.lookup_channels("rx", {0}, {}, {0.5});
+  noise.lookup_channels("rx", {0}, {}, {0.5});
+  EXPECT_EQ(1, numCalls);
+  noise.lookup_channels("rx", {0}, {}, {0.7});
+  EXPECT_EQ(2, numCalls);
+
+  // Adding a channel invalidates the lookups, but not the returned channels.
+  noise.add_channel("x", {0}, bitFlip);
+  EXPECT_EQ(2, noise.lookup_channels("x", {0})->size());
+  EXPECT_EQ(1, channels->size());
+}
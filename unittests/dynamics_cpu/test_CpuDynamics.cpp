@@ -0,0 +1,181 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "CpuDynamicsOperator.h"
+#include "CpuDynamicsState.h"
+#include "common/EigenDense.h"
+#include "cudaq/algorithms/evolve_internal.h"
+#include "cudaq/algorithms/integrator.h"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <unsupported/Eigen/KroneckerProduct>
+
+TEST(CpuDynamicsTester, checkOperatorMatrix) {
+  auto function = [](const std::unordered_map<std::string, std::complex<double>>
+                         &parameters) { return parameters.at("w"); };
+  cudaq::sum_op<cudaq::matrix_handler> op =
+      0.5 * cudaq::spin_op::x(0) * cudaq::spin_op::z(2) +
+      0.3 * cudaq::boson_op::create(1) * cudaq::boson_op::annihilate(1) +
+      cudaq::scalar_operator(function) * cudaq::boson_op::annihilate(1) *
+          cudaq::spin_op::y(0) +
+      cudaq::matrix_op::position(1) + 2.0 +
+      cudaq::matrix_op::squeeze(1) * cudaq::spin_op::x(2);
+  cudaq::CpuDynamicsOperator cpuOp(op, {2, 3, 2});
+  EXPECT_FALSE(cpuOp.is_constant());
+  EXPECT_EQ(cpuOp.dimension(), 12);
+
+  for (double w : {0.7, 1.3}) {
+    const std::unordered_map<std::string, std::complex<double>> params = {
+        {"w", w}, {"squeezing", 0.4}};
+    auto expected = op.to_matrix({{0, 2}, {1, 3}, {2, 2}}, params);
+    Eigen::MatrixXcd actual(cpuOp.evaluate(params));
+    for (std::size_t i = 0; i < 12; ++i)
+      for (std::size_t j = 0; j < 12; ++j)
+        EXPECT_NEAR(std::abs(actual(i, j) - expected(i, j)), 0.0, 1e-12);
+  }
+
+  cudaq::sum_op<cudaq::matrix_handler> constantOp =
+      cudaq::spin_op::x(0) + 0.5 * cudaq::spin_op::z(1);
+  EXPECT_TRUE(cudaq::CpuDynamicsOperator(constantOp, {2, 2}).is_constant());
+  EXPECT_ANY_THROW(cudaq::CpuDynamicsOperator(constantOp, {2}));
+}
+
+TEST(CpuDynamicsTester, checkSimple) {
+  const cudaq::dimension_map dims = {{0, 2}};
+  cudaq::product_op<cudaq::matrix_handler> ham1 =
+      (2.0 * M_PI * 0.1 * cudaq::spin_op::x(0));
+  cudaq::sum_op<cudaq::matrix_handler> ham(ham1);
+
+  constexpr int numSteps = 10;
+  std::vector<double> steps = cudaq::linspace(0.0, 1.0, numSteps);
+  cudaq::schedule schedule(steps, {"t"});
+
+  cudaq::product_op<cudaq::matrix_handler> pauliZ_t = cudaq::spin_op::z(0);
+  cudaq::sum_op<cudaq::matrix_handler> pauliZ(pauliZ_t);
+  auto initialState =
+      cudaq::state::from_data(std::vector<std::complex<double>>{1.0, 0.0});
+
+  for (int order : {1, 2, 4}) {
+    cudaq::integrators::runge_kutta integrator(order, 0.001);
+    auto result = cudaq::__internal__::evolveSingle(
+        ham, dims, schedule, initialState, integrator, {}, {pauliZ}, true);
+    EXPECT_TRUE(result.expectation_values.has_value());
+    EXPECT_EQ(result.expectation_values.value().size(), numSteps);
+
+    int count = 0;
+    for (auto expVals : result.expectation_values.value()) {
+      EXPECT_EQ(expVals.size(), 1);
+      const double expected = std::cos(2 * 2.0 * M_PI * 0.1 * steps[count++]);
+      EXPECT_NEAR((double)expVals[0], expected, 1e-3);
+    }
+  }
+
+  // The initial state is not modified by the evolution.
+  EXPECT_NEAR(std::abs(initialState({0}) - 1.0), 0.0, 1e-12);
+}
+
+TEST(CpuDynamicsTester, checkCompositeSystemWithCollapse) {
+  constexpr int cavity_levels = 10;
+  const cudaq::dimension_map dims = {{0, 2}, {1, cavity_levels}};
+  auto a = cudaq::boson_op::annihilate(1);
+  auto a_dag = cudaq::boson_op::create(1);
+
+  auto sm = cudaq::boson_op::annihilate(0);
+  auto sm_dag = cudaq::boson_op::create(0);
+
+  cudaq::product_op<cudaq::matrix_handler> atom_occ_op_t =
+      cudaq::matrix_handler::number(0);
+  cudaq::sum_op<cudaq::matrix_handler> atom_occ_op(atom_occ_op_t);
+
+  cudaq::product_op<cudaq::matrix_handler> cavity_occ_op_t =
+      cudaq::matrix_handler::number(1);
+  cudaq::sum_op<cudaq::matrix_handler> cavity_occ_op(cavity_occ_op_t);
+
+  auto hamiltonian = 2 * M_PI * atom_occ_op + 2 * M_PI * cavity_occ_op +
+                     2 * M_PI * 0.25 * (sm * a_dag + sm_dag * a);
+  Eigen::Vector2cd qubit_state;
+  qubit_state << 1.0, 0.0;
+  Eigen::VectorXcd cavity_state = Eigen::VectorXcd::Zero(cavity_levels);
+  const int num_photons = 5;
+  cavity_state[num_photons] = 1.0;
+  Eigen::VectorXcd initial_state_vec =
+      Eigen::kroneckerProduct(cavity_state, qubit_state);
+  constexpr int num_steps = 11;
+  std::vector<double> timeSteps = cudaq::linspace(0.0, 1.0, num_steps);
+  cudaq::schedule schedule(timeSteps, {"t"});
+  // The state vector is converted to a density matrix since there are
+  // collapse operators.
+  auto initialState = cudaq::state::from_data(
+      std::make_pair(initial_state_vec.data(), initial_state_vec.size()));
+  cudaq::integrators::runge_kutta integrator(4, 0.001);
+  constexpr double decayRate = 0.1;
+  cudaq::product_op<cudaq::matrix_handler> collapsedOp_t =
+      std::sqrt(decayRate) * a;
+  cudaq::sum_op<cudaq::matrix_handler> collapsedOp(collapsedOp_t);
+  cudaq::evolve_result result = cudaq::__internal__::evolveSingle(
+      hamiltonian, dims, schedule, initialState, integrator, {collapsedOp},
+      {cavity_occ_op, atom_occ_op}, true);
+  EXPECT_TRUE(result.expectation_values.has_value());
+  EXPECT_EQ(result.expectation_values.value().size(), num_steps);
+
+  int count = 0;
+  for (auto expVals : result.expectation_values.value()) {
+    EXPECT_EQ(expVals.size(), 2);
+    const double totalParticleCount = expVals[0] + expVals[1];
+    const auto time = timeSteps[count++];
+    const double expectedResult = num_photons * std::exp(-decayRate * time);
+    EXPECT_NEAR(totalParticleCount, expectedResult, 0.1);
+  }
+
+  ASSERT_TRUE(result.states.has_value());
+  auto *finalState = dynamic_cast<cudaq::CpuDynamicsState *>(
+      cudaq::state_helper::getSimulationState(&result.states->back()));
+  ASSERT_NE(finalState, nullptr);
+  EXPECT_TRUE(finalState->is_density_matrix());
+  const auto dim = finalState->get_dimension();
+  Eigen::Map<const Eigen::MatrixXcd> rho(finalState->get_data().data(), dim,
+                                         dim);
+  EXPECT_NEAR(rho.trace().real(), 1.0, 1e-6);
+}
+
+TEST(CpuDynamicsTester, checkScalarTd) {
+  const cudaq::dimension_map dims = {{0, 2}};
+
+  constexpr int numSteps = 31;
+  std::vector<double> steps = cudaq::linspace(0.0, 3.0, numSteps);
+  cudaq::schedule schedule(steps, {"t"});
+
+  // Drive with a time-dependent amplitude `omega * cos(t)`.
+  constexpr double omega = 2.0 * M_PI * 0.1;
+  auto function = [](const std::unordered_map<std::string, std::complex<double>>
+                         &parameters) {
+    auto entry = parameters.find("t");
+    if (entry == parameters.end())
+      throw std::runtime_error("Cannot find value of expected parameter");
+    return omega * std::cos(entry->second.real());
+  };
+  cudaq::product_op<cudaq::matrix_handler> ham1 =
+      cudaq::scalar_operator(function) * cudaq::spin_op::x(0);
+  cudaq::sum_op<cudaq::matrix_handler> ham(ham1);
+  cudaq::product_op<cudaq::matrix_handler> obs1 = cudaq::spin_op::z(0);
+  cudaq::sum_op<cudaq::matrix_handler> obs(obs1);
+  auto initialState =
+      cudaq::state::from_data(std::vector<std::complex<double>>{1.0, 0.0});
+  cudaq::integrators::runge_kutta integrator(4, 0.001);
+  auto result = cudaq::__internal__::evolveSingle(
+      ham, dims, schedule, initialState, integrator, {}, {obs}, true);
+  EXPECT_TRUE(result.expectation_values.has_value());
+  EXPECT_EQ(result.expectation_values.value().size(), numSteps);
+
+  int count = 0;
+  for (auto expVals : result.expectation_values.value()) {
+    EXPECT_EQ(expVals.size(), 1);
+    const double expected = std::cos(2 * omega * std::sin(steps[count++]));
+    EXPECT_NEAR((double)expVals[0], expected, 1e-3);
+  }
+}
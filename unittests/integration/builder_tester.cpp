@@ -622,6 +622,87 @@ CUDAQ_TEST(BuilderTester, checkConditional) {
     counts.dump();
     EXPECT_EQ(counts.count("010"), 1000);
   }
+
+  // The state before the first measurement may be reused across shots, but
+  // each shot must still draw its own measurement result, and kernels with a
+  // different prefix must not pick up the previous state.
+  for (double p : {0.2, 0.8}) {
+    cudaq::set_random_seed(13);
+    auto kernel = cudaq::make_kernel();
+    auto q = kernel.qalloc(3);
+    kernel.ry(2. * std::asin(std::sqrt(p)), q[0]);
+    kernel.x<cudaq::ctrl>(q[0], q[2]);
+    auto mres = kernel.mz(q[0], "res0");
+    kernel.c_if(mres, [&]() { kernel.x(q[1]); });
+    kernel.mz(q);
+
+    auto counts = cudaq::sample(kernel);
+    counts.dump();
+    EXPECT_NEAR(counts.count("1", "res0") / 1000., p, 1e-1);
+    EXPECT_EQ(counts.count("000") + counts.count("111"), 1000);
+  }
+}
+
+CUDAQ_TEST(BuilderTester, checkConditionalParallelShots) {
+  auto kernel = cudaq::make_kernel();
+  auto q = kernel.qalloc(2);
+  kernel.h(q[0]);
+  auto mres = kernel.mz(q[0], "res0");
+  kernel.c_if(mres, [&]() { kernel.x(q[1]); });
+  kernel.mz(q);
+
+  const auto numParallelSamplings =
+      cudaq::details::getNumShotParallelSamplings();
+  setenv("CUDAQ_PARALLEL_SHOT_THREADS", "4", /*overwrite=*/1);
+  cudaq::set_random_seed(13);
+  auto counts = cudaq::sample(kernel);
+  cudaq::set_random_seed(13);
+  auto again = cudaq::sample(kernel);
+  unsetenv("CUDAQ_PARALLEL_SHOT_THREADS");
+  counts.dump();
+
+#if defined(CUDAQ_BACKEND_QPP) || defined(CUDAQ_BACKEND_STIM)
+  // Both calls ran their shots on several threads, rather than silently
+  // falling back to serial shots.
+  EXPECT_EQ(cudaq::details::getNumShotParallelSamplings(),
+            numParallelSamplings + 2);
+#else
+  // The other backends do not opt into concurrent shots, and run them
+  // serially.
+  EXPECT_EQ(cudaq::details::getNumShotParallelSamplings(),
+            numParallelSamplings);
+#endif
+
+  EXPECT_EQ(counts.get_total_shots(), 1000);
+  EXPECT_EQ(counts.count("00") + counts.count("11"), 1000);
+  EXPECT_NEAR(counts.count("1", "res0") / 1000., 0.5, 1e-1);
+  // The same seed and number of threads give the same results.
+  EXPECT_EQ(counts.count("11"), again.count("11"));
+  EXPECT_EQ(counts.count("1", "res0"), again.count("1", "res0"));
+
+#ifdef CUDAQ_BACKEND_QPP
+  // Noise channels are drawn from the random number stream of each thread
+  // too, so noisy shots are reproducible as well.
+  cudaq::noise_model noise;
+  noise.add_all_qubit_channel<cudaq::types::x>(cudaq::bit_flip_channel(0.2));
+  cudaq::set_noise(noise);
+  setenv("CUDAQ_PARALLEL_SHOT_THREADS", "4", /*overwrite=*/1);
+  cudaq::set_random_seed(13);
+  auto noisyCounts = cudaq::sample(kernel);
+  cudaq::set_random_seed(13);
+  auto noisyAgain = cudaq::sample(kernel);
+  unsetenv("CUDAQ_PARALLEL_SHOT_THREADS");
+  cudaq::unset_noise();
+  noisyCounts.dump();
+  EXPECT_EQ(cudaq::details::getNumShotParallelSamplings(),
+            numParallelSamplings + 4);
+
+  EXPECT_EQ(noisyCounts.get_total_shots(), 1000);
+  // The bit flips after the conditional X break the correlation.
+  EXPECT_GT(noisyCounts.count("10"), 0);
+  EXPECT_EQ(noisyCounts.to_map(), noisyAgain.to_map());
+  EXPECT_EQ(noisyCounts.count("1", "res0"), noisyAgain.count("1", "res0"));
+#endif
 }
 #endif
 
@@ -1459,6 +1540,35 @@ CUDAQ_TEST(BuilderTester, checkCanProgressivelyBuild) {
   EXPECT_TRUE(counts.count("11") != 0);
 }
 
+CUDAQ_TEST(BuilderTester, checkCompileAsync) {
+  auto kernel = cudaq::make_kernel();
+  auto q = kernel.qalloc(2);
+  kernel.x(q[0]);
+  kernel.compile_async();
+
+  // The invocation adopts the engine compiled in the background.
+  auto counts = cudaq::sample(kernel);
+  EXPECT_EQ(counts.size(), 1);
+  EXPECT_EQ(counts.count("10"), 1000);
+  EXPECT_EQ(kernel.get_num_blocking_compilations(), 0);
+
+  // Compiling again without changes is a no-op.
+  kernel.compile_async();
+  counts = cudaq::sample(kernel);
+  EXPECT_EQ(counts.count("10"), 1000);
+  EXPECT_EQ(kernel.get_num_blocking_compilations(), 0);
+
+  // Instructions added while (or after) compiling in the background must be
+  // picked up by the next invocation.
+  kernel.x(q[1]);
+  kernel.compile_async();
+  kernel.x<cudaq::ctrl>(q[0], q[1]);
+  counts = cudaq::sample(kernel);
+  EXPECT_EQ(counts.size(), 1);
+  EXPECT_EQ(counts.count("10"), 1000);
+  EXPECT_EQ(kernel.get_num_blocking_compilations(), 1);
+}
+
 CUDAQ_TEST(BuilderTester, checkQuakeValueOperators) {
   // Test arith operators on QuakeValue
   auto [kernel1, theta] = cudaq::make_kernel<double>();
@@ -12,7 +12,7 @@
 #include <stdio.h>
 
 #if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_STIM) ||                \
-    defined(CUDAQ_BACKEND_TENSORNET)
+    defined(CUDAQ_BACKEND_TENSORNET) || defined(CUDAQ_BACKEND_QPP)
 struct xOp {
   void operator()() __qpu__ {
     cudaq::qubit q;
@@ -378,7 +378,7 @@ CUDAQ_TEST(NoiseTest, checkExceptions) {
 
 #endif
 #if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_STIM) ||                \
-    defined(CUDAQ_BACKEND_TENSORNET)
+    defined(CUDAQ_BACKEND_TENSORNET) || defined(CUDAQ_BACKEND_QPP)
 
 CUDAQ_TEST(NoiseTest, checkDepolType) {
   cudaq::set_random_seed(13);
@@ -425,7 +425,7 @@ CUDAQ_TEST(NoiseTest, checkApplySimplePauliErrors) {
 
 #endif
 #if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_STIM) ||                \
-    defined(CUDAQ_BACKEND_TENSORNET)
+    defined(CUDAQ_BACKEND_TENSORNET) || defined(CUDAQ_BACKEND_QPP)
 
 CUDAQ_TEST(NoiseTest, checkDepolTypeSimple) {
   cudaq::set_random_seed(13);
@@ -442,7 +442,7 @@ CUDAQ_TEST(NoiseTest, checkDepolTypeSimple) {
 }
 
 #endif
-#if defined(CUDAQ_BACKEND_DM)
+#if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_QPP)
 // Stim does not support cudaq::amplitude_damping_channel.
 
 CUDAQ_TEST(NoiseTest, checkAmpDampType) {
@@ -992,7 +992,8 @@ CUDAQ_TEST(NoiseTest, checkMeasurementNoise) {
 
 #endif
 
-#if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_TENSORNET)
+#if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_TENSORNET) ||          \
+    defined(CUDAQ_BACKEND_QPP)
 CUDAQ_TEST(NoiseTest, checkObserveHamiltonianWithNoise) {
 
   cudaq::spin_op h =
@@ -1080,3 +1081,54 @@ CUDAQ_TEST(NoiseTest, checkNoiseMatrixRepresentation) {
   cudaq::unset_noise(); // clear for subsequent tests
 }
 #endif
+
+#if defined(CUDAQ_BACKEND_QPP)
+CUDAQ_TEST(NoiseTest, checkTrajectoryNoise) {
+  cudaq::set_random_seed(13);
+  cudaq::bit_flip_channel bf(.2);
+  cudaq::noise_model noise;
+  noise.add_channel<cudaq::types::x>({0}, bf);
+  cudaq::set_noise(noise);
+  // Every shot runs its own trajectory.
+  auto counts = cudaq::sample(10000, xOp{});
+  counts.dump();
+  EXPECT_EQ(10000, counts.get_total_shots());
+  EXPECT_NEAR(counts.probability("0"), .2, .02);
+
+  // Trajectories draw their errors from the simulator seed.
+  cudaq::set_random_seed(13);
+  auto again = cudaq::sample(10000, xOp{});
+  EXPECT_EQ(counts.to_map(), again.to_map());
+  cudaq::unset_noise(); // clear for subsequent tests
+}
+
+struct midCircuitMeasureOp {
+  void operator()() __qpu__ {
+    cudaq::qvector q(2);
+    x(q);
+    mz(q[0]);
+    x(q[1]);
+    mz(q[1]);
+  }
+};
+
+CUDAQ_TEST(NoiseTest, checkTrajectoryNoiseMidCircuitMeasure) {
+  cudaq::set_random_seed(13);
+  cudaq::bit_flip_channel bf(.2);
+  cudaq::noise_model noise;
+  noise.add_all_qubit_channel<cudaq::types::x>(bf);
+  cudaq::set_noise(noise);
+  // Without conditional feedback, the measurement of q0 is deferred to the end
+  // of the kernel, and every shot runs its own trajectory of the whole
+  // circuit: q0 is 1 with probability 0.8, and q1 with probability
+  // 2 * 0.2 * 0.8 = 0.32.
+  auto counts = cudaq::sample(10000, midCircuitMeasureOp{});
+  counts.dump();
+  EXPECT_EQ(10000, counts.get_total_shots());
+  EXPECT_NEAR(counts.probability("10"), .8 * .68, .02);
+  EXPECT_NEAR(counts.probability("11"), .8 * .32, .02);
+  EXPECT_NEAR(counts.probability("00"), .2 * .68, .02);
+  EXPECT_NEAR(counts.probability("01"), .2 * .32, .02);
+  cudaq::unset_noise(); // clear for subsequent tests
+}
+#endif
@@ -49,7 +49,8 @@ CUDAQ_TEST(ObserveResult, checkSimple) {
   printf("Energy from observe_result %lf\n", obs_res.expectation());
 
   // Observe using options w/ noise model. Note that the noise model is only
-  // honored when using the Density Matrix backend.
+  // honored when using a backend that supports noise (e.g., the Density Matrix
+  // backend, or the QPP backend with trajectories).
   int shots = 252;
   cudaq::set_random_seed(13);
   cudaq::depolarization_channel depol(1.);
@@ -123,5 +124,30 @@ CUDAQ_TEST(ObserveResult, checkExpValBug) {
   // it acts on a different number of qubits). This is in particular
   // also relevant for noise modeling.
 }
+
+CUDAQ_TEST(ObserveResult, checkMeasurementGrouping) {
+  cudaq::spin_op h = .5 + cudaq::spin_op::z(0) + cudaq::spin_op::z(1) +
+                     cudaq::spin_op::z(0) * cudaq::spin_op::z(1) +
+                     cudaq::spin_op::x(0) * cudaq::spin_op::x(1) +
+                     cudaq::spin_op::y(0) * cudaq::spin_op::y(1) +
+                     .5 * cudaq::spin_op::x(2) +
+                     .5 * cudaq::spin_op::z(1) * cudaq::spin_op::x(2);
+
+  auto exact = cudaq::observe(deuteron_n3_ansatz{}, h, .5, .3);
+
+  // Grouping commuting terms measures fewer circuits, but gives the same
+  // expectation values, up to shot noise.
+  cudaq::set_random_seed(13);
+  for (const char *grouping : {"none", "qubit_wise", "general"}) {
+    setenv("CUDAQ_OBSERVE_GROUPING", grouping, /*overwrite=*/1);
+    auto result = cudaq::observe(100000, deuteron_n3_ansatz{}, h, .5, .3);
+    printf("Energy with %s grouping %lf\n", grouping, result.expectation());
+    EXPECT_NEAR(result.expectation(), exact.expectation(), 5e-2);
+    for (const auto &term : h)
+      if (!term.is_identity())
+        EXPECT_NEAR(result.expectation(term), exact.expectation(term), 2e-2);
+  }
+  unsetenv("CUDAQ_OBSERVE_GROUPING");
+}
 #endif
 #endif
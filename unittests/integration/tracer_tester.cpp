@@ -110,3 +110,45 @@ CUDAQ_TEST(TracerTester, checkLargeTrace) {
   auto totalOps = resources.count();
   EXPECT_EQ(totalOps, numLayers * numQubits * 1.5);
 }
+
+CUDAQ_TEST(TracerTester, checkDepthAndQubits) {
+
+  auto kernel = []() __qpu__ {
+    cudaq::qvector q(4);
+    h(q[0]);
+    h(q[1]);
+    x<cudaq::ctrl>(q[0], q[1]);
+    x<cudaq::ctrl>(q[1], q[2]);
+    h(q[0]);
+    swap(q[2], q[3]);
+  };
+
+  auto resources = cudaq::estimate_resources(kernel);
+  EXPECT_EQ(4, resources.num_qubits());
+  EXPECT_EQ(4, resources.depth());
+  EXPECT_EQ(6, resources.count());
+
+  // Recording the trace and computing the resources afterwards gives the same
+  // estimate.
+  cudaq::Trace trace;
+  trace.appendInstruction("h", {}, {}, {cudaq::QuditInfo(2, 0)});
+  trace.appendInstruction("x", {}, {cudaq::QuditInfo(2, 0)},
+                          {cudaq::QuditInfo(2, 1)});
+  trace.appendInstruction("rz", {0.5}, {}, {cudaq::QuditInfo(2, 2)});
+  auto computed = cudaq::Resources::compute(trace);
+
+  cudaq::Resources streamed;
+  cudaq::Trace streamingTrace;
+  streamingTrace.streamTo(&streamed);
+  for (const auto &inst : trace)
+    streamingTrace.appendInstruction(inst.name, inst.params, inst.controls,
+                                     inst.targets);
+  EXPECT_EQ(streamingTrace.begin(), streamingTrace.end());
+  EXPECT_EQ(streamingTrace.getNumQudits(), trace.getNumQudits());
+  for (auto *res : {&computed, &streamed}) {
+    EXPECT_EQ(3, res->count());
+    EXPECT_EQ(1, res->count("x", {0}, 1));
+    EXPECT_EQ(2, res->depth());
+    EXPECT_EQ(3, res->num_qubits());
+  }
+}
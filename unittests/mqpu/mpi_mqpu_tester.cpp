@@ -38,3 +38,50 @@ TEST(MPIObserveTester, checkSimple) {
     printf("Get energy directly as double %lf\n", result);
   }
 }
+
+TEST(MPIObserveTester, checkPerTermResults) {
+  cudaq::spin_op h =
+      5.907 - 2.1433 * cudaq::spin_op::x(0) * cudaq::spin_op::x(1) -
+      2.1433 * cudaq::spin_op::y(0) * cudaq::spin_op::y(1) +
+      .21829 * cudaq::spin_op::z(0) - 6.125 * cudaq::spin_op::z(1);
+
+  auto ansatz = [](double theta) __qpu__ {
+    cudaq::qubit q, r;
+    x(q);
+    ry(theta, r);
+    x<cudaq::ctrl>(r, q);
+  };
+
+  // Every rank gets the results of all the terms, not only of its own terms.
+  auto result = cudaq::observe<cudaq::parallel::mpi>(ansatz, h, 0.59);
+  auto expected = cudaq::observe(ansatz, h, 0.59);
+  EXPECT_NEAR(result.expectation(), expected.expectation(), 1e-6);
+  for (const auto &term : h) {
+    if (term.is_identity())
+      continue;
+    EXPECT_NEAR(result.expectation(term), expected.expectation(term), 1e-6);
+  }
+}
+
+TEST(MPIObserveTester, checkDistributeTermsByCost) {
+  cudaq::spin_op h = cudaq::spin_op::x(0) * cudaq::spin_op::x(1) *
+                         cudaq::spin_op::x(2) * cudaq::spin_op::x(3) +
+                     cudaq::spin_op::z(0) + cudaq::spin_op::z(1) +
+                     cudaq::spin_op::z(2) + cudaq::spin_op::z(3);
+
+  auto parts = cudaq::details::distributeTermsByCost(h, 2);
+  ASSERT_EQ(parts.size(), 2);
+  // The 4-Pauli term (cost 5) goes first, the single-Pauli terms (cost 2)
+  // then fill the least loaded part: loads end up as 5 + 2 and 3 * 2.
+  EXPECT_EQ(parts[0].num_terms(), 2);
+  EXPECT_EQ(parts[1].num_terms(), 3);
+  EXPECT_EQ(parts[0].num_terms() + parts[1].num_terms(), h.num_terms());
+
+  // More parts than terms, the extra parts are empty.
+  auto manyParts = cudaq::details::distributeTermsByCost(h, 8);
+  ASSERT_EQ(manyParts.size(), 8);
+  std::size_t numTerms = 0;
+  for (auto &part : manyParts)
+    numTerms += part.num_terms();
+  EXPECT_EQ(numTerms, h.num_terms());
+}
@@ -126,3 +126,25 @@ TEST(MQPUTester, checkAsyncWithKernelBuilder) {
     EXPECT_NEAR(std::abs(gotState[1] - expectedState[1]), 0.0, 1e-6);
   }
 }
+
+TEST(MQPUTester, checkDistributedMatchesSerial) {
+  // More terms than chunks, so that several chunks run on each QPU.
+  int nQubits = 6;
+  int nTerms = 300;
+  auto H = cudaq::spin_op::random(nQubits, nTerms, std::mt19937::default_seed);
+
+  auto ansatz = [](int n_qubits, std::vector<double> params) __qpu__ {
+    cudaq::qvector q(n_qubits);
+    for (int i = 0; i < n_qubits; i++)
+      ry(params[i], q[i]);
+    for (int i = 0; i < n_qubits - 1; i++)
+      x<cudaq::ctrl>(q[i], q[i + 1]);
+  };
+
+  auto params = cudaq::random_vector(-M_PI, M_PI, nQubits,
+                                     std::mt19937::default_seed);
+  double serial = cudaq::observe(ansatz, H, nQubits, params);
+  double distributed =
+      cudaq::observe<cudaq::parallel::thread>(ansatz, H, nQubits, params);
+  EXPECT_NEAR(serial, distributed, 1e-6);
+}
@@ -0,0 +1,332 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+// Microbenchmarks for the operator algebra. Each benchmark is run for a range
+// of term counts and timed until a minimum run time is reached. The results
+// are printed as a table and can be written to a JSON file in the format of
+// Google Benchmark, such that runs of different releases can be compared with
+// its tooling (e.g., `compare.py benchmarks old.json new.json`).
+//
+// Usage: bench_operators [--benchmark_filter=<regex>]
+//                        [--benchmark_min_time=<seconds>]
+//                        [--benchmark_max_terms=<count>]
+//                        [--benchmark_out=<file.json>]
+
+#include "cudaq/operators.h"
+#include "nlohmann/json.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <random>
+#include <regex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/// @brief Timing state of a single benchmark run, modeled after
+/// `benchmark::State`. The benchmark body is executed as long as
+/// `keepRunning` returns true; work between `pauseTiming` and `resumeTiming`
+/// is excluded from the measurement.
+class BenchmarkState {
+public:
+  BenchmarkState(std::size_t size, double minTime)
+      : size(size), minTime(minTime) {}
+
+  /// @brief The number of terms this run is parameterized by.
+  std::size_t range() const { return size; }
+
+  bool keepRunning() {
+    if (!started) {
+      started = true;
+      resumeTiming();
+      return true;
+    }
+    iterations++;
+    if (realTime() < minTime)
+      return true;
+    pauseTiming();
+    return false;
+  }
+
+  void pauseTiming() {
+    realElapsed += std::chrono::steady_clock::now() - realStart;
+    cpuElapsed += std::clock() - cpuStart;
+    paused = true;
+  }
+
+  void resumeTiming() {
+    realStart = std::chrono::steady_clock::now();
+    cpuStart = std::clock();
+    paused = false;
+  }
+
+  std::size_t numIterations() const { return iterations; }
+
+  /// @brief Total measured wall time in seconds.
+  double realTime() const {
+    auto elapsed = realElapsed;
+    if (!paused)
+      elapsed += std::chrono::steady_clock::now() - realStart;
+    return std::chrono::duration<double>(elapsed).count();
+  }
+
+  /// @brief Total measured CPU time in seconds.
+  double cpuTime() const {
+    return static_cast<double>(cpuElapsed) / CLOCKS_PER_SEC;
+  }
+
+private:
+  std::size_t size;
+  double minTime;
+  bool started = false;
+  bool paused = true;
+  std::size_t iterations = 0;
+  std::chrono::steady_clock::time_point realStart;
+  std::chrono::steady_clock::duration realElapsed{0};
+  std::clock_t cpuStart = 0;
+  std::clock_t cpuElapsed = 0;
+};
+
+/// @brief Prevent the compiler from optimizing away the computation of
+/// \p value.
+template <typename T>
+void doNotOptimize(T &&value) {
+  asm volatile("" : : "r"(&value) : "memory");
+}
+
+struct Benchmark {
+  std::string name;
+  std::vector<std::size_t> sizes;
+  std::function<void(BenchmarkState &)> run;
+};
+
+std::vector<std::size_t> termCounts(std::size_t max) {
+  std::vector<std::size_t> sizes;
+  for (std::size_t n = 10; n <= max; n *= 10)
+    sizes.push_back(n);
+  return sizes;
+}
+
+/// @brief Return a spin operator with \p numTerms distinct terms acting on up
+/// to \p numQubits qubits. Each term acts on at most 5 qubits, as in molecular
+/// Hamiltonians, and the coefficients take 10 different values. Operators are
+/// generated once per configuration and cached.
+const cudaq::spin_op &getHamiltonian(std::size_t numTerms,
+                                     std::size_t numQubits = 20) {
+  static std::map<std::pair<std::size_t, std::size_t>, cudaq::spin_op> cache;
+  auto iter = cache.find({numTerms, numQubits});
+  if (iter != cache.end())
+    return iter->second;
+
+  std::mt19937 gen(13);
+  std::uniform_int_distribution<std::size_t> weightDist(
+      1, std::min<std::size_t>(5, numQubits));
+  std::uniform_int_distribution<std::size_t> qubitDist(0, numQubits - 1);
+  std::uniform_int_distribution<int> pauliDist(0, 2);
+  auto H = cudaq::spin_op::empty();
+  for (std::size_t i = 0; H.num_terms() < numTerms; i++) {
+    cudaq::spin_op_term term(0.1 * (1 + i % 10));
+    for (std::size_t w = weightDist(gen); w > 0; w--) {
+      auto qubit = qubitDist(gen);
+      switch (pauliDist(gen)) {
+      case 0:
+        term *= cudaq::spin_op::x(qubit);
+        break;
+      case 1:
+        term *= cudaq::spin_op::y(qubit);
+        break;
+      default:
+        term *= cudaq::spin_op::z(qubit);
+      }
+    }
+    if (!term.is_identity())
+      H += term;
+  }
+  return cache.emplace(std::make_pair(numTerms, numQubits), std::move(H))
+      .first->second;
+}
+
+std::vector<cudaq::spin_op_term> getTerms(std::size_t numTerms) {
+  const auto &H = getHamiltonian(numTerms);
+  return std::vector<cudaq::spin_op_term>(H.begin(), H.end());
+}
+
+std::vector<Benchmark> getBenchmarks(std::size_t maxTerms) {
+  const auto algebraSizes = termCounts(maxTerms);
+  // The product and matrix benchmarks grow faster than linearly in the term
+  // count, and use smaller sizes.
+  const auto productSizes = termCounts(std::min<std::size_t>(maxTerms, 10000));
+  const auto denseSizes = termCounts(std::min<std::size_t>(maxTerms, 1000));
+  const auto sparseSizes = termCounts(std::min<std::size_t>(maxTerms, 1000));
+
+  std::vector<Benchmark> benchmarks;
+
+  benchmarks.push_back({"sum_op/add", algebraSizes, [](auto &state) {
+                          auto terms = getTerms(state.range());
+                          while (state.keepRunning()) {
+                            auto sum = cudaq::spin_op::empty();
+                            for (const auto &term : terms)
+                              sum += term;
+                            doNotOptimize(sum);
+                          }
+                        }});
+
+  benchmarks.push_back(
+      {"sum_op/multiply", algebraSizes, [](auto &state) {
+         const auto &H = getHamiltonian(state.range());
+         auto rhs = cudaq::spin_op::x(0) + cudaq::spin_op::z(1);
+         while (state.keepRunning())
+           doNotOptimize(H * rhs);
+       }});
+
+  benchmarks.push_back({"product_op/multiply", productSizes, [](auto &state) {
+                          auto terms = getTerms(state.range());
+                          while (state.keepRunning()) {
+                            cudaq::spin_op_term product;
+                            for (const auto &term : terms)
+                              product *= term;
+                            doNotOptimize(product);
+                          }
+                        }});
+
+  benchmarks.push_back({"sum_op/canonicalize", algebraSizes, [](auto &state) {
+                          const auto &H = getHamiltonian(state.range());
+                          while (state.keepRunning())
+                            doNotOptimize(cudaq::spin_op::canonicalize(H));
+                        }});
+
+  benchmarks.push_back({"sum_op/trim", algebraSizes, [](auto &state) {
+                          const auto &H = getHamiltonian(state.range());
+                          while (state.keepRunning()) {
+                            state.pauseTiming();
+                            auto copy = H;
+                            state.resumeTiming();
+                            doNotOptimize(copy.trim(0.45));
+                          }
+                        }});
+
+  benchmarks.push_back(
+      {"sum_op/to_matrix", denseSizes, [](auto &state) {
+         const auto &H = getHamiltonian(state.range(), 8);
+         while (state.keepRunning())
+           doNotOptimize(H.to_matrix());
+       }});
+
+  benchmarks.push_back(
+      {"sum_op/to_sparse_matrix", sparseSizes, [](auto &state) {
+         const auto &H = getHamiltonian(state.range(), 10);
+         while (state.keepRunning())
+           doNotOptimize(H.to_sparse_matrix());
+       }});
+
+  benchmarks.push_back(
+      {"sum_op/distribute_terms", algebraSizes, [](auto &state) {
+         const auto &H = getHamiltonian(state.range());
+         while (state.keepRunning())
+           doNotOptimize(H.distribute_terms(64));
+       }});
+
+  benchmarks.push_back({"sum_op/serialize", algebraSizes, [](auto &state) {
+                          const auto &H = getHamiltonian(state.range());
+                          while (state.keepRunning())
+                            doNotOptimize(H.get_data_representation());
+                        }});
+
+  benchmarks.push_back(
+      {"sum_op/deserialize", algebraSizes, [](auto &state) {
+         auto data = getHamiltonian(state.range()).get_data_representation();
+         while (state.keepRunning())
+           doNotOptimize(cudaq::spin_op(data));
+       }});
+
+  return benchmarks;
+}
+
+std::string getOption(int argc, char **argv, const std::string &name,
+                      const std::string &defaultValue) {
+  const auto prefix = "--" + name + "=";
+  for (int i = 1; i < argc; i++) {
+    std::string arg(argv[i]);
+    if (arg.rfind(prefix, 0) == 0)
+      return arg.substr(prefix.size());
+  }
+  return defaultValue;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const std::regex filter(getOption(argc, argv, "benchmark_filter", ".*"));
+  const double minTime =
+      std::stod(getOption(argc, argv, "benchmark_min_time", "0.5"));
+  const std::size_t maxTerms =
+      std::stoull(getOption(argc, argv, "benchmark_max_terms", "1000000"));
+  const auto outFile = getOption(argc, argv, "benchmark_out", "");
+
+  nlohmann::json results = nlohmann::json::array();
+  std::printf("%-40s %15s %15s %12s\n", "Benchmark", "Time (ns)", "CPU (ns)",
+              "Iterations");
+  for (auto &benchmark : getBenchmarks(maxTerms)) {
+    for (auto size : benchmark.sizes) {
+      const auto name = benchmark.name + "/" + std::to_string(size);
+      if (!std::regex_search(name, filter))
+        continue;
+
+      BenchmarkState state(size, minTime);
+      benchmark.run(state);
+      const double iterations = state.numIterations();
+      const double realTime = 1e9 * state.realTime() / iterations;
+      const double cpuTime = 1e9 * state.cpuTime() / iterations;
+      std::printf("%-40s %15.0f %15.0f %12zu\n", name.c_str(), realTime,
+                  cpuTime, state.numIterations());
+      std::fflush(stdout);
+
+      results.push_back({{"name", name},
+                         {"run_name", name},
+                         {"run_type", "iteration"},
+                         {"iterations", state.numIterations()},
+                         {"real_time", realTime},
+                         {"cpu_time", cpuTime},
+                         {"time_unit", "ns"},
+                         {"items_per_second", size * 1e9 / realTime}});
+    }
+  }
+
+  if (!outFile.empty()) {
+    const auto now = std::chrono::system_clock::to_time_t(
+        std::chrono::system_clock::now());
+    char date[32];
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z",
+                  std::localtime(&now));
+    nlohmann::json context = {
+        {"date", date},
+        {"executable", argv[0]},
+        {"num_cpus", std::thread::hardware_concurrency()},
+#ifdef NDEBUG
+        {"library_build_type", "release"},
+#else
+        {"library_build_type", "debug"},
+#endif
+    };
+    std::ofstream out(outFile);
+    if (!out) {
+      std::cerr << "Unable to open " << outFile << " for writing.\n";
+      return 1;
+    }
+    out << nlohmann::json{{"context", context}, {"benchmarks", results}}.dump(2)
+        << "\n";
+  }
+  return 0;
+}
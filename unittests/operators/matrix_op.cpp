@@ -786,3 +786,46 @@ TEST(OperatorExpressions, checkMatrixOpsParameterVerification) {
   ASSERT_NO_THROW((squeeze * displace).to_matrix(dimensions, parameters));
   ASSERT_NO_THROW((squeeze + displace).to_matrix(dimensions, parameters));
 }
+
+TEST(OperatorExpressions, checkMatrixOpsParameterDescriptions) {
+
+  // Operators with a fixed matrix declare that they take no parameters.
+  for (const auto &op : {cudaq::matrix_handler(0),
+                         cudaq::matrix_handler::number(0),
+                         cudaq::matrix_handler::position(0),
+                         cudaq::matrix_handler(cudaq::spin_handler(0)),
+                         cudaq::matrix_handler(cudaq::boson_handler(0))}) {
+    auto descriptions = op.get_parameter_descriptions();
+    ASSERT_TRUE(descriptions.has_value());
+    EXPECT_TRUE(descriptions->empty());
+  }
+
+  auto squeeze = cudaq::matrix_handler::squeeze(0).get_parameter_descriptions();
+  ASSERT_TRUE(squeeze.has_value());
+  EXPECT_EQ(squeeze->size(), 1);
+  EXPECT_EQ(squeeze->count("squeezing"), 1);
+  auto displace =
+      cudaq::matrix_handler::displace(0).get_parameter_descriptions();
+  ASSERT_TRUE(displace.has_value());
+  EXPECT_EQ(displace->size(), 1);
+  EXPECT_EQ(displace->count("displacement"), 1);
+
+  // Custom operators only have descriptions if they declare their parameters.
+  auto func = [](const std::vector<int64_t> &dimensions,
+                 const std::unordered_map<std::string, std::complex<double>>
+                     &parameters) {
+    return parameters.at("scale") * utils::id_matrix(dimensions[0]);
+  };
+  cudaq::matrix_handler::define("custom_op_declared", {-1}, func,
+                                {{"scale", "The scale of the identity."}});
+  cudaq::matrix_handler::define("custom_op_undeclared", {-1}, func);
+
+  auto declared =
+      *cudaq::matrix_handler::instantiate("custom_op_declared", {0}).begin();
+  auto descriptions = declared.get_parameter_descriptions();
+  ASSERT_TRUE(descriptions.has_value());
+  EXPECT_EQ(descriptions->at("scale"), "The scale of the identity.");
+  auto undeclared =
+      *cudaq::matrix_handler::instantiate("custom_op_undeclared", {0}).begin();
+  EXPECT_FALSE(undeclared.get_parameter_descriptions().has_value());
+}
@@ -592,4 +592,38 @@ TEST(OperatorExpressions, checkSpinOpsDegreeVerification) {
   ASSERT_ANY_THROW((op1 * op2).to_matrix({{0, 3}, {1, 3}}));
   ASSERT_ANY_THROW((op1 + op2).to_matrix({{0, 3}}));
   ASSERT_NO_THROW(op1.to_matrix({{0, 3}}));
-}
\ No newline at end of file
+}
+
+TEST(OperatorExpressions, checkSpinOpsTermAggregation) {
+  // Terms are aggregated regardless of the order in which they are added.
+  auto xy = cudaq::spin_op::x(3) * cudaq::spin_op::y(70);
+  auto yx = cudaq::spin_op::y(70) * cudaq::spin_op::x(3);
+  auto zz = cudaq::spin_op::z(0) * cudaq::spin_op::z(64);
+  auto sum = 2. * xy + zz + 3. * yx - zz;
+  EXPECT_EQ(sum.num_terms(), 2);
+  for (const auto &term : sum) {
+    if (term.get_term_id() == xy.get_term_id())
+      EXPECT_EQ(term.evaluate_coefficient(), std::complex<double>(5., 0.));
+    else
+      EXPECT_EQ(term.evaluate_coefficient(), std::complex<double>(0., 0.));
+  }
+  EXPECT_EQ(sum, 5. * yx + 0. * zz);
+  EXPECT_NE(sum, 5. * yx + 0. * cudaq::spin_op::z(0));
+
+  // Explicit identities are part of the term until it is canonicalized.
+  auto iz = cudaq::spin_op::i(0) * cudaq::spin_op::z(1);
+  auto withIdentity = iz + cudaq::spin_op::z(1);
+  EXPECT_EQ(withIdentity.num_terms(), 2);
+  EXPECT_EQ(withIdentity.canonicalize().num_terms(), 1);
+
+  // Large sums keep one entry per distinct term.
+  std::size_t nQubits = 12, nTerms = 2000;
+  auto random = cudaq::spin_op::random(nQubits, nTerms, 13);
+  auto doubled = random + random;
+  EXPECT_EQ(doubled.num_terms(), random.num_terms());
+  EXPECT_EQ(doubled, 2. * random);
+  std::size_t nDistributed = 0;
+  for (const auto &chunk : doubled.distribute_terms(7))
+    nDistributed += chunk.num_terms();
+  EXPECT_EQ(nDistributed, random.num_terms());
+}